@@ -4,16 +4,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/asm.h"
 #include "mcc/asm_print.h"
 #include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "mcc/parser.h"
 #include "mcc/semantic_checks.h"
+#include "mcc/stack_size.h"
+#include "mcc/stats.h"
 #include "mcc/symbol_table.h"
 
 #include "mc_cl_parser.inc"
 #include "mc_get_ast.inc"
+#include "mc_time_report.inc"
 
 // register datastructures with register_cleanup and they will be deleted on exit
 #include "mc_cleanup.inc"
@@ -40,6 +47,18 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
+	if (command_line->options->time_report)
+		mc_time_report_enable();
+	mc_time_report_phase("parsing");
+
+	// Interned identifiers are shared by all data structures and therefore released last
+	atexit(mcc_intern_release);
+
+	// AST and symbol table are allocated in an arena, which is released as a whole on exit
+	struct mcc_arena *arena = mcc_arena_new();
+	register_cleanup(arena);
+	mcc_arena_set_current(arena);
+
 	// Declare struct that will hold the result of the parser and corresponding pointer
 	struct mcc_parser_result result;
 
@@ -67,6 +86,8 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Create Symbol Table
 
+	mc_time_report_phase("symbol table");
+
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
 	if (!table) {
 		fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
@@ -76,6 +97,8 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Run semantic checks
 
+	mc_time_report_phase("semantic checks");
+
 	struct mcc_semantic_check *semantic_check = mcc_semantic_check_run_all((&result)->program, table);
 	if (!semantic_check) {
 		fprintf(stderr, "Process of semantic checks failed. Unknwon error.\n");
@@ -90,24 +113,83 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate IR
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
+	mc_time_report_phase("IR generation");
+
+	struct mcc_ir_packed *ir = mcc_ir_generate((&result)->program);
 	if (!ir) {
 		fprintf(stderr, "IR generation failed. Unknwon error.\n");
 		return EXIT_FAILURE;
 	}
 	register_cleanup(ir);
 
+	// The backend works on linked rows
+	struct mcc_ir_row *rows = mcc_ir_packed_to_rows(ir);
+	if (!rows) {
+		fprintf(stderr, "IR generation failed. Unknwon error.\n");
+		return EXIT_FAILURE;
+	}
+	register_cleanup(rows);
+
+	// ---------------------------------------------------------------------- Compute stack layout
+
+	mc_time_report_phase("stack layout");
+
+	// The stack layout is kept for the statistics
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(rows);
+	if (!an_ir) {
+		fprintf(stderr, "Computing the stack layout failed. Unknown error.\n");
+		return EXIT_FAILURE;
+	}
+	register_cleanup(an_ir);
+
 	// ---------------------------------------------------------------------- Generate ASM
 
-	struct mcc_asm *code = mcc_asm_generate(ir);
+	mc_time_report_phase("asm generation");
+
+	struct mcc_asm *code = mcc_asm_generate_annotated(an_ir);
 	if (!code) {
 		fprintf(stderr, "Assembly code generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
 	register_cleanup(code);
 
+	// ---------------------------------------------------------------------- Print statistics
+
+	if (command_line->options->print_stats) {
+		// Only the statistics need the CFG, which takes over linked rows of its own
+		mc_time_report_phase("CFG generation");
+		struct mcc_ir_row *cfg_rows = mcc_ir_packed_to_rows(ir);
+		struct mcc_basic_block *cfg = cfg_rows ? mcc_cfg_generate(cfg_rows) : NULL;
+		if (!cfg) {
+			mcc_ir_delete_ir(cfg_rows);
+			fprintf(stderr, "CFG generation failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+		register_cleanup(cfg);
+
+		mc_time_report_phase("statistics");
+		struct mcc_stats *stats = mcc_stats_collect((&result)->program, ir, cfg, an_ir, code);
+		if (!stats) {
+			fprintf(stderr, "Collecting statistics failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+		char *stats_file = command_line->options->stats_file;
+		FILE *out = stats_file ? fopen(stats_file, "w") : stderr;
+		if (!out) {
+			perror(stats_file);
+			mcc_stats_delete(stats);
+			return EXIT_FAILURE;
+		}
+		mcc_stats_print_json(out, stats);
+		mcc_stats_delete(stats);
+		if (out != stderr)
+			fclose(out);
+	}
+
 	// ---------------------------------------------------------------------- Print ASM
 
+	mc_time_report_phase("asm printing");
+
 	// Print to file or stdout
 	if (command_line->options->write_to_file == true) {
 		FILE *out = fopen(command_line->options->output_file, "w");
@@ -120,6 +202,7 @@ int main(int argc, char *argv[])
 		mcc_asm_print_asm(stdout, code);
 	}
 
+	mc_time_report_end();
 	return EXIT_SUCCESS;
 }
 
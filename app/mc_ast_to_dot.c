@@ -3,8 +3,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
 #include "mcc/ast_print.h"
+#include "mcc/intern.h"
 #include "mcc/parser.h"
 
 #include "mc_cl_parser.inc"
@@ -36,6 +38,14 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
+	// Interned identifiers are shared by all data structures and therefore released last
+	atexit(mcc_intern_release);
+
+	// AST and symbol table are allocated in an arena, which is released as a whole on exit
+	struct mcc_arena *arena = mcc_arena_new();
+	register_cleanup(arena);
+	mcc_arena_set_current(arena);
+
 	// Declare struct that will hold the result of the parser and corresponding pointer
 	struct mcc_parser_result result;
 
@@ -3,12 +3,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
 #include "mcc/cfg.h"
 #include "mcc/cfg_print.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "mcc/parser.h"
 #include "mcc/semantic_checks.h"
+#include "mcc/stats.h"
 #include "mcc/symbol_table.h"
 
 #include "mc_cl_parser.inc"
@@ -40,6 +44,14 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
+	// Interned identifiers are shared by all data structures and therefore released last
+	atexit(mcc_intern_release);
+
+	// AST and symbol table are allocated in an arena, which is released as a whole on exit
+	struct mcc_arena *arena = mcc_arena_new();
+	register_cleanup(arena);
+	mcc_arena_set_current(arena);
+
 	// Declare struct that will hold the result of the parser and corresponding pointer
 	struct mcc_parser_result result;
 
@@ -90,7 +102,15 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate IR
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&result)->program);
+	if (!packed) {
+		fprintf(stderr, "IR generation failed. Unknwon error.\n");
+		return EXIT_FAILURE;
+	}
+	register_cleanup(packed);
+
+	// The CFG is built from and takes over linked rows
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
 	if (!ir) {
 		fprintf(stderr, "IR generation failed. Unknwon error.\n");
 		return EXIT_FAILURE;
@@ -104,6 +124,33 @@ int main(int argc, char *argv[])
 		fprintf(stderr, "CFG generation failed. Unknown error.\n");
 		return EXIT_FAILURE;
 	}
+
+	// ---------------------------------------------------------------------- Print statistics
+
+	// Collected before the CFG is limited to one function, the statistics cover the whole program
+	if (command_line->options->print_stats) {
+		struct mcc_stats *stats = mcc_stats_collect((&result)->program, packed, cfg, NULL, NULL);
+		if (!stats) {
+			mcc_delete_cfg_and_ir(cfg);
+			fprintf(stderr, "Collecting statistics failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+		char *stats_file = command_line->options->stats_file;
+		FILE *out = stats_file ? fopen(stats_file, "w") : stderr;
+		if (!out) {
+			perror(stats_file);
+			mcc_stats_delete(stats);
+			mcc_delete_cfg_and_ir(cfg);
+			return EXIT_FAILURE;
+		}
+		mcc_stats_print_json(out, stats);
+		mcc_stats_delete(stats);
+		if (out != stderr)
+			fclose(out);
+	}
+
+	// ---------------------------------------------------------------------- Limit CFG
+
 	if (command_line->options->limited_scope) {
 		cfg = mcc_cfg_limit_to_function(command_line->options->function, cfg);
 		if (!cfg) {
@@ -3,15 +3,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
+#include "mcc/intern.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "mcc/ir_print.h"
 #include "mcc/parser.h"
 #include "mcc/semantic_checks.h"
+#include "mcc/stats.h"
 #include "mcc/symbol_table.h"
 
 #include "mc_cl_parser.inc"
 #include "mc_get_ast.inc"
+#include "mc_time_report.inc"
 
 // register datastructures with register_cleanup and they will be deleted on exit
 #include "mc_cleanup.inc"
@@ -39,6 +44,18 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Parsing provided input and create AST
 
+	if (command_line->options->time_report)
+		mc_time_report_enable();
+	mc_time_report_phase("parsing");
+
+	// Interned identifiers are shared by all data structures and therefore released last
+	atexit(mcc_intern_release);
+
+	// AST and symbol table are allocated in an arena, which is released as a whole on exit
+	struct mcc_arena *arena = mcc_arena_new();
+	register_cleanup(arena);
+	mcc_arena_set_current(arena);
+
 	// Declare struct that will hold the result of the parser and corresponding pointer
 	struct mcc_parser_result result;
 
@@ -66,6 +83,8 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Create Symbol Table
 
+	mc_time_report_phase("symbol table");
+
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&result)->program);
 	if (!table) {
 		fprintf(stderr, "Symbol table generation failed. Unknown error.\n");
@@ -75,6 +94,8 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Run semantic checks
 
+	mc_time_report_phase("semantic checks");
+
 	struct mcc_semantic_check *semantic_check = mcc_semantic_check_run_all((&result)->program, table);
 	if (!semantic_check) {
 		fprintf(stderr, "Process of semantic checks failed. Unknwon error.\n");
@@ -89,15 +110,41 @@ int main(int argc, char *argv[])
 
 	// ---------------------------------------------------------------------- Generate IR
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&result)->program);
+	mc_time_report_phase("IR generation");
+
+	struct mcc_ir_packed *ir = mcc_ir_generate((&result)->program);
 	if (!ir) {
 		fprintf(stderr, "IR generation failed. Unknwon error.\n");
 		return EXIT_FAILURE;
 	}
 	register_cleanup(ir);
 
+	// ---------------------------------------------------------------------- Print statistics
+
+	if (command_line->options->print_stats) {
+		mc_time_report_phase("statistics");
+		struct mcc_stats *stats = mcc_stats_collect((&result)->program, ir, NULL, NULL, NULL);
+		if (!stats) {
+			fprintf(stderr, "Collecting statistics failed. Unknown error.\n");
+			return EXIT_FAILURE;
+		}
+		char *stats_file = command_line->options->stats_file;
+		FILE *out = stats_file ? fopen(stats_file, "w") : stderr;
+		if (!out) {
+			perror(stats_file);
+			mcc_stats_delete(stats);
+			return EXIT_FAILURE;
+		}
+		mcc_stats_print_json(out, stats);
+		mcc_stats_delete(stats);
+		if (out != stderr)
+			fclose(out);
+	}
+
 	// ---------------------------------------------------------------------- Print IR
 
+	mc_time_report_phase("IR printing");
+
 	// Print to file or stdout
 	if (command_line->options->write_to_file == true) {
 		FILE *out = fopen(command_line->options->output_file, "w");
@@ -105,13 +152,14 @@ int main(int argc, char *argv[])
 			return EXIT_FAILURE;
 		}
 		// Print IR, don't escape quotes, don't double escape
-		mcc_ir_print_ir(out, ir, false, false);
+		mcc_ir_print_packed(out, ir, false, false);
 		fclose(out);
 	} else {
 		// Print IR, don't escape quotes, don't double escape
-		mcc_ir_print_ir(stdout, ir, false, false);
+		mcc_ir_print_packed(stdout, ir, false, false);
 	}
 
+	mc_time_report_end();
 	return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,104 @@
+// Allocation Accounting
+//
+// The library allocates all memory through the functions below, which forward to malloc, calloc, realloc and free.
+// Once enabled, every allocation is counted for the kind of data structure it holds and for the phase of the compiler
+// the allocating thread is in. Failing allocations are passed on unchanged, hence fault injection by preloading a
+// failing malloc keeps working.
+//
+// Memory is freed with mcc_free and the kind it was allocated with. While counting, the last usable byte of each block
+// records the phase that allocated it, which is where freeing it is counted. Blocks start where malloc placed them,
+// hence memory the library hands over, like the error buffer of the parser, may as well be released with free. It then
+// stays counted as live. Objects placed into an arena are counted as live bytes of their kind until the arena is
+// deleted, only the rest of its chunks is counted for the arena.
+
+#ifndef MCC_ALLOC_H
+#define MCC_ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+enum mcc_alloc_kind {
+	MCC_ALLOC_OTHER,
+	MCC_ALLOC_AST_NODE,
+	MCC_ALLOC_SYMBOL_TABLE,
+	MCC_ALLOC_STRING,
+	MCC_ALLOC_IR_ROW,
+	MCC_ALLOC_IR_ARG,
+	MCC_ALLOC_CFG,
+	MCC_ALLOC_ANNOTATED_IR,
+	MCC_ALLOC_ASM,
+	MCC_ALLOC_ASM_LINE,
+	MCC_ALLOC_ASM_OPERAND,
+	MCC_ALLOC_HASH_MAP,
+	MCC_ALLOC_ARENA,
+	MCC_ALLOC_KIND_COUNT,
+};
+
+// Set by the entry point of each stage. Tasks of the thread pool run in the phase of the thread that submitted them.
+enum mcc_alloc_phase {
+	MCC_ALLOC_PHASE_OTHER,
+	MCC_ALLOC_PHASE_PARSER,
+	MCC_ALLOC_PHASE_SYMBOL_TABLE,
+	MCC_ALLOC_PHASE_SEMANTIC_CHECKS,
+	MCC_ALLOC_PHASE_IR,
+	MCC_ALLOC_PHASE_CFG,
+	MCC_ALLOC_PHASE_STACK_LAYOUT,
+	MCC_ALLOC_PHASE_ASM,
+	MCC_ALLOC_PHASE_COUNT,
+};
+
+struct mcc_alloc_counters {
+	// Number of allocations, and the bytes requested by them
+	long calls;
+	long bytes;
+	// Bytes allocated and not freed yet. For a phase, the bytes allocated during it that are still live.
+	long live;
+	// High-water mark of live. For a phase, the highest growth of the total of live bytes over its level when the
+	// phase was entered.
+	long peak;
+};
+
+void *mcc_malloc(enum mcc_alloc_kind kind, size_t size);
+
+void *mcc_calloc(enum mcc_alloc_kind kind, size_t count, size_t size);
+
+void *mcc_realloc(enum mcc_alloc_kind kind, void *ptr, size_t size);
+
+char *mcc_strdup(enum mcc_alloc_kind kind, const char *string);
+
+void mcc_free(enum mcc_alloc_kind kind, void *ptr);
+
+// Count an object of the given size that was placed into an arena. Returns false if it was not counted, then it must
+// not be passed to mcc_alloc_count_out_of_arena either.
+bool mcc_alloc_count_in_arena(enum mcc_alloc_kind kind, size_t size);
+
+// Count an object as released together with its arena
+void mcc_alloc_count_out_of_arena(enum mcc_alloc_kind kind, size_t size);
+
+// Start counting. Returns false if the library already allocated memory, then nothing is counted.
+bool mcc_alloc_enable_stats(void);
+
+// Set phase of the calling thread and return the previous one
+enum mcc_alloc_phase mcc_alloc_set_phase(enum mcc_alloc_phase phase);
+
+enum mcc_alloc_phase mcc_alloc_get_phase(void);
+
+struct mcc_alloc_counters mcc_alloc_kind_counters(enum mcc_alloc_kind kind);
+
+struct mcc_alloc_counters mcc_alloc_phase_counters(enum mcc_alloc_phase phase);
+
+// Counters of all kinds together
+struct mcc_alloc_counters mcc_alloc_total_counters(void);
+
+// High-water mark of the total of live bytes since the previous call, the next interval starts at the current total
+long mcc_alloc_interval_peak(void);
+
+const char *mcc_alloc_kind_name(enum mcc_alloc_kind kind);
+
+const char *mcc_alloc_phase_name(enum mcc_alloc_phase phase);
+
+// Print counters per phase and per kind as tables
+void mcc_alloc_print_stats(FILE *out);
+
+#endif // MCC_ALLOC_H
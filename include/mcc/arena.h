@@ -0,0 +1,48 @@
+// Arena Allocator
+//
+// Region based allocator for data structures that share the lifetime of a compilation unit, i.e. the AST and the
+// symbol table. Memory is bump-allocated from large chunks and released all at once with mcc_arena_delete.
+//
+// Each thread can select a current arena. While it is set, AST nodes, symbol table entries and string literals
+// created by that thread are placed into it. Those are skipped by the mcc_ast_delete_* and mcc_symbol_table_delete_*
+// functions and only released together with the arena. Without a current arena everything is allocated on the heap.
+
+#ifndef MCC_ARENA_H
+#define MCC_ARENA_H
+
+#include <stddef.h>
+
+#include "mcc/alloc.h"
+
+struct mcc_arena;
+
+struct mcc_arena *mcc_arena_new(void);
+
+// Release all memory allocated in the arena
+void mcc_arena_delete(struct mcc_arena *arena);
+
+void *mcc_arena_alloc(struct mcc_arena *arena, size_t size);
+
+// Release child together with arena instead of on its own. Lets arenas filled by other threads share the lifetime of
+// the arena they are merged into.
+void mcc_arena_adopt(struct mcc_arena *arena, struct mcc_arena *child);
+
+char *mcc_arena_alloc_string(struct mcc_arena *arena, const char *string);
+
+// Set current arena of the calling thread, NULL to allocate on the heap
+void mcc_arena_set_current(struct mcc_arena *arena);
+
+struct mcc_arena *mcc_arena_get_current(void);
+
+// Allocate in the current arena, or with mcc_malloc if there is none. Counted for kind either way, in an arena until it
+// is deleted.
+void *mcc_arena_malloc(enum mcc_alloc_kind kind, size_t size);
+
+// Duplicate string into the current arena, or with strdup if there is none
+char *mcc_arena_strdup(enum mcc_alloc_kind kind, const char *string);
+
+// Free memory obtained by mcc_arena_malloc or mcc_arena_strdup with the same kind. Pass the arena that was current
+// when it was allocated, which objects record like node.arena does. Memory in an arena is only released with it.
+void mcc_arena_free(struct mcc_arena *arena, enum mcc_alloc_kind kind, void *ptr);
+
+#endif // MCC_ARENA_H
@@ -11,11 +11,16 @@
 #include "mcc/ir.h"
 #include "mcc/stack_size.h"
 
+struct mcc_asm_operand_table;
+struct mcc_hash_map;
+
 // Used for the generation process
 struct mcc_asm_data {
 	bool has_failed;
 	struct mcc_asm_data_section *data_section;
 	struct mcc_asm_line *current;
+	// Stack offsets of the operands of the function that is currently generated
+	struct mcc_asm_operand_table *operands;
 };
 
 //---------------------------------------------------------------------------------------- Data structure: ASM
@@ -29,8 +34,13 @@ struct mcc_asm_text_section {
 	struct mcc_asm_function *function;
 };
 
+// Literal pool: every distinct string and every bit-distinct float is declared once
 struct mcc_asm_data_section {
 	struct mcc_asm_declaration *head;
+	// string value -> declaration
+	struct mcc_hash_map *strings;
+	// bit pattern of float value -> declaration
+	struct mcc_hash_map *floats;
 };
 
 enum mcc_asm_declaration_type {
@@ -233,5 +243,8 @@ void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
 
 struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir);
 
+// Same as mcc_asm_generate for an IR that was already annotated with mcc_annotate_ir. an_ir stays with the caller.
+struct mcc_asm *mcc_asm_generate_annotated(struct mcc_annotated_ir *an_ir);
+
 #endif // MCC_ASM_H
 
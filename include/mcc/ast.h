@@ -25,8 +25,12 @@ struct mcc_ast_source_location {
 	char *filename;
 };
 
+struct mcc_arena;
+
 struct mcc_ast_node {
 	struct mcc_ast_source_location sloc;
+	// Arena holding the node, NULL if it was allocated on the heap
+	struct mcc_arena *arena;
 };
 
 // ------------------------------------------------------------------ Operators
@@ -53,6 +57,23 @@ enum mcc_ast_unary_op {
 
 // ---------------------------------------------------------------- Expressions
 
+enum mcc_ast_types {
+	INT,
+	FLOAT,
+	BOOL,
+	STRING,
+	VOID,
+};
+
+// Data type of an expression, set by the semantic checks
+struct mcc_ast_data_type {
+	enum mcc_ast_types type;
+	// -1 if not array
+	int array_size;
+	// False until the expression has been checked without error
+	bool is_known;
+};
+
 enum mcc_ast_expression_type {
 	MCC_AST_EXPRESSION_TYPE_LITERAL,
 	MCC_AST_EXPRESSION_TYPE_BINARY_OP,
@@ -67,6 +88,7 @@ struct mcc_ast_expression {
 	struct mcc_ast_node node;
 
 	enum mcc_ast_expression_type type;
+	struct mcc_ast_data_type data_type;
 	union {
 		// MCC_AST_EXPRESSION_TYPE_LITERAL
 		struct mcc_ast_literal *literal;
@@ -132,14 +154,6 @@ void mcc_ast_delete_expression(struct mcc_ast_expression *expression);
 
 // ------------------------------------------------------------------- Types
 
-enum mcc_ast_types {
-	INT,
-	FLOAT,
-	BOOL,
-	STRING,
-	VOID,
-};
-
 struct mcc_ast_type {
 
 	struct mcc_ast_node node;
@@ -231,9 +245,11 @@ void mcc_ast_delete_array_assignment(struct mcc_ast_assignment *assignment);
 struct mcc_ast_identifier {
 
 	struct mcc_ast_node node;
+	// interned, equal names are the same pointer
 	char *identifier_name;
 };
 
+// identifier has to be interned, see mcc/intern.h
 struct mcc_ast_identifier *mcc_ast_new_identifier(char *identifier);
 
 void mcc_ast_delete_identifier(struct mcc_ast_identifier *identifier);
@@ -438,12 +454,6 @@ mcc_ast_new_arguments(bool is_empty, struct mcc_ast_expression *expression, stru
 
 void mcc_ast_delete_arguments(struct mcc_ast_arguments *arguments);
 
-// ------------------------------------------------------------------- Add built_ins
-
-bool mcc_ast_add_built_ins(struct mcc_ast_program *program);
-
-struct mcc_ast_program *mcc_ast_remove_built_ins(struct mcc_ast_program *program);
-
 // ------------------------------------------------------------------- Transforming the complete AST
 
 // Remove everything but one function from the AST
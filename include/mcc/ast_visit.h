@@ -4,6 +4,9 @@
 //
 // Instantiate the `mcc_ast_visitor` struct with the desired configuration and callbacks.
 // Use this instance with the functions declared below. Each callback is optional, just set it to NULL.
+//
+// The traversal keeps its state on the heap, so arbitrarily long statement lists and programs are visited in bounded
+// native stack. If that state cannot be allocated, the traversal stops early and sets `has_failed`.
 
 #ifndef MCC_AST_VISIT_H
 #define MCC_AST_VISIT_H
@@ -36,6 +39,9 @@ struct mcc_ast_visitor {
 	// node. Use it to share data while traversing the tree.
 	void *userdata;
 
+	// Set by the traversal if it stopped because an allocation failed
+	bool has_failed;
+
 	mcc_ast_visit_expression_cb expression;
 	mcc_ast_visit_expression_cb expression_literal;
 	mcc_ast_visit_expression_cb expression_binary_op;
@@ -5,6 +5,8 @@
 // of the graph.
 // In order to make traversing easier, each node also contains a pointer to the next basic block, inferred from the
 // order they appear in the IR. This essentially enables traversing the CFG as if it was a linked list.
+// Blocks are numbered densely in that order and know their successors and predecessors, so dataflow analyses can keep
+// their per-block state in arrays indexed by block ID.
 
 #ifndef MCC_CFG_H
 #define MCC_CFG_H
@@ -15,9 +17,19 @@
 
 struct mcc_basic_block {
 	struct mcc_ir_row *leader;
+	// Fall through successor of a conditional jump
 	struct mcc_basic_block *child_left;
+	// Jump target or following block
 	struct mcc_basic_block *child_right;
 	struct mcc_basic_block *next;
+
+	// Position in the chain of next pointers, starting at 0
+	unsigned id;
+	// Non-NULL children, fall through first
+	unsigned num_successors;
+	struct mcc_basic_block *successors[2];
+	unsigned num_predecessors;
+	struct mcc_basic_block **predecessors;
 };
 
 //---------------------------------------------------------------------------------------- Functions: CFG
@@ -25,7 +37,7 @@ struct mcc_basic_block {
 // Gives the cfg as directed tree
 struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_row *ir);
 
-// Restrict the CFG to just one function
+// Restrict the CFG to just one function. Block IDs are renumbered to start at 0.
 struct mcc_basic_block *mcc_cfg_limit_to_function(char *function_identifier, struct mcc_basic_block *cfg_first);
 
 //---------------------------------------------------------------------------------------- Functions: Set up datastructs
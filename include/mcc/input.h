@@ -0,0 +1,31 @@
+// Input
+//
+// Source text that is handed to the scanner without copying it. Regular files are mapped into memory, other streams
+// are read into a buffer that grows geometrically. The scanner works on the buffer in place, so the buffer is
+// writable (mappings are private) and followed by two NUL bytes. Tokens point into the buffer while it is scanned.
+
+#ifndef MCC_INPUT_H
+#define MCC_INPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+struct mcc_input {
+	char *buffer;
+	// length of the source text, excluding the terminating NUL bytes
+	size_t size;
+	// length of the mapping or the allocation
+	size_t capacity;
+	bool is_mapped;
+};
+
+// Returns NULL if the file cannot be opened or read
+struct mcc_input *mcc_input_from_file(const char *filename);
+
+// Reads the stream until EOF, returns NULL on read errors
+struct mcc_input *mcc_input_from_stream(FILE *stream);
+
+void mcc_input_delete(struct mcc_input *input);
+
+#endif // MCC_INPUT_H
@@ -0,0 +1,20 @@
+// Identifier Interning
+//
+// Global table that stores every distinct identifier exactly once. The scanner interns all identifiers, hence AST
+// identifiers and symbol table rows referring to the same name share one string and can be compared by pointer.
+// Interned strings are owned by the table, they must neither be modified nor freed and stay valid until
+// mcc_intern_release is called. Interning and lookups may happen concurrently, releasing may not.
+
+#ifndef MCC_INTERN_H
+#define MCC_INTERN_H
+
+// Returns the interned copy of string, inserting it if needed. NULL if an allocation failed.
+char *mcc_intern(const char *string);
+
+// Returns the interned copy of string, or NULL if it was never interned
+char *mcc_intern_find(const char *string);
+
+// Release all interned strings
+void mcc_intern_release(void);
+
+#endif // MCC_INTERN_H
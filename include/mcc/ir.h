@@ -23,9 +23,9 @@ struct ir_generation_userdata {
 	struct mcc_ir_row *current;
 	// Flag for indicating errors
 	bool has_failed;
-	// Counts number of (non-function) labels
+	// Counts number of (non-function) labels, numbered per function and shifted by mcc_ir_generate
 	unsigned label_counter;
-	// Counts float temporaries
+	// Counts temporaries, numbered like labels
 	unsigned tmp_counter;
 };
 
@@ -73,6 +73,8 @@ enum mcc_ir_arg_type {
 
 struct mcc_ir_arg {
 	enum mcc_ir_arg_type type;
+	// Identifiers and array elements: dense ID of the name within its function, see mcc_ir_generate
+	unsigned symbol;
 
 	union {
 		long lit_int;
@@ -81,12 +83,23 @@ struct mcc_ir_arg {
 		char *lit_string;
 		struct mcc_ir_row *row;
 		unsigned label;
-		char *ident;
+		struct {
+			// NULL for temporaries
+			char *ident;
+			// Temporary introduced by the IR generation rather than a variable of the program
+			bool is_tmp;
+			// Number of the temporary, printed as $tmpN
+			unsigned tmp;
+		};
 		struct {
 			char *arr_ident;
 			struct mcc_ir_arg *index;
 		};
-		char *func_label;
+		struct {
+			char *func_label;
+			// Number of symbol IDs used in the function
+			unsigned num_symbols;
+		};
 	};
 };
 
@@ -158,7 +171,14 @@ struct mcc_ir_arg *mcc_ir_generate_expression(struct mcc_ast_expression *express
 
 //---------------------------------------------------------------------------------------- Generate IR
 
-struct mcc_ir_row *mcc_ir_generate(struct mcc_ast_program *ast);
+struct mcc_ir_packed;
+
+// Generates the functions in parallel, straight into the packed form of mcc/ir_packed.h. Passes working on linked rows
+// obtain them with mcc_ir_packed_to_rows. Returns NULL if generation failed.
+//
+// Named operands are numbered per function, so later passes can keep per-variable data in plain arrays indexed by
+// symbol ID instead of looking names up
+struct mcc_ir_packed *mcc_ir_generate(struct mcc_ast_program *ast);
 
 //---------------------------------------------------------------------------------------- Cleanup
 
@@ -0,0 +1,108 @@
+// Packed Intermediate Representation
+//
+// Compact form of the IR, as produced by mcc_ir_generate. The rows of each function are stored contiguously with
+// their operands inline, row references are 32-bit indices into the rows of the same function and row types are
+// interned into one table per function. Names and string literals are interned (see mcc/intern.h), so the packed IR
+// owns no strings.
+//
+// Functions are generated independently, so labels, temporaries and row numbers are counted per function. The
+// offsets of a function shift them behind the ones of all previous functions, which numbers them across the program.
+//
+// Consumers that only read the IR, like mcc_ir_print_packed and the statistics, walk the packed form directly. Passes
+// that still work on the linked rows of mcc/ir.h obtain them with mcc_ir_packed_to_rows.
+
+#ifndef MCC_IR_PACKED_H
+#define MCC_IR_PACKED_H
+
+#include <stdint.h>
+
+#include "mcc/ir.h"
+
+//---------------------------------------------------------------------------------------- Data structure
+
+// Marks an operand the row does not have
+#define MCC_IR_PACKED_NO_ARG UINT8_MAX
+
+struct mcc_ir_packed_arg {
+	// enum mcc_ir_arg_type or MCC_IR_PACKED_NO_ARG
+	uint8_t type;
+	// MCC_IR_TYPE_IDENTIFIER: temporary of the IR generation
+	bool is_tmp;
+
+	// MCC_IR_TYPE_IDENTIFIER and MCC_IR_TYPE_ARR_ELEM: symbol ID within the function
+	uint32_t symbol;
+
+	// MCC_IR_TYPE_ROW: index of the row in its function
+	// MCC_IR_TYPE_LABEL: label number within the function
+	// MCC_IR_TYPE_IDENTIFIER: number of a temporary within the function
+	// MCC_IR_TYPE_ARR_ELEM: index of the element index in the indices of the function
+	uint32_t ref;
+
+	union {
+		long lit_int;
+		double lit_float;
+		bool lit_bool;
+		// Interned literal, identifier (NULL for temporaries), array identifier or function label
+		const char *name;
+	};
+};
+
+struct mcc_ir_packed_row {
+	uint8_t instr;
+	// Index into the type table of the function
+	uint32_t type;
+	// Row number within the function
+	unsigned row_no;
+
+	struct mcc_ir_packed_arg arg1;
+	struct mcc_ir_packed_arg arg2;
+};
+
+struct mcc_ir_packed_function {
+	// Interned name
+	const char *name;
+	unsigned num_symbols;
+
+	unsigned label_offset;
+	unsigned tmp_offset;
+	unsigned row_no_offset;
+
+	uint32_t num_rows;
+	struct mcc_ir_packed_row *rows;
+
+	// Element indices of array operands
+	uint32_t num_indices;
+	struct mcc_ir_packed_arg *indices;
+
+	uint32_t num_types;
+	struct mcc_ir_row_type *types;
+};
+
+struct mcc_ir_packed {
+	// In source order
+	uint32_t num_functions;
+	struct mcc_ir_packed_function *functions;
+};
+
+//---------------------------------------------------------------------------------------- Conversion
+
+// Pack the linked rows of one function into function, for mcc_ir_generate which sets the offsets. The linked rows are
+// only good for deletion afterwards. Returns false if an allocation failed, function then owns no memory.
+bool mcc_ir_pack_function(struct mcc_ir_row *head, struct mcc_ir_packed_function *function);
+
+// Compatibility view: linked rows equal to the packed ones, to be deleted with mcc_ir_delete_ir. NULL if an allocation
+// failed or the IR is empty.
+struct mcc_ir_row *mcc_ir_packed_to_rows(struct mcc_ir_packed *packed);
+
+//---------------------------------------------------------------------------------------- Access
+
+struct mcc_ir_row_type *mcc_ir_packed_row_type(struct mcc_ir_packed_function *function, struct mcc_ir_packed_row *row);
+
+// Bytes allocated for the packed IR
+size_t mcc_ir_packed_size(struct mcc_ir_packed *packed);
+
+//---------------------------------------------------------------------------------------- Cleanup
+
+void mcc_ir_packed_delete(struct mcc_ir_packed *packed);
+
+#endif // MCC_IR_PACKED_H
@@ -12,6 +12,7 @@
 #include <stdbool.h>
 
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 
 void mcc_ir_print_table_begin(FILE *out);
 
@@ -19,6 +20,9 @@ void mcc_ir_print_table_end(FILE *out);
 
 void mcc_ir_print_ir(FILE *out, struct mcc_ir_row *head, bool escape_quotes, bool doubly_escaped);
 
+// Same output as mcc_ir_print_ir on the compatibility view of the packed IR, see mcc_ir_packed_to_rows
+void mcc_ir_print_packed(FILE *out, struct mcc_ir_packed *packed, bool escape_quotes, bool doubly_escaped);
+
 void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes, bool doubly_escaped);
 
 #endif
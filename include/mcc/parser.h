@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include "mcc/ast.h"
+#include "mcc/input.h"
 
 enum mcc_parser_status {
 	MCC_PARSER_STATUS_OK,
@@ -59,6 +60,9 @@ struct mcc_parser_result mcc_parse_string(const char *input, enum mcc_parser_ent
 
 struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point entry_point, char *name);
 
+// Scans the buffer of the input in place, the input has to stay alive while parsing
+struct mcc_parser_result mcc_parse_input(struct mcc_input *input, enum mcc_parser_entry_point entry_point, char *name);
+
 void mcc_ast_delete_result(struct mcc_parser_result *result);
 
 #endif // MCC_PARSER_H
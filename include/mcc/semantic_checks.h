@@ -2,6 +2,10 @@
 //
 // This module defines infrastructure for the semantic checks.
 // Semantic checks can be run individually or composed in a single function.
+//
+// All checks share a single traversal of the AST, a check that is run individually only reports its own error. The
+// functions are checked concurrently, the reported error is the same as in a sequential run. The checks store the data
+// type of every expression in the AST (see `mcc_ast_data_type`), which the IR generation uses.
 
 #ifndef PROJECT_SEMANTIC_CHECKS_H
 #define PROJECT_SEMANTIC_CHECKS_H
@@ -75,12 +79,6 @@ struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *as
 // ------------------------------------------------------------- Functions: Implementation of the individual semantic
 // checks
 
-// Struct for user data concerning the type check visitor
-struct type_checking_userdata {
-	struct mcc_semantic_check *check;
-	enum mcc_semantic_check_error_code error;
-};
-
 // No Type conversions in expressions
 enum mcc_semantic_check_error_code mcc_semantic_check_run_type_check(struct mcc_ast_program *ast,
                                                                      struct mcc_symbol_table *symbol_table,
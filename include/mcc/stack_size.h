@@ -15,11 +15,24 @@
 
 // --------------------------------------------------------------------------------------- Data structure
 
+// Frame layout of a single function, built while annotating the IR.
+// Maps every variable, temporary and array of the function to the annotated line that owns its stack slot. Both
+// tables are indexed by the symbol IDs of the IR.
+struct mcc_frame_layout {
+	unsigned num_symbols;
+	// symbol -> annotated line of its first assignment
+	struct mcc_annotated_ir **variables;
+	// symbol -> annotated line of its array declaration
+	struct mcc_annotated_ir **arrays;
+};
+
 struct mcc_annotated_ir {
 	// Hold stack size (number of bytes needed on the stack) of current IR line.
 	// If line is func label, holds stack size of that function
 	int stack_size;
 	int stack_position;
+	// Only set for func labels
+	struct mcc_frame_layout *layout;
 	struct mcc_annotated_ir *next;
 	struct mcc_annotated_ir *prev;
 	struct mcc_ir_row *row;
@@ -35,6 +48,12 @@ struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_row *ir);
 // Returns pointer to first IR line of function. Use existing mcc_annotated_ir struct with this function.
 struct mcc_annotated_ir *mcc_get_function_label(struct mcc_annotated_ir *an_ir);
 
+// Returns the annotated line of the first assignment to symbol in the function of an_ir, or NULL
+struct mcc_annotated_ir *mcc_get_variable_declaration(struct mcc_annotated_ir *an_ir, unsigned symbol);
+
+// Returns the annotated line of the array declaration of symbol in the function of an_ir, or NULL
+struct mcc_annotated_ir *mcc_get_array_declaration(struct mcc_annotated_ir *an_ir, unsigned symbol);
+
 int mcc_get_array_base_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_base);
 
 int mcc_get_array_element_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_element);
@@ -0,0 +1,76 @@
+// Compile Statistics
+//
+// Per-function metrics of a compiled program, for tracking code size and compile cost across compiler versions. The
+// stages an app already ran are passed in and only the missing ones are run, on their default settings, hence the
+// statistics are the same no matter which app collects them.
+//
+// The JSON schema, all counts are integers and every instruction and opcode is always listed:
+//
+//     {"version": 1,
+//      "functions": [{"name": "main", "ast_nodes": 12, "ir_rows": {"total": 5, "by_instruction": {"assign": 2, ...}},
+//                     "basic_blocks": 1, "frame_size": 8, "asm_lines": {"total": 9, "by_opcode": {"movl": 4, ...}}},
+//                    ...],
+//      "data_section": {"entries": 2, "strings": 1, "floats": 1}}
+
+#ifndef MCC_STATS_H
+#define MCC_STATS_H
+
+#include <stdio.h>
+
+#include "mcc/asm.h"
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/stack_size.h"
+
+#define MCC_STATS_VERSION 1
+
+#define MCC_STATS_NUM_INSTRUCTIONS (MCC_IR_INSTR_UNKNOWN + 1)
+#define MCC_STATS_NUM_OPCODES (MCC_ASM_FCHS + 1)
+
+//---------------------------------------------------------------------------------------- Data structure
+
+struct mcc_stats_function {
+	char *name;
+	unsigned ast_nodes;
+	unsigned ir_rows;
+	// Indexed by enum mcc_ir_instruction
+	unsigned ir_rows_by_instruction[MCC_STATS_NUM_INSTRUCTIONS];
+	unsigned basic_blocks;
+	// Bytes of the stack frame, as computed by mcc_annotate_ir
+	int frame_size;
+	unsigned asm_lines;
+	// Indexed by enum mcc_asm_opcode
+	unsigned asm_lines_by_opcode[MCC_STATS_NUM_OPCODES];
+};
+
+struct mcc_stats {
+	// In source order
+	unsigned num_functions;
+	struct mcc_stats_function *functions;
+	unsigned data_strings;
+	unsigned data_floats;
+};
+
+//---------------------------------------------------------------------------------------- Functions
+
+// Collect statistics of a program that passed the semantic checks and its IR. Pass the CFG of the whole program, the
+// annotated IR and the assembly built from ir if the caller has them, NULL ones are built here and deleted again.
+// Returns NULL if an allocation failed.
+struct mcc_stats *mcc_stats_collect(struct mcc_ast_program *program,
+                                    struct mcc_ir_packed *ir,
+                                    struct mcc_basic_block *cfg,
+                                    struct mcc_annotated_ir *an_ir,
+                                    struct mcc_asm *assembly);
+
+void mcc_stats_print_json(FILE *out, struct mcc_stats *stats);
+
+// Keys used for instructions and opcodes in the JSON output
+const char *mcc_stats_instruction_name(enum mcc_ir_instruction instr);
+
+const char *mcc_stats_opcode_name(enum mcc_asm_opcode opcode);
+
+void mcc_stats_delete(struct mcc_stats *stats);
+
+#endif // MCC_STATS_H
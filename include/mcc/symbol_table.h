@@ -9,6 +9,8 @@
 
 #include "mcc/ast.h"
 
+struct mcc_hash_map;
+
 // ------------------------------------------------------------ Data structure: Symbol Table row
 
 enum mcc_symbol_table_row_structure {
@@ -30,14 +32,21 @@ struct mcc_symbol_table_row {
 	enum mcc_symbol_table_row_structure row_structure;
 	enum mcc_symbol_table_row_type row_type;
 	long array_size; //-1 if no array
-	char *name;
+	char *name;      // interned, equal names are the same pointer
 
 	struct mcc_symbol_table_row *prev_row;
 	struct mcc_symbol_table_row *next_row;
 	struct mcc_symbol_table_scope *scope;
 	struct mcc_symbol_table_scope *child_scope;
+	struct mcc_symbol_table_scope *last_child_scope;
+
+	// position within the scope and previous row of the scope with the same name, NULL if there is none
+	int position;
+	struct mcc_symbol_table_row *prev_declaration;
 
 	struct mcc_ast_node *node;
+	// Arena the row was allocated in, NULL if it is on the heap
+	struct mcc_arena *arena;
 };
 
 // ------------------------------------------------------------ Functions: Symbol Table row
@@ -53,10 +62,15 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
                                                             enum mcc_symbol_table_row_type type,
                                                             struct mcc_ast_node *node);
 
+// Remove row from its scope and delete it together with its child scopes
 void mcc_symbol_table_delete_row(struct mcc_symbol_table_row *row);
 
+// Delete head and all rows after it without unlinking them, only for deleting their whole scope
 void mcc_symbol_table_delete_all_rows(struct mcc_symbol_table_row *head);
 
+// Rename row and keep the index of its scope up to date, name has to be interned
+void mcc_symbol_table_rename_row(struct mcc_symbol_table_row *row, char *name);
+
 void mcc_symbol_table_row_append_child_scope(struct mcc_symbol_table_row *row, struct mcc_symbol_table_scope *child);
 
 // ------------------------------------------------------------- Data structure: Symbol Table scope
@@ -69,9 +83,14 @@ enum mcc_symbol_table_scope_type {
 struct mcc_symbol_table_scope {
 	// 'list' of rows
 	struct mcc_symbol_table_row *head;
+	struct mcc_symbol_table_row *tail;
+	// maps interned names to the last row of the scope declaring them, NULL if rows have to be searched linearly
+	struct mcc_hash_map *index;
 	struct mcc_symbol_table_row *parent_row;
 	struct mcc_symbol_table_scope *next_scope;
 	struct mcc_symbol_table_scope *prev_scope;
+	// Arena the scope was allocated in, NULL if it is on the heap
+	struct mcc_arena *arena;
 };
 
 // ------------------------------------------------------------ Functions: Symbol Table scope
@@ -91,6 +110,8 @@ void mcc_symbol_table_delete_all_scopes(struct mcc_symbol_table_scope *head);
 struct mcc_symbol_table {
 	// list of scopes
 	struct mcc_symbol_table_scope *head;
+	// Arena holding rows and scopes, NULL if they were allocated on the heap
+	struct mcc_arena *arena;
 };
 
 struct mcc_symbol_table *mcc_symbol_table_new_table();
@@ -99,6 +120,22 @@ void mcc_symbol_table_insert_scope(struct mcc_symbol_table *table, struct mcc_sy
 
 void mcc_symbol_table_delete_table(struct mcc_symbol_table *table);
 
+// --------------------------------------------------------------- Built-in functions
+
+// Signature of a function provided by mc_builtins.c, builtins take at most one parameter
+struct mcc_symbol_table_builtin {
+	const char *name;
+	enum mcc_symbol_table_row_type return_type;
+	const char *parameter_name; // NULL if the builtin takes no parameter
+	enum mcc_symbol_table_row_type parameter_type;
+};
+
+// Returns the builtin with the given name or NULL
+const struct mcc_symbol_table_builtin *mcc_symbol_table_get_builtin(const char *name);
+
+// Builtin rows have no AST node
+bool mcc_symbol_table_row_is_builtin(const struct mcc_symbol_table_row *row);
+
 // --------------------------------------------------------------- Functions: traversing AST and create symbol table
 
 struct mcc_symbol_table_row *mcc_symbol_table_check_upwards_for_declaration(const char *name,
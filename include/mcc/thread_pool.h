@@ -0,0 +1,47 @@
+// Thread Pool
+//
+// Work-stealing pool shared by all stages of the library, used to run independent work such as the functions of a
+// program concurrently. Every thread of the pool owns a queue of tasks. It runs its own tasks newest first and, once
+// they are done, takes the oldest task of another thread. Threads outside of the pool share one queue. A thread
+// waiting for a task group runs queued tasks itself in the meantime, hence tasks may submit and wait for tasks too.
+//
+// The number of threads is set with mcc_thread_pool_set_threads, by default it is taken from the environment variable
+// MCC_THREADS, or else one thread per online CPU is used. With a single thread every task runs on the submitting
+// thread when it is submitted, which makes the order of execution deterministic for debugging.
+//
+// Threads are started on first use. If memory or threads run out, tasks run on the waiting thread instead, so
+// submitting a task cannot fail.
+
+#ifndef MCC_THREAD_POOL_H
+#define MCC_THREAD_POOL_H
+
+#define MCC_THREAD_POOL_ENV "MCC_THREADS"
+
+#define MCC_THREAD_POOL_MAX_THREADS 256
+
+typedef void (*mcc_thread_pool_task)(void *userdata);
+
+struct mcc_task_group;
+
+// Set the number of threads, including the thread waiting for tasks. 0 restores the default, values above
+// MCC_THREAD_POOL_MAX_THREADS are capped. Stops the running threads, hence no task may be pending.
+void mcc_thread_pool_set_threads(int num_threads);
+
+// Number of threads the pool runs tasks on
+int mcc_thread_pool_threads(void);
+
+// Stop all threads, for instance before exiting. The next task group starts them again.
+void mcc_thread_pool_shutdown(void);
+
+// Tasks submitted to a group are waited for together. NULL if an allocation failed.
+struct mcc_task_group *mcc_task_group_new(void);
+
+void mcc_task_group_submit(struct mcc_task_group *group, mcc_thread_pool_task task, void *userdata);
+
+// Run queued tasks until all tasks of the group are done, then delete the group
+void mcc_task_group_wait(struct mcc_task_group *group);
+
+// Calls body once for every index in [0, count) and returns after all calls are done
+void mcc_thread_pool_for(int count, void (*body)(int index, void *userdata), void *userdata);
+
+#endif // MCC_THREAD_POOL_H
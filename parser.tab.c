@@ -0,0 +1,2572 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+/* Substitute the type names.  */
+#define YYSTYPE         MCC_PARSER_STYPE
+#define YYLTYPE         MCC_PARSER_LTYPE
+/* Substitute the variable and function names.  */
+#define yyparse         mcc_parser_parse
+#define yylex           mcc_parser_lex
+#define yyerror         mcc_parser_error
+#define yydebug         mcc_parser_debug
+#define yynerrs         mcc_parser_nerrs
+
+/* First part of user prologue.  */
+#line 47 "/tmp/wt/src/parser.y"
+
+#include "mcc/alloc.h"
+
+int mcc_parser_lex();
+void mcc_parser_error();
+
+static struct mcc_ast_compound_statement *reverse_statements(struct mcc_ast_compound_statement *last);
+static struct mcc_ast_program *reverse_functions(struct mcc_ast_program *last);
+
+
+#define loc(ast_node, ast_sloc, ast_sloc_last) \
+	if (ast_node) { \
+		do_loc(ast_node,ast_sloc,ast_sloc_last); \
+	} \
+
+#define do_loc(ast_node, ast_sloc, ast_sloc_last)               \
+	(ast_node)->node.sloc.start_col = (ast_sloc).first_column;    \
+	(ast_node)->node.sloc.start_line = (ast_sloc).first_line;     \
+	(ast_node)->node.sloc.end_col = (ast_sloc_last).last_column;  \
+	(ast_node)->node.sloc.end_line = (ast_sloc_last).last_line;   \
+	(ast_node)->node.sloc.filename = result->filename;            \
+
+
+#line 102 "parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "EOF"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT_LITERAL = 3,                /* "integer literal"  */
+  YYSYMBOL_FLOAT_LITERAL = 4,              /* "float literal"  */
+  YYSYMBOL_BOOL_LITERAL = 5,               /* "bool literal"  */
+  YYSYMBOL_STRING_LITERAL = 6,             /* "string literal"  */
+  YYSYMBOL_IDENTIFIER = 7,                 /* "identifier"  */
+  YYSYMBOL_TYPE = 8,                       /* "type"  */
+  YYSYMBOL_VOID = 9,                       /* "void"  */
+  YYSYMBOL_LPARENTH = 10,                  /* "("  */
+  YYSYMBOL_RPARENTH = 11,                  /* ")"  */
+  YYSYMBOL_CURL_OPEN = 12,                 /* "{"  */
+  YYSYMBOL_CURL_CLOSE = 13,                /* "}"  */
+  YYSYMBOL_PLUS = 14,                      /* "+"  */
+  YYSYMBOL_MINUS = 15,                     /* "-"  */
+  YYSYMBOL_ASTER = 16,                     /* "*"  */
+  YYSYMBOL_SLASH = 17,                     /* "/"  */
+  YYSYMBOL_SQUARE_OPEN = 18,               /* "["  */
+  YYSYMBOL_SQUARE_CLOSE = 19,              /* "]"  */
+  YYSYMBOL_EXKLA = 20,                     /* "!"  */
+  YYSYMBOL_EQ = 21,                        /* "="  */
+  YYSYMBOL_LT_SIGN = 22,                   /* "<"  */
+  YYSYMBOL_GT_SIGN = 23,                   /* ">"  */
+  YYSYMBOL_LT_EQ_SIGN = 24,                /* "<="  */
+  YYSYMBOL_GT_EQ_SIGN = 25,                /* ">="  */
+  YYSYMBOL_ANDAND = 26,                    /* "&&"  */
+  YYSYMBOL_OROR = 27,                      /* "||"  */
+  YYSYMBOL_EQEQ = 28,                      /* "=="  */
+  YYSYMBOL_EXKLA_EQ = 29,                  /* "!="  */
+  YYSYMBOL_IF = 30,                        /* "if"  */
+  YYSYMBOL_ELSE = 31,                      /* "else"  */
+  YYSYMBOL_WHILE = 32,                     /* "while"  */
+  YYSYMBOL_RETURN = 33,                    /* "return"  */
+  YYSYMBOL_SEMICOLON = 34,                 /* ";"  */
+  YYSYMBOL_COMMA = 35,                     /* ","  */
+  YYSYMBOL_START_UNIT = 36,                /* START_UNIT  */
+  YYSYMBOL_START_PROG = 37,                /* START_PROG  */
+  YYSYMBOL_NOT_ELSE = 38,                  /* NOT_ELSE  */
+  YYSYMBOL_EX_MINUS = 39,                  /* EX_MINUS  */
+  YYSYMBOL_EX_EXKL = 40,                   /* EX_EXKL  */
+  YYSYMBOL_YYACCEPT = 41,                  /* $accept  */
+  YYSYMBOL_toplevel = 42,                  /* toplevel  */
+  YYSYMBOL_unit_test = 43,                 /* unit_test  */
+  YYSYMBOL_expression = 44,                /* expression  */
+  YYSYMBOL_arguments = 45,                 /* arguments  */
+  YYSYMBOL_assignment = 46,                /* assignment  */
+  YYSYMBOL_declaration = 47,               /* declaration  */
+  YYSYMBOL_identifier = 48,                /* identifier  */
+  YYSYMBOL_statement = 49,                 /* statement  */
+  YYSYMBOL_statements = 50,                /* statements  */
+  YYSYMBOL_compound_statement = 51,        /* compound_statement  */
+  YYSYMBOL_literal = 52,                   /* literal  */
+  YYSYMBOL_parameters = 53,                /* parameters  */
+  YYSYMBOL_function_def = 54,              /* function_def  */
+  YYSYMBOL_function_defs = 55,             /* function_defs  */
+  YYSYMBOL_program = 56                    /* program  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined MCC_PARSER_LTYPE_IS_TRIVIAL && MCC_PARSER_LTYPE_IS_TRIVIAL \
+             && defined MCC_PARSER_STYPE_IS_TRIVIAL && MCC_PARSER_STYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  35
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   413
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  41
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  16
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  65
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  129
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   293
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,    36,    37,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    38,    39,    40
+};
+
+#if MCC_PARSER_DEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   169,   169,   170,   172,   176,   178,   180,   182,   184,
+     187,   190,   192,   194,   198,   199,   201,   203,   205,   207,
+     209,   211,   213,   215,   217,   219,   221,   223,   224,   226,
+     228,   229,   231,   235,   236,   237,   241,   242,   246,   247,
+     251,   254,   256,   258,   259,   261,   262,   263,   264,   265,
+     268,   269,   272,   273,   276,   277,   278,   279,   282,   283,
+     284,   287,   289,   293,   294,   297
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"EOF\"", "error", "\"invalid token\"", "\"integer literal\"",
+  "\"float literal\"", "\"bool literal\"", "\"string literal\"",
+  "\"identifier\"", "\"type\"", "\"void\"", "\"(\"", "\")\"", "\"{\"",
+  "\"}\"", "\"+\"", "\"-\"", "\"*\"", "\"/\"", "\"[\"", "\"]\"", "\"!\"",
+  "\"=\"", "\"<\"", "\">\"", "\"<=\"", "\">=\"", "\"&&\"", "\"||\"",
+  "\"==\"", "\"!=\"", "\"if\"", "\"else\"", "\"while\"", "\"return\"",
+  "\";\"", "\",\"", "START_UNIT", "START_PROG", "NOT_ELSE", "EX_MINUS",
+  "EX_EXKL", "$accept", "toplevel", "unit_test", "expression", "arguments",
+  "assignment", "declaration", "identifier", "statement", "statements",
+  "compound_statement", "literal", "parameters", "function_def",
+  "function_defs", "program", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-40)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-11)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      13,   123,    26,     4,   -40,   -40,   -40,   -40,   -40,    12,
+       3,   334,   154,   334,   334,    -3,    19,    17,    36,    65,
+     -40,    11,    20,     7,   -40,   -40,   -40,   -40,    39,    63,
+     -40,   -40,     3,   -40,    47,   -40,    53,    59,    68,   269,
+      -5,    12,   -40,   232,    11,    49,   -40,   185,   -40,   -40,
+     -40,   334,   334,   -40,   248,   -40,   334,   334,   334,   334,
+     334,   334,   334,   334,   334,   334,   334,   334,   -40,   334,
+     -40,   -40,    95,   334,   334,   334,   -40,    59,   -40,    54,
+      95,    95,   -40,   334,   -40,   -40,   -40,   288,   307,   -40,
+      85,    85,   -40,   -40,    81,    81,    81,    81,   384,   384,
+      81,    81,   216,   -40,    71,   -40,    96,   336,   368,     3,
+      98,    99,   352,   204,   204,   -40,    90,   -40,   102,   102,
+     -40,    84,   -40,   334,   -40,   -40,   204,   368,   -40
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,    35,     0,     0,    54,    55,    56,    57,    40,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     5,
+      12,     7,     6,    30,     8,     9,    14,    11,    64,    65,
+      13,     4,     0,    64,     0,     1,     0,    38,     0,     0,
+      30,     0,    53,     0,     0,     0,    51,     0,    49,    28,
+      29,     0,     0,    47,     0,     2,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    43,    35,
+      45,    46,    60,    35,     0,     0,    63,     0,     3,     0,
+      60,    60,    27,     0,    38,    52,    50,     0,     0,    48,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    33,    34,    58,    59,     0,     0,    36,     0,
+       0,     0,     0,     0,     0,    32,    31,    39,     0,     0,
+      31,    41,    44,     0,    62,    61,     0,    37,    42
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -40,   -40,   -40,     1,   -25,   115,     5,    -1,    -9,   -40,
+       0,   -40,   -39,    14,   -40,   118
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     3,    18,    43,    20,    44,    45,    40,    24,    47,
+      48,    26,    27,    28,    29,    30
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      23,    25,    19,    46,    35,    73,    22,    51,    37,    38,
+       8,    23,    39,    83,    49,    50,    33,    73,    54,     8,
+       4,     5,     6,     7,     8,    74,    31,    11,    75,    52,
+      36,    77,    13,   105,    32,    10,    55,    14,    86,   -10,
+      84,   110,   111,    76,   103,    70,    23,    78,   106,     1,
+       2,    53,    87,    88,    71,    72,    79,    90,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,    80,
+     102,    32,    10,   109,   102,   107,   108,   104,    81,    56,
+      57,    58,    59,    71,   112,   104,   104,    60,    61,    62,
+      63,    64,    65,    66,    67,    56,    57,    58,    59,    68,
+      69,    58,    59,    41,   121,   122,    72,   115,   117,   118,
+     119,   123,    23,    23,    12,   126,    21,   128,   124,   125,
+      34,     0,     0,     0,   127,    23,     4,     5,     6,     7,
+       8,     9,    10,    11,     0,    12,     0,     0,    13,     0,
+       0,     0,     0,    14,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    15,     0,    16,    17,     4,     5,     6,
+       7,     8,    41,     0,    11,     0,    12,    42,     0,    13,
+       0,     0,     0,     0,    14,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    15,     0,    16,    17,     4,     5,
+       6,     7,     8,    41,     0,    11,     0,    12,    85,     0,
+      13,     0,     0,     0,     0,    14,     0,     4,     5,     6,
+       7,     8,    41,     0,    11,    15,    12,    16,    17,    13,
+       0,     0,     0,     0,    14,     0,     0,     0,     0,     0,
+      56,    57,    58,    59,    15,     0,    16,    17,    60,    61,
+      62,    63,    64,    65,    66,    67,    56,    57,    58,    59,
+       0,    69,     0,     0,    60,    61,    62,    63,    64,    65,
+      66,    67,    56,    57,    58,    59,    68,     0,     0,     0,
+      60,    61,    62,    63,    64,    65,    66,    67,     0,     0,
+      82,     0,    89,    56,    57,    58,    59,     0,     0,     0,
+       0,    60,    61,    62,    63,    64,    65,    66,    67,   113,
+       0,     0,    56,    57,    58,    59,     0,     0,     0,     0,
+      60,    61,    62,    63,    64,    65,    66,    67,   114,     0,
+       0,    56,    57,    58,    59,     0,     0,     0,     0,    60,
+      61,    62,    63,    64,    65,    66,    67,     4,     5,     6,
+       7,     8,     0,     0,    11,     0,     0,     0,     0,    13,
+      56,    57,    58,    59,    14,   116,     0,     0,    60,    61,
+      62,    63,    64,    65,    66,    67,    56,    57,    58,    59,
+       0,   120,     0,     0,    60,    61,    62,    63,    64,    65,
+      66,    67,    56,    57,    58,    59,     0,     0,     0,     0,
+      60,    61,    62,    63,    64,    65,    66,    67,    56,    57,
+      58,    59,     0,     0,     0,     0,    60,    61,    62,    63,
+       0,     0,    66,    67
+};
+
+static const yytype_int8 yycheck[] =
+{
+       1,     1,     1,    12,     0,    10,     1,    10,     9,    10,
+       7,    12,    11,    18,    13,    14,     2,    10,    17,     7,
+       3,     4,     5,     6,     7,    18,     0,    10,    21,    10,
+      18,    32,    15,    72,     8,     9,     0,    20,    47,     0,
+      41,    80,    81,    29,    69,    34,    47,     0,    73,    36,
+      37,    34,    51,    52,    34,    35,     3,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    10,
+      69,     8,     9,    19,    73,    74,    75,    72,    10,    14,
+      15,    16,    17,    34,    83,    80,    81,    22,    23,    24,
+      25,    26,    27,    28,    29,    14,    15,    16,    17,    34,
+      35,    16,    17,     8,   113,   114,    35,    11,   109,    11,
+      11,    21,   113,   114,    12,    31,     1,   126,   118,   119,
+       2,    -1,    -1,    -1,   123,   126,     3,     4,     5,     6,
+       7,     8,     9,    10,    -1,    12,    -1,    -1,    15,    -1,
+      -1,    -1,    -1,    20,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    30,    -1,    32,    33,     3,     4,     5,
+       6,     7,     8,    -1,    10,    -1,    12,    13,    -1,    15,
+      -1,    -1,    -1,    -1,    20,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    30,    -1,    32,    33,     3,     4,
+       5,     6,     7,     8,    -1,    10,    -1,    12,    13,    -1,
+      15,    -1,    -1,    -1,    -1,    20,    -1,     3,     4,     5,
+       6,     7,     8,    -1,    10,    30,    12,    32,    33,    15,
+      -1,    -1,    -1,    -1,    20,    -1,    -1,    -1,    -1,    -1,
+      14,    15,    16,    17,    30,    -1,    32,    33,    22,    23,
+      24,    25,    26,    27,    28,    29,    14,    15,    16,    17,
+      -1,    35,    -1,    -1,    22,    23,    24,    25,    26,    27,
+      28,    29,    14,    15,    16,    17,    34,    -1,    -1,    -1,
+      22,    23,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      11,    -1,    34,    14,    15,    16,    17,    -1,    -1,    -1,
+      -1,    22,    23,    24,    25,    26,    27,    28,    29,    11,
+      -1,    -1,    14,    15,    16,    17,    -1,    -1,    -1,    -1,
+      22,    23,    24,    25,    26,    27,    28,    29,    11,    -1,
+      -1,    14,    15,    16,    17,    -1,    -1,    -1,    -1,    22,
+      23,    24,    25,    26,    27,    28,    29,     3,     4,     5,
+       6,     7,    -1,    -1,    10,    -1,    -1,    -1,    -1,    15,
+      14,    15,    16,    17,    20,    19,    -1,    -1,    22,    23,
+      24,    25,    26,    27,    28,    29,    14,    15,    16,    17,
+      -1,    19,    -1,    -1,    22,    23,    24,    25,    26,    27,
+      28,    29,    14,    15,    16,    17,    -1,    -1,    -1,    -1,
+      22,    23,    24,    25,    26,    27,    28,    29,    14,    15,
+      16,    17,    -1,    -1,    -1,    -1,    22,    23,    24,    25,
+      -1,    -1,    28,    29
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    36,    37,    42,     3,     4,     5,     6,     7,     8,
+       9,    10,    12,    15,    20,    30,    32,    33,    43,    44,
+      45,    46,    47,    48,    49,    51,    52,    53,    54,    55,
+      56,     0,     8,    54,    56,     0,    18,    48,    48,    44,
+      48,     8,    13,    44,    46,    47,    49,    50,    51,    44,
+      44,    10,    10,    34,    44,     0,    14,    15,    16,    17,
+      22,    23,    24,    25,    26,    27,    28,    29,    34,    35,
+      34,    34,    35,    10,    18,    21,    54,    48,     0,     3,
+      10,    10,    11,    18,    48,    13,    49,    44,    44,    34,
+      44,    44,    44,    44,    44,    44,    44,    44,    44,    44,
+      44,    44,    44,    45,    47,    53,    45,    44,    44,    19,
+      53,    53,    44,    11,    11,    11,    19,    48,    11,    11,
+      19,    49,    49,    21,    51,    51,    31,    44,    49
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    41,    42,    42,    42,    43,    43,    43,    43,    43,
+      43,    43,    43,    43,    44,    44,    44,    44,    44,    44,
+      44,    44,    44,    44,    44,    44,    44,    44,    44,    44,
+      44,    44,    44,    45,    45,    45,    46,    46,    47,    47,
+      48,    49,    49,    49,    49,    49,    49,    49,    49,    49,
+      50,    50,    51,    51,    52,    52,    52,    52,    53,    53,
+      53,    54,    54,    55,    55,    56
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     3,     3,     2,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     2,     2,
+       1,     4,     4,     1,     3,     0,     3,     6,     2,     5,
+       1,     5,     7,     2,     5,     2,     2,     2,     3,     1,
+       2,     1,     3,     2,     1,     1,     1,     1,     1,     3,
+       0,     6,     6,     2,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = TK_MCC_PARSER_EMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == TK_MCC_PARSER_EMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, scanner, result, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use TK_MCC_PARSER_error or TK_MCC_PARSER_UNDEF. */
+#define YYERRCODE TK_MCC_PARSER_UNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if MCC_PARSER_DEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined MCC_PARSER_LTYPE_IS_TRIVIAL && MCC_PARSER_LTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, scanner, result); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void *scanner, struct mcc_parser_result* result)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (result);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void *scanner, struct mcc_parser_result* result)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner, result);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, void *scanner, struct mcc_parser_result* result)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner, result);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, result); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !MCC_PARSER_DEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !MCC_PARSER_DEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, void *scanner, struct mcc_parser_result* result)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (result);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_STRING_LITERAL: /* "string literal"  */
+#line 163 "/tmp/wt/src/parser.y"
+            { mcc_free(MCC_ALLOC_STRING, ((*yyvaluep).TK_STRING_LITERAL)); }
+#line 1385 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_expression: /* expression  */
+#line 150 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_expression)); }
+#line 1391 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_arguments: /* arguments  */
+#line 161 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_arguments)); }
+#line 1397 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_assignment: /* assignment  */
+#line 152 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_assignment)); }
+#line 1403 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_declaration: /* declaration  */
+#line 153 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_declaration)); }
+#line 1409 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_identifier: /* identifier  */
+#line 162 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_identifier)); }
+#line 1415 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_statement: /* statement  */
+#line 151 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_statement)); }
+#line 1421 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_statements: /* statements  */
+#line 156 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_statements)); }
+#line 1427 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_compound_statement: /* compound_statement  */
+#line 155 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_compound_statement)); }
+#line 1433 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_literal: /* literal  */
+#line 154 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_literal)); }
+#line 1439 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_parameters: /* parameters  */
+#line 157 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_parameters)); }
+#line 1445 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_function_def: /* function_def  */
+#line 158 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_function_def)); }
+#line 1451 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_function_defs: /* function_defs  */
+#line 159 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_function_defs)); }
+#line 1457 "parser.tab.c"
+        break;
+
+    case YYSYMBOL_program: /* program  */
+#line 160 "/tmp/wt/src/parser.y"
+            { mcc_ast_delete(((*yyvaluep).TK_program)); }
+#line 1463 "parser.tab.c"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void *scanner, struct mcc_parser_result* result)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined MCC_PARSER_LTYPE_IS_TRIVIAL && MCC_PARSER_LTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = TK_MCC_PARSER_EMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == TK_MCC_PARSER_EMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= TK_END)
+    {
+      yychar = TK_END;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == TK_MCC_PARSER_error)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = TK_MCC_PARSER_UNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = TK_MCC_PARSER_EMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 3: /* toplevel: START_PROG program "EOF"  */
+#line 171 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_PROGRAM; result->program = (yyvsp[-1].TK_program); }
+#line 1769 "parser.tab.c"
+    break;
+
+  case 4: /* toplevel: START_PROG "EOF"  */
+#line 172 "/tmp/wt/src/parser.y"
+                                     { result->entry_point = MCC_PARSER_ENTRY_POINT_PROGRAM; 
+                        result->program = mcc_ast_new_empty_program(result->filename); }
+#line 1776 "parser.tab.c"
+    break;
+
+  case 5: /* unit_test: expression  */
+#line 177 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_EXPRESSION; result->expression = (yyvsp[0].TK_expression); }
+#line 1782 "parser.tab.c"
+    break;
+
+  case 6: /* unit_test: declaration  */
+#line 179 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_DECLARATION; result->declaration = (yyvsp[0].TK_declaration); }
+#line 1788 "parser.tab.c"
+    break;
+
+  case 7: /* unit_test: assignment  */
+#line 181 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_ASSIGNMENT; result->assignment = (yyvsp[0].TK_assignment); }
+#line 1794 "parser.tab.c"
+    break;
+
+  case 8: /* unit_test: statement  */
+#line 183 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_STATEMENT; result->statement = (yyvsp[0].TK_statement); }
+#line 1800 "parser.tab.c"
+    break;
+
+  case 9: /* unit_test: compound_statement  */
+#line 185 "/tmp/wt/src/parser.y"
+                      { result->entry_point =
+                        MCC_PARSER_ENTRY_POINT_COMPOUND_STATEMENT; result->compound_statement = (yyvsp[0].TK_compound_statement); }
+#line 1807 "parser.tab.c"
+    break;
+
+  case 10: /* unit_test: function_def  */
+#line 188 "/tmp/wt/src/parser.y"
+                      { result->entry_point =
+                        MCC_PARSER_ENTRY_POINT_FUNCTION_DEFINITION; result->function_definition = (yyvsp[0].TK_function_def); }
+#line 1814 "parser.tab.c"
+    break;
+
+  case 11: /* unit_test: parameters  */
+#line 191 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_PARAMETERS; result->parameters = (yyvsp[0].TK_parameters); }
+#line 1820 "parser.tab.c"
+    break;
+
+  case 12: /* unit_test: arguments  */
+#line 193 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_ARGUMENTS; result->arguments = (yyvsp[0].TK_arguments); }
+#line 1826 "parser.tab.c"
+    break;
+
+  case 13: /* unit_test: program  */
+#line 195 "/tmp/wt/src/parser.y"
+                      { result->entry_point = MCC_PARSER_ENTRY_POINT_PROGRAM; result->program = (yyvsp[0].TK_program); }
+#line 1832 "parser.tab.c"
+    break;
+
+  case 14: /* expression: literal  */
+#line 198 "/tmp/wt/src/parser.y"
+                              { (yyval.TK_expression) = mcc_ast_new_expression_literal((yyvsp[0].TK_literal));                           loc((yyval.TK_expression), (yylsp[0]) ,(yylsp[0])); }
+#line 1838 "parser.tab.c"
+    break;
+
+  case 15: /* expression: expression "+" expression  */
+#line 200 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_ADD, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));      loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1844 "parser.tab.c"
+    break;
+
+  case 16: /* expression: expression "-" expression  */
+#line 202 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_SUB, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));      loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1850 "parser.tab.c"
+    break;
+
+  case 17: /* expression: expression "*" expression  */
+#line 204 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_MUL, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));      loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1856 "parser.tab.c"
+    break;
+
+  case 18: /* expression: expression "/" expression  */
+#line 206 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_DIV, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));      loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1862 "parser.tab.c"
+    break;
+
+  case 19: /* expression: expression "<" expression  */
+#line 208 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_SMALLER, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));  loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1868 "parser.tab.c"
+    break;
+
+  case 20: /* expression: expression ">" expression  */
+#line 210 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_GREATER, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));  loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1874 "parser.tab.c"
+    break;
+
+  case 21: /* expression: expression "<=" expression  */
+#line 212 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_SMALLEREQ,(yyvsp[-2].TK_expression),(yyvsp[0].TK_expression));  loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1880 "parser.tab.c"
+    break;
+
+  case 22: /* expression: expression ">=" expression  */
+#line 214 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_GREATEREQ,(yyvsp[-2].TK_expression),(yyvsp[0].TK_expression));  loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1886 "parser.tab.c"
+    break;
+
+  case 23: /* expression: expression "&&" expression  */
+#line 216 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_CONJ, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));     loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1892 "parser.tab.c"
+    break;
+
+  case 24: /* expression: expression "||" expression  */
+#line 218 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_DISJ, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));     loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1898 "parser.tab.c"
+    break;
+
+  case 25: /* expression: expression "==" expression  */
+#line 220 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_EQUAL, (yyvsp[-2].TK_expression), (yyvsp[0].TK_expression));    loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1904 "parser.tab.c"
+    break;
+
+  case 26: /* expression: expression "!=" expression  */
+#line 222 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_binary_op(MCC_AST_BINARY_OP_NOTEQUAL,(yyvsp[-2].TK_expression),(yyvsp[0].TK_expression));   loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1910 "parser.tab.c"
+    break;
+
+  case 27: /* expression: "(" expression ")"  */
+#line 223 "/tmp/wt/src/parser.y"
+                                                   { (yyval.TK_expression) = mcc_ast_new_expression_parenth((yyvsp[-1].TK_expression));      loc((yyval.TK_expression), (yylsp[-2]), (yylsp[0])); }
+#line 1916 "parser.tab.c"
+    break;
+
+  case 28: /* expression: "-" expression  */
+#line 225 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_unary_op(MCC_AST_UNARY_OP_NEGATIV, (yyvsp[0].TK_expression));        loc((yyval.TK_expression), (yylsp[-1]), (yylsp[0])); }
+#line 1922 "parser.tab.c"
+    break;
+
+  case 29: /* expression: "!" expression  */
+#line 227 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_unary_op(MCC_AST_UNARY_OP_NOT, (yyvsp[0].TK_expression));            loc((yyval.TK_expression), (yylsp[-1]), (yylsp[0])); }
+#line 1928 "parser.tab.c"
+    break;
+
+  case 30: /* expression: identifier  */
+#line 228 "/tmp/wt/src/parser.y"
+                                 { (yyval.TK_expression) = mcc_ast_new_expression_variable((yyvsp[0].TK_identifier));                       loc((yyval.TK_expression), (yylsp[0]), (yylsp[0])); }
+#line 1934 "parser.tab.c"
+    break;
+
+  case 31: /* expression: identifier "[" expression "]"  */
+#line 230 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_array_element((yyvsp[-3].TK_identifier),(yyvsp[-1].TK_expression));                          loc((yyval.TK_expression), (yylsp[-3]), (yylsp[0])); }
+#line 1940 "parser.tab.c"
+    break;
+
+  case 32: /* expression: identifier "(" arguments ")"  */
+#line 232 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_expression) = mcc_ast_new_expression_function_call((yyvsp[-3].TK_identifier), (yyvsp[-1].TK_arguments));                         loc((yyval.TK_expression), (yylsp[-3]), (yylsp[0])); }
+#line 1946 "parser.tab.c"
+    break;
+
+  case 33: /* arguments: expression  */
+#line 235 "/tmp/wt/src/parser.y"
+                                 { (yyval.TK_arguments) = mcc_ast_new_arguments(false, (yyvsp[0].TK_expression), NULL);                    loc((yyval.TK_arguments), (yylsp[0]), (yylsp[0])); }
+#line 1952 "parser.tab.c"
+    break;
+
+  case 34: /* arguments: expression "," arguments  */
+#line 236 "/tmp/wt/src/parser.y"
+                                                 { (yyval.TK_arguments) = mcc_ast_new_arguments(false, (yyvsp[-2].TK_expression), (yyvsp[0].TK_arguments));      loc((yyval.TK_arguments), (yylsp[-2]), (yylsp[0])); }
+#line 1958 "parser.tab.c"
+    break;
+
+  case 35: /* arguments: %empty  */
+#line 237 "/tmp/wt/src/parser.y"
+                             { (yyval.TK_arguments) = mcc_ast_new_arguments(true, NULL, NULL); }
+#line 1964 "parser.tab.c"
+    break;
+
+  case 36: /* assignment: identifier "=" expression  */
+#line 241 "/tmp/wt/src/parser.y"
+                                               { (yyval.TK_assignment) = mcc_ast_new_variable_assignment ((yyvsp[-2].TK_identifier), (yyvsp[0].TK_expression));    loc((yyval.TK_assignment), (yylsp[-2]), (yylsp[0])); }
+#line 1970 "parser.tab.c"
+    break;
+
+  case 37: /* assignment: identifier "[" expression "]" "=" expression  */
+#line 243 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_assignment) = mcc_ast_new_array_assignment ((yyvsp[-5].TK_identifier), (yyvsp[-3].TK_expression), (yyvsp[0].TK_expression));                            loc((yyval.TK_assignment), (yylsp[-5]), (yylsp[0])); }
+#line 1976 "parser.tab.c"
+    break;
+
+  case 38: /* declaration: "type" identifier  */
+#line 246 "/tmp/wt/src/parser.y"
+                                      { (yyval.TK_declaration) = mcc_ast_new_variable_declaration((yyvsp[-1].TK_TYPE),(yyvsp[0].TK_identifier));              loc((yyval.TK_declaration), (yylsp[-1]), (yylsp[0])); }
+#line 1982 "parser.tab.c"
+    break;
+
+  case 39: /* declaration: "type" "[" "integer literal" "]" identifier  */
+#line 248 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_declaration) = mcc_ast_new_array_declaration((yyvsp[-4].TK_TYPE), mcc_ast_new_literal_int((yyvsp[-2].TK_INT_LITERAL)), (yyvsp[0].TK_identifier));   loc((yyval.TK_declaration), (yylsp[-4]), (yylsp[0])); }
+#line 1988 "parser.tab.c"
+    break;
+
+  case 40: /* identifier: "identifier"  */
+#line 251 "/tmp/wt/src/parser.y"
+                                 { (yyval.TK_identifier) = mcc_ast_new_identifier((yyvsp[0].TK_IDENTIFIER));                                loc((yyval.TK_identifier), (yylsp[0]), (yylsp[0])); }
+#line 1994 "parser.tab.c"
+    break;
+
+  case 41: /* statement: "if" "(" expression ")" statement  */
+#line 255 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_statement) = mcc_ast_new_statement_if_stmt( (yyvsp[-2].TK_expression), (yyvsp[0].TK_statement));                               loc((yyval.TK_statement), (yylsp[-4]), (yylsp[0])); }
+#line 2000 "parser.tab.c"
+    break;
+
+  case 42: /* statement: "if" "(" expression ")" statement "else" statement  */
+#line 257 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_statement) = mcc_ast_new_statement_if_else_stmt( (yyvsp[-4].TK_expression), (yyvsp[-2].TK_statement), (yyvsp[0].TK_statement));                      loc((yyval.TK_statement), (yylsp[-6]), (yylsp[0])); }
+#line 2006 "parser.tab.c"
+    break;
+
+  case 43: /* statement: expression ";"  */
+#line 258 "/tmp/wt/src/parser.y"
+                                           { (yyval.TK_statement) = mcc_ast_new_statement_expression( (yyvsp[-1].TK_expression));           loc((yyval.TK_statement), (yylsp[-1]), (yylsp[0])); }
+#line 2012 "parser.tab.c"
+    break;
+
+  case 44: /* statement: "while" "(" expression ")" statement  */
+#line 260 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_statement) = mcc_ast_new_statement_while( (yyvsp[-2].TK_expression), (yyvsp[0].TK_statement));                                 loc((yyval.TK_statement), (yylsp[-4]), (yylsp[0])); }
+#line 2018 "parser.tab.c"
+    break;
+
+  case 45: /* statement: assignment ";"  */
+#line 261 "/tmp/wt/src/parser.y"
+                                           { (yyval.TK_statement) = mcc_ast_new_statement_assignment((yyvsp[-1].TK_assignment));            loc((yyval.TK_statement), (yylsp[-1]), (yylsp[0])); }
+#line 2024 "parser.tab.c"
+    break;
+
+  case 46: /* statement: declaration ";"  */
+#line 262 "/tmp/wt/src/parser.y"
+                                            { (yyval.TK_statement) = mcc_ast_new_statement_declaration((yyvsp[-1].TK_declaration));          loc((yyval.TK_statement), (yylsp[-1]), (yylsp[0])); }
+#line 2030 "parser.tab.c"
+    break;
+
+  case 47: /* statement: "return" ";"  */
+#line 263 "/tmp/wt/src/parser.y"
+                                       { (yyval.TK_statement) = mcc_ast_new_statement_return(true, NULL);            loc((yyval.TK_statement), (yylsp[-1]), (yylsp[0])); }
+#line 2036 "parser.tab.c"
+    break;
+
+  case 48: /* statement: "return" expression ";"  */
+#line 264 "/tmp/wt/src/parser.y"
+                                                  { (yyval.TK_statement) = mcc_ast_new_statement_return(false, (yyvsp[-1].TK_expression));  loc((yyval.TK_statement), (yylsp[-2]), (yylsp[0])); }
+#line 2042 "parser.tab.c"
+    break;
+
+  case 49: /* statement: compound_statement  */
+#line 265 "/tmp/wt/src/parser.y"
+                                         { (yyval.TK_statement) = mcc_ast_new_statement_compound_stmt((yyvsp[0].TK_compound_statement));           loc((yyval.TK_statement), (yylsp[0]), (yylsp[0])); }
+#line 2048 "parser.tab.c"
+    break;
+
+  case 50: /* statements: statements statement  */
+#line 268 "/tmp/wt/src/parser.y"
+                                           { (yyval.TK_statements) = mcc_ast_new_compound_stmt(false, (yyvsp[0].TK_statement), (yyvsp[-1].TK_statements));        loc((yyval.TK_statements), (yylsp[0]), (yylsp[0])); }
+#line 2054 "parser.tab.c"
+    break;
+
+  case 51: /* statements: statement  */
+#line 269 "/tmp/wt/src/parser.y"
+                                           { (yyval.TK_statements) = mcc_ast_new_compound_stmt(false, (yyvsp[0].TK_statement), NULL);      loc((yyval.TK_statements), (yylsp[0]), (yylsp[0])); }
+#line 2060 "parser.tab.c"
+    break;
+
+  case 52: /* compound_statement: "{" statements "}"  */
+#line 272 "/tmp/wt/src/parser.y"
+                                                      { (yyval.TK_compound_statement) = reverse_statements((yyvsp[-1].TK_statements));               loc((yyval.TK_compound_statement), (yylsp[-2]), (yylsp[0])); }
+#line 2066 "parser.tab.c"
+    break;
+
+  case 53: /* compound_statement: "{" "}"  */
+#line 273 "/tmp/wt/src/parser.y"
+                                           { (yyval.TK_compound_statement) = mcc_ast_new_compound_stmt(true,NULL,NULL);       loc((yyval.TK_compound_statement), (yylsp[-1]), (yylsp[0])); }
+#line 2072 "parser.tab.c"
+    break;
+
+  case 54: /* literal: "integer literal"  */
+#line 276 "/tmp/wt/src/parser.y"
+                                     { (yyval.TK_literal) = mcc_ast_new_literal_int((yyvsp[0].TK_INT_LITERAL));                           loc((yyval.TK_literal), (yylsp[0]), (yylsp[0])); }
+#line 2078 "parser.tab.c"
+    break;
+
+  case 55: /* literal: "float literal"  */
+#line 277 "/tmp/wt/src/parser.y"
+                                     { (yyval.TK_literal) = mcc_ast_new_literal_float((yyvsp[0].TK_FLOAT_LITERAL));                         loc((yyval.TK_literal), (yylsp[0]), (yylsp[0])); }
+#line 2084 "parser.tab.c"
+    break;
+
+  case 56: /* literal: "bool literal"  */
+#line 278 "/tmp/wt/src/parser.y"
+                                     { (yyval.TK_literal) = mcc_ast_new_literal_bool((yyvsp[0].TK_BOOL_LITERAL));                          loc((yyval.TK_literal), (yylsp[0]), (yylsp[0])); }
+#line 2090 "parser.tab.c"
+    break;
+
+  case 57: /* literal: "string literal"  */
+#line 279 "/tmp/wt/src/parser.y"
+                                     { (yyval.TK_literal) = mcc_ast_new_literal_string((yyvsp[0].TK_STRING_LITERAL)); mcc_free(MCC_ALLOC_STRING, (yyvsp[0].TK_STRING_LITERAL)); loc((yyval.TK_literal), (yylsp[0]), (yylsp[0])); }
+#line 2096 "parser.tab.c"
+    break;
+
+  case 58: /* parameters: declaration  */
+#line 282 "/tmp/wt/src/parser.y"
+                                     { (yyval.TK_parameters) = mcc_ast_new_parameters(false, (yyvsp[0].TK_declaration), NULL );              loc((yyval.TK_parameters), (yylsp[0]), (yylsp[0])); }
+#line 2102 "parser.tab.c"
+    break;
+
+  case 59: /* parameters: declaration "," parameters  */
+#line 283 "/tmp/wt/src/parser.y"
+                                                     { (yyval.TK_parameters) = mcc_ast_new_parameters(false, (yyvsp[-2].TK_declaration), (yyvsp[0].TK_parameters) );loc((yyval.TK_parameters), (yylsp[-2]), (yylsp[0])); }
+#line 2108 "parser.tab.c"
+    break;
+
+  case 60: /* parameters: %empty  */
+#line 284 "/tmp/wt/src/parser.y"
+                             { (yyval.TK_parameters) = mcc_ast_new_parameters(true, NULL, NULL); }
+#line 2114 "parser.tab.c"
+    break;
+
+  case 61: /* function_def: "void" identifier "(" parameters ")" compound_statement  */
+#line 288 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_function_def) = mcc_ast_new_void_function_def((yyvsp[-4].TK_identifier), (yyvsp[-2].TK_parameters), (yyvsp[0].TK_compound_statement));                            loc((yyval.TK_function_def), (yylsp[-5]), (yylsp[0])); }
+#line 2120 "parser.tab.c"
+    break;
+
+  case 62: /* function_def: "type" identifier "(" parameters ")" compound_statement  */
+#line 290 "/tmp/wt/src/parser.y"
+                      { (yyval.TK_function_def) = mcc_ast_new_type_function_def((yyvsp[-5].TK_TYPE), (yyvsp[-4].TK_identifier), (yyvsp[-2].TK_parameters), (yyvsp[0].TK_compound_statement));                        loc((yyval.TK_function_def), (yylsp[-5]), (yylsp[0])); }
+#line 2126 "parser.tab.c"
+    break;
+
+  case 63: /* function_defs: function_defs function_def  */
+#line 293 "/tmp/wt/src/parser.y"
+                                                  { (yyval.TK_function_defs) = mcc_ast_new_program((yyvsp[0].TK_function_def), (yyvsp[-1].TK_function_defs));              loc((yyval.TK_function_defs), (yylsp[0]), (yylsp[0])); }
+#line 2132 "parser.tab.c"
+    break;
+
+  case 64: /* function_defs: function_def  */
+#line 294 "/tmp/wt/src/parser.y"
+                                                  { (yyval.TK_function_defs) = mcc_ast_new_program((yyvsp[0].TK_function_def), NULL);            loc((yyval.TK_function_defs), (yylsp[0]), (yylsp[0])); }
+#line 2138 "parser.tab.c"
+    break;
+
+  case 65: /* program: function_defs  */
+#line 297 "/tmp/wt/src/parser.y"
+                                    { (yyval.TK_program) = reverse_functions((yyvsp[0].TK_function_defs));                                  loc((yyval.TK_program), (yylsp[0]), (yylsp[0])); }
+#line 2144 "parser.tab.c"
+    break;
+
+
+#line 2148 "parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == TK_MCC_PARSER_EMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, scanner, result, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= TK_END)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == TK_END)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, scanner, result);
+          yychar = TK_MCC_PARSER_EMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner, result);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, scanner, result, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != TK_MCC_PARSER_EMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, scanner, result);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner, result);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 300 "/tmp/wt/src/parser.y"
+
+
+// clang-format on
+
+#include <assert.h>
+
+#include "scanner.h"
+#include "mcc/alloc.h"
+#include "utils/unused.h"
+#include "utils/length_of_int.h"
+#include "mcc/parser.h"
+
+// Statements and functions are collected by left recursive rules, so that the parser stack does not grow with their
+// number. Each one is prepended to the list, which is reversed once complete. Like a right recursive rule would, the
+// location of each list node extends to the end of the list.
+static struct mcc_ast_compound_statement *reverse_statements(struct mcc_ast_compound_statement *last)
+{
+	struct mcc_ast_compound_statement *head = NULL;
+	struct mcc_ast_compound_statement *current = last;
+	while (current) {
+		struct mcc_ast_compound_statement *next = current->next_compound_statement;
+		current->next_compound_statement = head;
+		current->has_next_statement = head != NULL;
+		current->node.sloc.end_line = last->node.sloc.end_line;
+		current->node.sloc.end_col = last->node.sloc.end_col;
+		head = current;
+		current = next;
+	}
+	return head;
+}
+
+static struct mcc_ast_program *reverse_functions(struct mcc_ast_program *last)
+{
+	struct mcc_ast_program *head = NULL;
+	struct mcc_ast_program *current = last;
+	while (current) {
+		struct mcc_ast_program *next = current->next_function;
+		current->next_function = head;
+		current->has_next_function = head != NULL;
+		current->node.sloc.end_line = last->node.sloc.end_line;
+		current->node.sloc.end_col = last->node.sloc.end_col;
+		head = current;
+		current = next;
+	}
+	return head;
+}
+
+// Parse the input the scanner was set up with and destroy the scanner afterwards
+static struct mcc_parser_result parse(yyscan_t scanner, enum mcc_parser_entry_point entry_point, char *name)
+{
+	struct mcc_parser_result result = {
+	    .status = MCC_PARSER_STATUS_OK,
+	    .error_buffer = NULL,
+	};
+
+	if (entry_point != MCC_PARSER_ENTRY_POINT_PROGRAM) {
+		result.filename = "<test_suite>";
+		mcc_parser_set_extra(1, scanner);
+	} else {
+		result.filename = name;
+		mcc_parser_set_extra(2, scanner);
+	}
+
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_PARSER);
+	int error = yyparse(scanner, &result);
+	mcc_alloc_set_phase(phase);
+	if (error != 0) {
+		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+		if (!result.error_buffer) {
+			mcc_parser_lex_destroy(scanner);
+			return result;
+		}
+	}
+
+	mcc_parser_lex_destroy(scanner);
+
+	if (!(&result)->program) {
+		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
+	}
+	return result;
+}
+
+struct mcc_parser_result mcc_parse_string(const char *input_string, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input_string);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+
+	// The scanner keeps its own copy of the string
+	if (!mcc_parser__scan_string(input_string, scanner)) {
+		mcc_parser_lex_destroy(scanner);
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
+		};
+	}
+
+	return parse(scanner, entry_point, name);
+}
+
+struct mcc_parser_result mcc_parse_input(struct mcc_input *input, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+
+	// Scan the buffer in place, including its two terminating NUL bytes
+	if (!mcc_parser__scan_buffer(input->buffer, input->size + 2, scanner)) {
+		mcc_parser_lex_destroy(scanner);
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
+		};
+	}
+
+	return parse(scanner, entry_point, name);
+}
+
+struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+	mcc_parser_set_in(input, scanner);
+
+	return parse(scanner, entry_point, name);
+}
+
+void mcc_ast_delete_result(struct mcc_parser_result *result)
+{
+	assert(result);
+
+	enum mcc_parser_entry_point entry_point = result->entry_point;
+
+	switch (entry_point) {
+	case MCC_PARSER_ENTRY_POINT_EXPRESSION:;
+		mcc_ast_delete(result->expression);
+		break;
+	case MCC_PARSER_ENTRY_POINT_STATEMENT:;
+		mcc_ast_delete(result->statement);
+		break;
+	case MCC_PARSER_ENTRY_POINT_DECLARATION:;
+		mcc_ast_delete(result->declaration);
+		break;
+	case MCC_PARSER_ENTRY_POINT_ASSIGNMENT:;
+		mcc_ast_delete(result->assignment);
+		break;
+	case MCC_PARSER_ENTRY_POINT_PROGRAM:
+		mcc_ast_delete(result->program);
+		break;
+	case MCC_PARSER_ENTRY_POINT_FUNCTION_DEFINITION:
+		mcc_ast_delete(result->function_definition);
+		break;
+	case MCC_PARSER_ENTRY_POINT_PARAMETERS:
+		mcc_ast_delete(result->parameters);
+		break;
+	case MCC_PARSER_ENTRY_POINT_ARGUMENTS:
+		mcc_ast_delete(result->arguments);
+		break;
+	case MCC_PARSER_ENTRY_POINT_COMPOUND_STATEMENT:
+		mcc_ast_delete(result->compound_statement);
+		break;
+	}
+}
+
+// Writes error message to a variable "buffer" that is allocated on the heap
+void mcc_parser_error(struct MCC_PARSER_LTYPE *yylloc,
+                      yyscan_t *scanner,
+                      struct mcc_parser_result *result,
+                      const char *msg)
+{
+	int size = strlen(msg) + length_of_int(yylloc->first_line) + length_of_int(yylloc->first_column) + strlen(result->filename) + 6;
+	result->error_buffer = (char *)mcc_malloc(MCC_ALLOC_STRING, sizeof(char) * size);
+	if (!result->error_buffer)
+		return;
+	snprintf(result->error_buffer, size, "%s:%d:%d: %s\n", result->filename, yylloc->first_line, yylloc->first_column, msg);
+	// scanner needed to get meaningfull msg
+	UNUSED(scanner);
+}
+
@@ -0,0 +1,196 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_MCC_PARSER_PARSER_TAB_H_INCLUDED
+# define YY_MCC_PARSER_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef MCC_PARSER_DEBUG
+# if defined YYDEBUG
+#if YYDEBUG
+#   define MCC_PARSER_DEBUG 1
+#  else
+#   define MCC_PARSER_DEBUG 0
+#  endif
+# else /* ! defined YYDEBUG */
+#  define MCC_PARSER_DEBUG 1
+# endif /* ! defined YYDEBUG */
+#endif  /* ! defined MCC_PARSER_DEBUG */
+#if MCC_PARSER_DEBUG
+extern int mcc_parser_debug;
+#endif
+/* "%code requires" blocks.  */
+#line 12 "/tmp/wt/src/parser.y"
+
+#include "mcc/parser.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* next 30 lines taken from p. 202 http://web.iitd.ac.in/~sumeet/flex__bison.pdf */
+
+typedef struct MCC_PARSER_LTYPE {
+	int first_line;
+	int first_column;
+	int last_line;
+	int last_column;
+} MCC_PARSER_LTYPE;
+
+# define MCC_PARSER_LTYPE_IS_DECLARED 1 /* alert the parser that we have our own definition */
+# define YYLLOC_DEFAULT(Cur, Rhs, N)                      \
+do                                                        \
+  if (N)                                                  \
+    {                                                     \
+      (Cur).first_line   = YYRHSLOC(Rhs, 1).first_line;   \
+      (Cur).first_column = YYRHSLOC(Rhs, 1).first_column; \
+      (Cur).last_line    = YYRHSLOC(Rhs, N).last_line;    \
+      (Cur).last_column  = YYRHSLOC(Rhs, N).last_column;  \
+    }                                                     \
+  else                                                    \
+    {                                                     \
+      (Cur).first_line   = (Cur).last_line   =            \
+        YYRHSLOC(Rhs, 0).last_line;                       \
+      (Cur).first_column = (Cur).last_column =            \
+        YYRHSLOC(Rhs, 0).last_column;                     \
+    }                                                     \
+while (0)
+
+#line 92 "parser.tab.h"
+
+/* Token kinds.  */
+#ifndef MCC_PARSER_TOKENTYPE
+# define MCC_PARSER_TOKENTYPE
+  enum mcc_parser_tokentype
+  {
+    TK_MCC_PARSER_EMPTY = -2,
+    TK_END = 0,                    /* "EOF"  */
+    TK_MCC_PARSER_error = 256,     /* error  */
+    TK_MCC_PARSER_UNDEF = 257,     /* "invalid token"  */
+    TK_INT_LITERAL = 258,          /* "integer literal"  */
+    TK_FLOAT_LITERAL = 259,        /* "float literal"  */
+    TK_BOOL_LITERAL = 260,         /* "bool literal"  */
+    TK_STRING_LITERAL = 261,       /* "string literal"  */
+    TK_IDENTIFIER = 262,           /* "identifier"  */
+    TK_TYPE = 263,                 /* "type"  */
+    TK_VOID = 264,                 /* "void"  */
+    TK_LPARENTH = 265,             /* "("  */
+    TK_RPARENTH = 266,             /* ")"  */
+    TK_CURL_OPEN = 267,            /* "{"  */
+    TK_CURL_CLOSE = 268,           /* "}"  */
+    TK_PLUS = 269,                 /* "+"  */
+    TK_MINUS = 270,                /* "-"  */
+    TK_ASTER = 271,                /* "*"  */
+    TK_SLASH = 272,                /* "/"  */
+    TK_SQUARE_OPEN = 273,          /* "["  */
+    TK_SQUARE_CLOSE = 274,         /* "]"  */
+    TK_EXKLA = 275,                /* "!"  */
+    TK_EQ = 276,                   /* "="  */
+    TK_LT_SIGN = 277,              /* "<"  */
+    TK_GT_SIGN = 278,              /* ">"  */
+    TK_LT_EQ_SIGN = 279,           /* "<="  */
+    TK_GT_EQ_SIGN = 280,           /* ">="  */
+    TK_ANDAND = 281,               /* "&&"  */
+    TK_OROR = 282,                 /* "||"  */
+    TK_EQEQ = 283,                 /* "=="  */
+    TK_EXKLA_EQ = 284,             /* "!="  */
+    TK_IF = 285,                   /* "if"  */
+    TK_ELSE = 286,                 /* "else"  */
+    TK_WHILE = 287,                /* "while"  */
+    TK_RETURN = 288,               /* "return"  */
+    TK_SEMICOLON = 289,            /* ";"  */
+    TK_COMMA = 290,                /* ","  */
+    TK_START_UNIT = 1,             /* START_UNIT  */
+    TK_START_PROG = 2,             /* START_PROG  */
+    TK_NOT_ELSE = 291,             /* NOT_ELSE  */
+    TK_EX_MINUS = 292,             /* EX_MINUS  */
+    TK_EX_EXKL = 293               /* EX_EXKL  */
+  };
+  typedef enum mcc_parser_tokentype mcc_parser_token_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined MCC_PARSER_STYPE && ! defined MCC_PARSER_STYPE_IS_DECLARED
+union MCC_PARSER_STYPE
+{
+  bool TK_BOOL_LITERAL;                    /* "bool literal"  */
+  char* TK_STRING_LITERAL;                 /* "string literal"  */
+  char* TK_IDENTIFIER;                     /* "identifier"  */
+  double TK_FLOAT_LITERAL;                 /* "float literal"  */
+  enum mcc_ast_types TK_TYPE;              /* "type"  */
+  long TK_INT_LITERAL;                     /* "integer literal"  */
+  struct mcc_ast_arguments * TK_arguments; /* arguments  */
+  struct mcc_ast_assignment * TK_assignment; /* assignment  */
+  struct mcc_ast_compound_statement * TK_statements; /* statements  */
+  struct mcc_ast_compound_statement * TK_compound_statement; /* compound_statement  */
+  struct mcc_ast_declaration * TK_declaration; /* declaration  */
+  struct mcc_ast_expression * TK_expression; /* expression  */
+  struct mcc_ast_function_definition * TK_function_def; /* function_def  */
+  struct mcc_ast_identifier * TK_identifier; /* identifier  */
+  struct mcc_ast_literal * TK_literal;     /* literal  */
+  struct mcc_ast_parameters * TK_parameters; /* parameters  */
+  struct mcc_ast_program * TK_function_defs; /* function_defs  */
+  struct mcc_ast_program * TK_program;     /* program  */
+  struct mcc_ast_statement * TK_statement; /* statement  */
+
+#line 169 "parser.tab.h"
+
+};
+typedef union MCC_PARSER_STYPE MCC_PARSER_STYPE;
+# define MCC_PARSER_STYPE_IS_TRIVIAL 1
+# define MCC_PARSER_STYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+#if ! defined MCC_PARSER_LTYPE && ! defined MCC_PARSER_LTYPE_IS_DECLARED
+typedef struct MCC_PARSER_LTYPE MCC_PARSER_LTYPE;
+struct MCC_PARSER_LTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define MCC_PARSER_LTYPE_IS_DECLARED 1
+# define MCC_PARSER_LTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+int mcc_parser_parse (void *scanner, struct mcc_parser_result* result);
+
+
+#endif /* !YY_MCC_PARSER_PARSER_TAB_H_INCLUDED  */
@@ -0,0 +1,67 @@
+#include "parser.tab.h"
+#include "scanner.h"
+#ifndef BASELINE
+#include "mcc/alloc.h"
+#include "mcc/intern.h"
+#else
+#define mcc_strdup(k,x) strdup(x)
+#define mcc_intern(x) strdup(x)
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#define YYSTYPE MCC_PARSER_STYPE
+#define YYLTYPE MCC_PARSER_LTYPE
+struct sc { int extra; char *buf; int owned; size_t pos, len; int comment; };
+struct yy_buffer_state { int dummy; };
+static struct yy_buffer_state dummy_bs;
+int mcc_parser_lex_init(yyscan_t *s){ *s = calloc(1,sizeof(struct sc)); return *s?0:1; }
+int mcc_parser_lex_destroy(yyscan_t s){ struct sc*c=s; if(c->owned) free(c->buf); free(c); return 0; }
+void mcc_parser_set_extra(int e, yyscan_t s){ ((struct sc*)s)->extra=e; }
+YY_BUFFER_STATE mcc_parser__scan_string(const char *str, yyscan_t s){ struct sc*c=s; c->buf=strdup(str); if(!c->buf) return NULL; c->owned=1; c->len=strlen(str); return &dummy_bs; }
+YY_BUFFER_STATE mcc_parser__scan_buffer(char *base, size_t size, yyscan_t s){ struct sc*c=s; if(size<2||base[size-2]||base[size-1]) return NULL; c->buf=base; c->len=size-2; return &dummy_bs; }
+void mcc_parser_set_in(FILE *in, yyscan_t s){ struct sc*c=s; size_t cap=4096,n=0; char*b=malloc(cap); size_t r; while((r=fread(b+n,1,cap-n,in))>0){n+=r; if(n==cap){cap*=2;b=realloc(b,cap);}} b=realloc(b,n+1); b[n]=0; c->buf=b; c->owned=1; c->len=n; }
+static int idch(int ch){ return isalnum(ch)||ch=='_'; }
+int mcc_parser_lex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t s)
+{
+	struct sc *c = s;
+	if (c->extra) { int t=c->extra; c->extra=0; yylloc->last_line=1; yylloc->last_column=1; return t; }
+	for (;;) {
+		if (c->pos >= c->len) return TK_END;
+		char *p = c->buf + c->pos; size_t L;
+#define ACT(n) do{ L=(n); yylloc->first_column=yylloc->last_column; yylloc->last_column+=(int)L; yylloc->first_line=yylloc->last_line; c->pos+=L; }while(0)
+		if (c->comment) {
+			if (p[0]=='*'&&p[1]=='/') { ACT(2); c->comment=0; continue; }
+			ACT(1); if (p[0]=='\n'){ yylloc->last_line++; yylloc->last_column=1; } continue;
+		}
+		if (isdigit((unsigned char)p[0])) {
+			size_t i=0; while(isdigit((unsigned char)p[i])) i++;
+			if (p[i]=='.' && isdigit((unsigned char)p[i+1])) { size_t j=i+1; while(isdigit((unsigned char)p[j])) j++; char t=p[j]; ACT(j); char sv=p[j]; (void)t; char *tmp=strndup(p,j); yylval->TK_FLOAT_LITERAL=atof(tmp); free(tmp); (void)sv; return TK_FLOAT_LITERAL; }
+			char *tmp=strndup(p,i); ACT(i); yylval->TK_INT_LITERAL=atol(tmp); free(tmp); return TK_INT_LITERAL;
+		}
+		if (p[0]=='"') { char *q=strchr(p+1,'"'); if(q && (size_t)(q-c->buf)<c->len){ size_t n=q-p+1; char *tmp=strndup(p,n); ACT(n); yylval->TK_STRING_LITERAL=mcc_strdup(MCC_ALLOC_STRING,tmp); free(tmp); for(size_t i=0;i<n;i++) yylloc->last_line+=(p[i]=='\n'); return TK_STRING_LITERAL; } }
+		if (isalpha((unsigned char)p[0])||p[0]=='_') {
+			size_t i=0; while(idch((unsigned char)p[i])) i++;
+			char *w=strndup(p,i); ACT(i); int r=-1;
+#define KW(s,tok) if(!strcmp(w,s)) r=tok;
+			if(!strcmp(w,"true")){yylval->TK_BOOL_LITERAL=true;r=TK_BOOL_LITERAL;}
+			else if(!strcmp(w,"false")){yylval->TK_BOOL_LITERAL=false;r=TK_BOOL_LITERAL;}
+			else if(!strcmp(w,"int")){yylval->TK_TYPE=INT;r=TK_TYPE;}
+			else if(!strcmp(w,"float")){yylval->TK_TYPE=FLOAT;r=TK_TYPE;}
+			else if(!strcmp(w,"bool")){yylval->TK_TYPE=BOOL;r=TK_TYPE;}
+			else if(!strcmp(w,"string")){yylval->TK_TYPE=STRING;r=TK_TYPE;}
+			else { KW("void",TK_VOID) KW("if",TK_IF) KW("else",TK_ELSE) KW("while",TK_WHILE) KW("return",TK_RETURN) }
+			if (r<0) { yylval->TK_IDENTIFIER=mcc_intern(w); r=TK_IDENTIFIER; }
+			free(w); return r;
+		}
+		if (p[0]=='/'&&p[1]=='*') { ACT(2); c->comment=1; continue; }
+#define T2(a,b,tok) if(p[0]==a&&p[1]==b){ACT(2);return tok;}
+		T2('<','=',TK_LT_EQ_SIGN) T2('>','=',TK_GT_EQ_SIGN) T2('&','&',TK_ANDAND) T2('|','|',TK_OROR) T2('=','=',TK_EQEQ) T2('!','=',TK_EXKLA_EQ)
+#define T1(a,tok) if(p[0]==a){ACT(1);return tok;}
+		T1('+',TK_PLUS) T1('-',TK_MINUS) T1('*',TK_ASTER) T1('/',TK_SLASH) T1('!',TK_EXKLA) T1('=',TK_EQ) T1('<',TK_LT_SIGN) T1('>',TK_GT_SIGN)
+		T1('[',TK_SQUARE_OPEN) T1(']',TK_SQUARE_CLOSE) T1('(',TK_LPARENTH) T1(')',TK_RPARENTH) T1('{',TK_CURL_OPEN) T1('}',TK_CURL_CLOSE) T1(';',TK_SEMICOLON) T1(',',TK_COMMA)
+		if (p[0]==' '||p[0]=='\t'||p[0]=='\r') { size_t i=0; while(p[i]==' '||p[i]=='\t'||p[i]=='\r') i++; ACT(i); continue; }
+		if (p[0]=='\n') { ACT(1); yylloc->last_line++; yylloc->last_column=1; continue; }
+		ACT(1); fprintf(stderr, "invalid character '%c'. I'll ignore it and continue.\n", p[0]);
+	}
+}
@@ -0,0 +1,12 @@
+#ifndef FAKE_SCANNER_H
+#define FAKE_SCANNER_H
+#include <stdio.h>
+typedef void *yyscan_t;
+typedef struct yy_buffer_state *YY_BUFFER_STATE;
+int mcc_parser_lex_init(yyscan_t *s);
+int mcc_parser_lex_destroy(yyscan_t s);
+void mcc_parser_set_extra(int e, yyscan_t s);
+YY_BUFFER_STATE mcc_parser__scan_string(const char *str, yyscan_t s);
+YY_BUFFER_STATE mcc_parser__scan_buffer(char *base, size_t size, yyscan_t s);
+void mcc_parser_set_in(FILE *in, yyscan_t s);
+#endif
@@ -0,0 +1,329 @@
+#define _GNU_SOURCE
+
+#include "mcc/alloc.h"
+
+#include <assert.h>
+#include <malloc.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct counters {
+	atomic_long calls;
+	atomic_long bytes;
+	atomic_long live;
+	atomic_long peak;
+};
+
+static atomic_bool is_enabled = false;
+
+// Set by the first allocation that is not counted, blocks allocated before stats were enabled have no trailer
+static atomic_bool has_allocated = false;
+
+static struct counters kinds[MCC_ALLOC_KIND_COUNT];
+static struct counters phases[MCC_ALLOC_PHASE_COUNT];
+static struct counters total;
+
+// High-water mark of the total since the last call of mcc_alloc_interval_peak
+static atomic_long interval_peak;
+
+static _Thread_local enum mcc_alloc_phase current_phase = MCC_ALLOC_PHASE_OTHER;
+
+// Threads that are in each phase, and the total of live bytes when the phase was entered by the first of them
+static atomic_int phase_threads[MCC_ALLOC_PHASE_COUNT];
+static atomic_long phase_bases[MCC_ALLOC_PHASE_COUNT];
+
+// While counting, every block is allocated one byte larger and its last usable byte holds the phase it was allocated
+// in, so that freeing it lowers the live bytes of that phase instead of the current one. The block itself starts where
+// malloc placed it, hence plain free works on it as well.
+typedef unsigned char trailer;
+
+static const char *const kind_names[] = {
+    [MCC_ALLOC_OTHER] = "other",
+    [MCC_ALLOC_AST_NODE] = "AST node",
+    [MCC_ALLOC_SYMBOL_TABLE] = "symbol table",
+    [MCC_ALLOC_STRING] = "string",
+    [MCC_ALLOC_IR_ROW] = "IR row",
+    [MCC_ALLOC_IR_ARG] = "IR arg",
+    [MCC_ALLOC_CFG] = "basic block",
+    [MCC_ALLOC_ANNOTATED_IR] = "annotated IR",
+    [MCC_ALLOC_ASM] = "asm section",
+    [MCC_ALLOC_ASM_LINE] = "asm line",
+    [MCC_ALLOC_ASM_OPERAND] = "asm operand",
+    [MCC_ALLOC_HASH_MAP] = "hash map",
+    [MCC_ALLOC_ARENA] = "arena",
+};
+
+static const char *const phase_names[] = {
+    [MCC_ALLOC_PHASE_OTHER] = "other",
+    [MCC_ALLOC_PHASE_PARSER] = "parsing",
+    [MCC_ALLOC_PHASE_SYMBOL_TABLE] = "symbol table",
+    [MCC_ALLOC_PHASE_SEMANTIC_CHECKS] = "semantic checks",
+    [MCC_ALLOC_PHASE_IR] = "IR generation",
+    [MCC_ALLOC_PHASE_CFG] = "CFG generation",
+    [MCC_ALLOC_PHASE_STACK_LAYOUT] = "stack layout",
+    [MCC_ALLOC_PHASE_ASM] = "asm generation",
+};
+
+//---------------------------------------------------------------------------------------- Counting
+
+static void raise_peak(atomic_long *peak, long live)
+{
+	long old_peak = atomic_load_explicit(peak, memory_order_relaxed);
+	while (live > old_peak && !atomic_compare_exchange_weak_explicit(peak, &old_peak, live, memory_order_relaxed,
+	                                                                 memory_order_relaxed)) {
+	}
+}
+
+static void count_call(enum mcc_alloc_kind kind, size_t size)
+{
+	struct counters *counters[] = {&kinds[kind], &phases[current_phase], &total};
+	for (unsigned i = 0; i < sizeof(counters) / sizeof(*counters); i++) {
+		atomic_fetch_add_explicit(&counters[i]->calls, 1, memory_order_relaxed);
+		atomic_fetch_add_explicit(&counters[i]->bytes, size, memory_order_relaxed);
+	}
+}
+
+// The peak of a phase is taken over the total of live bytes when it was entered, i.e. it only includes the memory
+// allocated during the phase
+static void count_live(enum mcc_alloc_kind kind, enum mcc_alloc_phase allocating_phase, long bytes)
+{
+	struct counters *phase = &phases[allocating_phase];
+	atomic_fetch_add_explicit(&phase->live, bytes, memory_order_relaxed);
+	long kind_live = atomic_fetch_add_explicit(&kinds[kind].live, bytes, memory_order_relaxed) + bytes;
+	long total_live = atomic_fetch_add_explicit(&total.live, bytes, memory_order_relaxed) + bytes;
+	if (bytes > 0) {
+		long base = atomic_load_explicit(&phase_bases[allocating_phase], memory_order_relaxed);
+		raise_peak(&kinds[kind].peak, kind_live);
+		raise_peak(&phase->peak, total_live - base);
+		raise_peak(&total.peak, total_live);
+		raise_peak(&interval_peak, total_live);
+	}
+}
+
+static bool counting(void)
+{
+	return atomic_load_explicit(&is_enabled, memory_order_relaxed);
+}
+
+static void note_uncounted(void)
+{
+	if (!atomic_load_explicit(&has_allocated, memory_order_relaxed))
+		atomic_store_explicit(&has_allocated, true, memory_order_relaxed);
+}
+
+// Live memory is measured in usable bytes, since only those are known when the memory is freed
+static void *count_block(void *ptr, enum mcc_alloc_kind kind, size_t size)
+{
+	size_t usable = malloc_usable_size(ptr);
+	((trailer *)ptr)[usable - sizeof(trailer)] = current_phase;
+	count_call(kind, size);
+	count_live(kind, current_phase, usable);
+	return ptr;
+}
+
+static void count_freed(enum mcc_alloc_kind kind, void *ptr)
+{
+	size_t usable = malloc_usable_size(ptr);
+	count_live(kind, ((trailer *)ptr)[usable - sizeof(trailer)], -(long)usable);
+}
+
+//---------------------------------------------------------------------------------------- Allocation
+
+void *mcc_malloc(enum mcc_alloc_kind kind, size_t size)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	if (!counting()) {
+		note_uncounted();
+		return malloc(size);
+	}
+	if (size > SIZE_MAX - sizeof(trailer))
+		return NULL;
+	void *ptr = malloc(size + sizeof(trailer));
+	if (!ptr)
+		return NULL;
+	return count_block(ptr, kind, size);
+}
+
+void *mcc_calloc(enum mcc_alloc_kind kind, size_t count, size_t size)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	if (!counting()) {
+		note_uncounted();
+		return calloc(count, size);
+	}
+	if (size != 0 && count > (SIZE_MAX - sizeof(trailer)) / size)
+		return NULL;
+	void *ptr = calloc(1, count * size + sizeof(trailer));
+	if (!ptr)
+		return NULL;
+	return count_block(ptr, kind, count * size);
+}
+
+void *mcc_realloc(enum mcc_alloc_kind kind, void *ptr, size_t size)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	if (!counting()) {
+		note_uncounted();
+		return realloc(ptr, size);
+	}
+	if (!ptr)
+		return mcc_malloc(kind, size);
+	if (size > SIZE_MAX - sizeof(trailer))
+		return NULL;
+
+	// The whole block moves to the current phase
+	size_t old_usable = malloc_usable_size(ptr);
+	enum mcc_alloc_phase old_phase = ((trailer *)ptr)[old_usable - sizeof(trailer)];
+	void *new_ptr = realloc(ptr, size + sizeof(trailer));
+	if (!new_ptr)
+		return NULL;
+	count_live(kind, old_phase, -(long)old_usable);
+	return count_block(new_ptr, kind, size);
+}
+
+char *mcc_strdup(enum mcc_alloc_kind kind, const char *string)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+	assert(string);
+
+	size_t size = strlen(string) + 1;
+	char *copy = mcc_malloc(kind, size);
+	if (copy)
+		memcpy(copy, string, size);
+	return copy;
+}
+
+void mcc_free(enum mcc_alloc_kind kind, void *ptr)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	if (ptr && counting())
+		count_freed(kind, ptr);
+	free(ptr);
+}
+
+bool mcc_alloc_count_in_arena(enum mcc_alloc_kind kind, size_t size)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	if (!counting())
+		return false;
+	count_call(kind, size);
+	// The bytes are already live as part of a chunk
+	long kind_live = atomic_fetch_add_explicit(&kinds[kind].live, size, memory_order_relaxed) + size;
+	atomic_fetch_sub_explicit(&kinds[MCC_ALLOC_ARENA].live, size, memory_order_relaxed);
+	raise_peak(&kinds[kind].peak, kind_live);
+	return true;
+}
+
+void mcc_alloc_count_out_of_arena(enum mcc_alloc_kind kind, size_t size)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+
+	atomic_fetch_sub_explicit(&kinds[kind].live, size, memory_order_relaxed);
+	atomic_fetch_add_explicit(&kinds[MCC_ALLOC_ARENA].live, size, memory_order_relaxed);
+}
+
+//---------------------------------------------------------------------------------------- Statistics
+
+bool mcc_alloc_enable_stats(void)
+{
+	if (atomic_load(&is_enabled))
+		return true;
+	if (atomic_load(&has_allocated))
+		return false;
+	atomic_store(&is_enabled, true);
+	return true;
+}
+
+enum mcc_alloc_phase mcc_alloc_set_phase(enum mcc_alloc_phase phase)
+{
+	assert(phase < MCC_ALLOC_PHASE_COUNT);
+
+	// The new phase is entered before the previous one is left, so entering the phase a thread is already in keeps the
+	// base. Memory outside of the stages is measured from zero.
+	enum mcc_alloc_phase previous = current_phase;
+	current_phase = phase;
+	if (phase != MCC_ALLOC_PHASE_OTHER && atomic_fetch_add(&phase_threads[phase], 1) == 0)
+		atomic_store(&phase_bases[phase], atomic_load_explicit(&total.live, memory_order_relaxed));
+	if (previous != MCC_ALLOC_PHASE_OTHER)
+		atomic_fetch_sub(&phase_threads[previous], 1);
+	return previous;
+}
+
+enum mcc_alloc_phase mcc_alloc_get_phase(void)
+{
+	return current_phase;
+}
+
+static struct mcc_alloc_counters load_counters(struct counters *counters)
+{
+	return (struct mcc_alloc_counters){
+	    .calls = atomic_load(&counters->calls),
+	    .bytes = atomic_load(&counters->bytes),
+	    .live = atomic_load(&counters->live),
+	    .peak = atomic_load(&counters->peak),
+	};
+}
+
+struct mcc_alloc_counters mcc_alloc_kind_counters(enum mcc_alloc_kind kind)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+	return load_counters(&kinds[kind]);
+}
+
+struct mcc_alloc_counters mcc_alloc_phase_counters(enum mcc_alloc_phase phase)
+{
+	assert(phase < MCC_ALLOC_PHASE_COUNT);
+	return load_counters(&phases[phase]);
+}
+
+struct mcc_alloc_counters mcc_alloc_total_counters(void)
+{
+	return load_counters(&total);
+}
+
+long mcc_alloc_interval_peak(void)
+{
+	return atomic_exchange(&interval_peak, atomic_load(&total.live));
+}
+
+const char *mcc_alloc_kind_name(enum mcc_alloc_kind kind)
+{
+	assert(kind < MCC_ALLOC_KIND_COUNT);
+	return kind_names[kind];
+}
+
+const char *mcc_alloc_phase_name(enum mcc_alloc_phase phase)
+{
+	assert(phase < MCC_ALLOC_PHASE_COUNT);
+	return phase_names[phase];
+}
+
+static void print_counters(FILE *out, const char *name, struct mcc_alloc_counters counters)
+{
+	fprintf(out, "%-20s %12ld %14ld %14ld %14ld\n", name, counters.calls, counters.bytes, counters.live,
+	        counters.peak);
+}
+
+void mcc_alloc_print_stats(FILE *out)
+{
+	assert(out);
+
+	fprintf(out, "%-20s %12s %14s %14s %14s\n", "phase", "calls", "bytes", "live bytes", "peak bytes");
+	for (int i = 0; i < MCC_ALLOC_PHASE_COUNT; i++) {
+		print_counters(out, phase_names[i], mcc_alloc_phase_counters(i));
+	}
+	fprintf(out, "\n%-20s %12s %14s %14s %14s\n", "kind", "calls", "bytes", "live bytes", "peak bytes");
+	for (int i = 0; i < MCC_ALLOC_KIND_COUNT; i++) {
+		print_counters(out, kind_names[i], mcc_alloc_kind_counters(i));
+	}
+	print_counters(out, "total", mcc_alloc_total_counters());
+}
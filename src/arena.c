@@ -0,0 +1,172 @@
+#include "mcc/arena.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_SIZE (64 * 1024)
+#define ALIGNMENT alignof(max_align_t)
+
+struct mcc_arena_chunk {
+	struct mcc_arena_chunk *prev;
+	size_t size;
+	size_t used;
+	alignas(max_align_t) unsigned char memory[];
+};
+
+struct mcc_arena {
+	// Chunk that is currently bump-allocated from, older chunks are linked through prev
+	struct mcc_arena_chunk *chunk;
+	// Adopted arenas, linked through next_adopted and released together with this one
+	struct mcc_arena *adopted;
+	struct mcc_arena *next_adopted;
+	// Bytes of the objects that are counted for their own kind instead of the arena, see mcc_alloc_count_in_arena
+	size_t counted[MCC_ALLOC_KIND_COUNT];
+};
+
+static _Thread_local struct mcc_arena *current_arena = NULL;
+
+// --------------------------------------------------------------------------------------- Arena
+
+static struct mcc_arena_chunk *new_chunk(size_t size, struct mcc_arena_chunk *prev)
+{
+	struct mcc_arena_chunk *chunk = mcc_malloc(MCC_ALLOC_ARENA, sizeof(*chunk) + size);
+	if (!chunk)
+		return NULL;
+	chunk->prev = prev;
+	chunk->size = size;
+	chunk->used = 0;
+	return chunk;
+}
+
+struct mcc_arena *mcc_arena_new(void)
+{
+	struct mcc_arena *arena = mcc_malloc(MCC_ALLOC_ARENA, sizeof(*arena));
+	if (!arena)
+		return NULL;
+	arena->chunk = new_chunk(CHUNK_SIZE, NULL);
+	if (!arena->chunk) {
+		mcc_free(MCC_ALLOC_ARENA, arena);
+		return NULL;
+	}
+	arena->adopted = NULL;
+	arena->next_adopted = NULL;
+	memset(arena->counted, 0, sizeof(arena->counted));
+	return arena;
+}
+
+void mcc_arena_delete(struct mcc_arena *arena)
+{
+	if (!arena)
+		return;
+	if (current_arena == arena)
+		current_arena = NULL;
+
+	struct mcc_arena *adopted = arena->adopted;
+	while (adopted) {
+		struct mcc_arena *next = adopted->next_adopted;
+		mcc_arena_delete(adopted);
+		adopted = next;
+	}
+
+	for (int kind = 0; kind < MCC_ALLOC_KIND_COUNT; kind++) {
+		if (arena->counted[kind])
+			mcc_alloc_count_out_of_arena(kind, arena->counted[kind]);
+	}
+	struct mcc_arena_chunk *chunk = arena->chunk;
+	while (chunk) {
+		struct mcc_arena_chunk *prev = chunk->prev;
+		mcc_free(MCC_ALLOC_ARENA, chunk);
+		chunk = prev;
+	}
+	mcc_free(MCC_ALLOC_ARENA, arena);
+}
+
+void *mcc_arena_alloc(struct mcc_arena *arena, size_t size)
+{
+	assert(arena);
+
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (size == 0)
+		size = ALIGNMENT;
+
+	struct mcc_arena_chunk *chunk = arena->chunk;
+	if (chunk->size - chunk->used < size) {
+		chunk = new_chunk(size > CHUNK_SIZE ? size : CHUNK_SIZE, chunk);
+		if (!chunk)
+			return NULL;
+		arena->chunk = chunk;
+	}
+
+	void *ptr = chunk->memory + chunk->used;
+	chunk->used += size;
+	return ptr;
+}
+
+void mcc_arena_adopt(struct mcc_arena *arena, struct mcc_arena *child)
+{
+	assert(arena);
+	assert(child);
+	assert(arena != child);
+
+	child->next_adopted = arena->adopted;
+	arena->adopted = child;
+}
+
+char *mcc_arena_alloc_string(struct mcc_arena *arena, const char *string)
+{
+	assert(string);
+
+	size_t size = strlen(string) + 1;
+	char *copy = mcc_arena_alloc(arena, size);
+	if (!copy)
+		return NULL;
+	memcpy(copy, string, size);
+	return copy;
+}
+
+// --------------------------------------------------------------------------------------- Current arena
+
+void mcc_arena_set_current(struct mcc_arena *arena)
+{
+	current_arena = arena;
+}
+
+struct mcc_arena *mcc_arena_get_current(void)
+{
+	return current_arena;
+}
+
+static void count_object(enum mcc_alloc_kind kind, size_t size)
+{
+	if (mcc_alloc_count_in_arena(kind, size))
+		current_arena->counted[kind] += size;
+}
+
+void *mcc_arena_malloc(enum mcc_alloc_kind kind, size_t size)
+{
+	if (!current_arena)
+		return mcc_malloc(kind, size);
+	void *ptr = mcc_arena_alloc(current_arena, size);
+	if (ptr)
+		count_object(kind, size);
+	return ptr;
+}
+
+char *mcc_arena_strdup(enum mcc_alloc_kind kind, const char *string)
+{
+	if (!current_arena)
+		return mcc_strdup(kind, string);
+	char *copy = mcc_arena_alloc_string(current_arena, string);
+	if (copy)
+		count_object(kind, strlen(string) + 1);
+	return copy;
+}
+
+void mcc_arena_free(struct mcc_arena *arena, enum mcc_alloc_kind kind, void *ptr)
+{
+	if (arena)
+		return;
+	mcc_free(kind, ptr);
+}
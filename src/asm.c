@@ -1,94 +1,110 @@
 #include "mcc/asm.h"
 
 #include <assert.h>
-#include <math.h>
+#include <inttypes.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
 #include "mcc/ir.h"
 #include "mcc/stack_size.h"
+#include "mcc/thread_pool.h"
+#include "utils/hash_map.h"
 #include "utils/length_of_int.h"
 
-#define EPSILON 1e-06;
+//---------------------------------------------------------------------------------------- Operand table
 
-//---------------------------------------------------------------------------------------- Implementation
+// Resolves stack offsets of operands of the function that is currently generated.
+// Identifiers and local arrays are looked up in the frame layout of the function, rows in a map built once per
+// function.
+struct mcc_asm_operand_table {
+	// Func label of the function, holds the frame layout
+	struct mcc_annotated_ir *function;
+	// IR row -> annotated line
+	struct mcc_hash_map *rows;
+};
 
-static bool arg_is_local_array(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
+static void delete_operand_table(struct mcc_asm_operand_table *table)
 {
-	if (arg->type != MCC_IR_TYPE_IDENTIFIER) {
-		return false;
+	if (!table)
+		return;
+	mcc_hash_map_delete(table->rows);
+	mcc_free(MCC_ALLOC_OTHER, table);
+}
+
+static struct mcc_asm_operand_table *new_operand_table(struct mcc_annotated_ir *function)
+{
+	assert(function);
+	assert(function->row->instr == MCC_IR_INSTR_FUNC_LABEL);
+
+	struct mcc_asm_operand_table *table = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*table));
+	if (!table)
+		return NULL;
+	table->function = function;
+	table->rows = mcc_hash_map_new(MCC_HASH_MAP_KEY_POINTER);
+	if (!table->rows) {
+		mcc_free(MCC_ALLOC_OTHER, table);
+		return NULL;
 	}
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
+
+	struct mcc_annotated_ir *an_ir = function->next;
 	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0)
-				return true;
+		if (mcc_hash_map_insert(table->rows, an_ir->row, an_ir) != 0) {
+			delete_operand_table(table);
+			return NULL;
 		}
 		an_ir = an_ir->next;
 	}
-	return false;
+	return table;
 }
 
-static int get_identifier_offset(struct mcc_annotated_ir *first, char *ident)
+static bool arg_is_local_array(struct mcc_asm_operand_table *table, struct mcc_ir_arg *arg)
 {
-	assert(first);
-	assert(ident);
+	if (arg->type != MCC_IR_TYPE_IDENTIFIER) {
+		return false;
+	}
+	return mcc_get_array_declaration(table->function, arg->symbol) != NULL;
+}
 
-	first = mcc_get_function_label(first);
-	first = first->next;
+static int get_array_base_offset(struct mcc_asm_operand_table *table, unsigned symbol)
+{
+	struct mcc_annotated_ir *decl = mcc_get_array_declaration(table->function, symbol);
+	if (!decl)
+		return 0;
+	return decl->stack_position;
+}
 
-	while (first && first->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (first->row->instr == MCC_IR_INSTR_ASSIGN) {
-			// if ident is of form $tmp_xx only compare starting from position 1
-			if (strncmp(ident, "$tmp", 4) == 0) {
-				const char *tmp = &ident[1];
-				if (strcmp(first->row->arg1->ident, tmp) == 0) {
-					return first->stack_position;
-				}
-			}
-			if (strcmp(first->row->arg1->ident, ident) == 0) {
-				return first->stack_position;
-			}
-		}
-		first = first->next;
-	}
-	return 0;
+static int get_identifier_offset(struct mcc_asm_operand_table *table, unsigned symbol)
+{
+	assert(table);
+
+	struct mcc_annotated_ir *decl = mcc_get_variable_declaration(table->function, symbol);
+	if (!decl)
+		return 0;
+	return decl->stack_position;
 }
 
-static int get_row_offset(struct mcc_annotated_ir *an_ir, struct mcc_ir_row *row)
+static int get_row_offset(struct mcc_asm_operand_table *table, struct mcc_ir_row *row)
 {
-	assert(an_ir);
+	assert(table);
 	assert(row);
 
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
-
-	while (an_ir && an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row == row) {
-			return an_ir->stack_position;
-		}
-		an_ir = an_ir->next;
-	}
-	return 0;
+	struct mcc_annotated_ir *an_ir = mcc_hash_map_lookup(table->rows, row);
+	if (!an_ir)
+		return 0;
+	return an_ir->stack_position;
 }
 
-static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
+static int get_offset_of(struct mcc_asm_operand_table *table, struct mcc_ir_arg *arg)
 {
-	assert(an_ir);
+	assert(table);
 	assert(arg);
-	struct mcc_annotated_ir *first = an_ir;
-	struct mcc_annotated_ir *prev = first->prev;
-	while (prev) {
-		if (prev->row->instr == MCC_IR_INSTR_FUNC_LABEL) {
-			first = prev;
-			break;
-		}
-		prev = prev->prev;
-	}
-	if (arg_is_local_array(an_ir, arg))
-		return mcc_get_array_base_stack_loc(an_ir, arg);
+
+	if (arg_is_local_array(table, arg))
+		return get_array_base_offset(table, arg->symbol);
 
 	switch (arg->type) {
 	case MCC_IR_TYPE_LIT_INT:
@@ -99,11 +115,14 @@ static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
 	case MCC_IR_TYPE_FUNC_LABEL:
 		return 0;
 	case MCC_IR_TYPE_ARR_ELEM:
-		return mcc_get_array_element_stack_loc(an_ir, arg);
+		// Array index is not int literal -> computed during runtime
+		if (arg->index->type != MCC_IR_TYPE_LIT_INT)
+			return 0;
+		return get_array_base_offset(table, arg->symbol) + arg->index->lit_int * DWORD_SIZE;
 	case MCC_IR_TYPE_IDENTIFIER:
-		return get_identifier_offset(first, arg->ident);
+		return get_identifier_offset(table, arg->symbol);
 	case MCC_IR_TYPE_ROW:
-		return get_row_offset(first, arg->row);
+		return get_row_offset(table, arg->row);
 	default:
 		return 0;
 	}
@@ -114,7 +133,7 @@ static int get_offset_of(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg)
 struct mcc_asm *
 mcc_asm_new_asm(struct mcc_asm_data_section *data_section, struct mcc_asm_text_section *text, struct mcc_asm_data *data)
 {
-	struct mcc_asm *new = malloc(sizeof(*new));
+	struct mcc_asm *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -126,18 +145,27 @@ mcc_asm_new_asm(struct mcc_asm_data_section *data_section, struct mcc_asm_text_s
 
 struct mcc_asm_data_section *mcc_asm_new_data_section(struct mcc_asm_declaration *head, struct mcc_asm_data *data)
 {
-	struct mcc_asm_data_section *new = malloc(sizeof(*new));
+	struct mcc_asm_data_section *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
 	}
 	new->head = head;
+	new->strings = mcc_hash_map_new(MCC_HASH_MAP_KEY_STRING);
+	new->floats = mcc_hash_map_new(MCC_HASH_MAP_KEY_STRING);
+	if (!new->strings || !new->floats) {
+		mcc_hash_map_delete(new->strings);
+		mcc_hash_map_delete(new->floats);
+		mcc_free(MCC_ALLOC_ASM, new);
+		data->has_failed = true;
+		return NULL;
+	}
 	return new;
 }
 
 struct mcc_asm_text_section *mcc_asm_new_text_section(struct mcc_asm_function *function, struct mcc_asm_data *data)
 {
-	struct mcc_asm_text_section *new = malloc(sizeof(*new));
+	struct mcc_asm_text_section *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -153,12 +181,12 @@ struct mcc_asm_declaration *mcc_asm_new_float_declaration(char *identifier,
 {
 	if (data->has_failed || !identifier)
 		return NULL;
-	struct mcc_asm_declaration *new = malloc(sizeof(*new));
-	char *id_new = strdup(identifier);
+	struct mcc_asm_declaration *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
+	char *id_new = mcc_strdup(MCC_ALLOC_ASM, identifier);
 	if (!new || !id_new) {
 		data->has_failed = true;
-		free(new);
-		free(id_new);
+		mcc_free(MCC_ALLOC_ASM, new);
+		mcc_free(MCC_ALLOC_ASM, id_new);
 		return NULL;
 	}
 	new->identifier = id_new;
@@ -175,12 +203,12 @@ struct mcc_asm_declaration *mcc_asm_new_string_declaration(char *identifier,
 {
 	if (data->has_failed || !identifier)
 		return NULL;
-	struct mcc_asm_declaration *new = malloc(sizeof(*new));
-	char *id_new = strdup(identifier);
+	struct mcc_asm_declaration *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
+	char *id_new = mcc_strdup(MCC_ALLOC_ASM, identifier);
 	if (!new || !id_new) {
 		data->has_failed = true;
-		free(new);
-		free(id_new);
+		mcc_free(MCC_ALLOC_ASM, new);
+		mcc_free(MCC_ALLOC_ASM, id_new);
 		return NULL;
 	}
 	new->identifier = id_new;
@@ -195,11 +223,11 @@ mcc_asm_new_function(char *label, struct mcc_asm_line *head, struct mcc_asm_func
 {
 	if (data->has_failed)
 		return NULL;
-	struct mcc_asm_function *new = malloc(sizeof(*new));
-	char *lab_new = strdup(label);
+	struct mcc_asm_function *new = mcc_malloc(MCC_ALLOC_ASM, sizeof(*new));
+	char *lab_new = mcc_strdup(MCC_ALLOC_ASM, label);
 	if (!new || !lab_new) {
-		free(new);
-		free(lab_new);
+		mcc_free(MCC_ALLOC_ASM, new);
+		mcc_free(MCC_ALLOC_ASM, lab_new);
 		data->has_failed = true;
 		return NULL;
 	}
@@ -217,7 +245,7 @@ void mcc_asm_new_line(enum mcc_asm_opcode opcode,
 	if (data->has_failed) {
 		return;
 	}
-	struct mcc_asm_line *new = malloc(sizeof(*new));
+	struct mcc_asm_line *new = mcc_malloc(MCC_ALLOC_ASM_LINE, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		mcc_asm_delete_operand(first);
@@ -238,7 +266,7 @@ void mcc_asm_new_label(enum mcc_asm_opcode opcode, unsigned label, struct mcc_as
 	if (data->has_failed) {
 		return;
 	}
-	struct mcc_asm_line *new = malloc(sizeof(*new));
+	struct mcc_asm_line *new = mcc_malloc(MCC_ALLOC_ASM_LINE, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return;
@@ -253,11 +281,11 @@ void mcc_asm_new_label(enum mcc_asm_opcode opcode, unsigned label, struct mcc_as
 
 struct mcc_asm_operand *mcc_asm_new_function_operand(char *function_name, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
-	char *func_name_new = strdup(function_name);
+	struct mcc_asm_operand *new = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*new));
+	char *func_name_new = mcc_strdup(MCC_ALLOC_ASM_OPERAND, function_name);
 	if (!new || !func_name_new) {
-		free(new);
-		free(func_name_new);
+		mcc_free(MCC_ALLOC_ASM, new);
+		mcc_free(MCC_ALLOC_ASM_OPERAND, func_name_new);
 		data->has_failed = true;
 		return NULL;
 	}
@@ -269,7 +297,7 @@ struct mcc_asm_operand *mcc_asm_new_function_operand(char *function_name, struct
 
 struct mcc_asm_operand *mcc_asm_new_literal_operand(int literal, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -282,7 +310,7 @@ struct mcc_asm_operand *mcc_asm_new_literal_operand(int literal, struct mcc_asm_
 
 struct mcc_asm_operand *mcc_asm_new_register_operand(enum mcc_asm_register reg, int offset, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -299,7 +327,7 @@ struct mcc_asm_operand *mcc_asm_new_computed_offset_operand(int offset_initial,
                                                             int offset_size,
                                                             struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -314,7 +342,7 @@ struct mcc_asm_operand *mcc_asm_new_computed_offset_operand(int offset_initial,
 
 struct mcc_asm_operand *mcc_asm_new_data_operand(struct mcc_asm_declaration *decl, struct mcc_asm_data *data)
 {
-	struct mcc_asm_operand *new = malloc(sizeof(*new));
+	struct mcc_asm_operand *new = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*new));
 	if (!new) {
 		data->has_failed = true;
 		return NULL;
@@ -375,7 +403,7 @@ void mcc_asm_delete_asm(struct mcc_asm *head)
 		return;
 	mcc_asm_delete_text_section(head->text_section);
 	mcc_asm_delete_data_section(head->data_section);
-	free(head);
+	mcc_free(MCC_ALLOC_ASM, head);
 }
 
 void mcc_asm_delete_text_section(struct mcc_asm_text_section *text_section)
@@ -383,7 +411,7 @@ void mcc_asm_delete_text_section(struct mcc_asm_text_section *text_section)
 	if (!text_section)
 		return;
 	mcc_asm_delete_all_functions(text_section->function);
-	free(text_section);
+	mcc_free(MCC_ALLOC_ASM, text_section);
 }
 
 void mcc_asm_delete_data_section(struct mcc_asm_data_section *data_section)
@@ -391,15 +419,18 @@ void mcc_asm_delete_data_section(struct mcc_asm_data_section *data_section)
 	if (!data_section)
 		return;
 	mcc_asm_delete_all_declarations(data_section->head);
-	free(data_section);
+	mcc_hash_map_delete(data_section->strings);
+	mcc_hash_map_delete(data_section->floats);
+	mcc_free(MCC_ALLOC_ASM, data_section);
 }
 
 void mcc_asm_delete_all_declarations(struct mcc_asm_declaration *decl)
 {
-	if (!decl)
-		return;
-	mcc_asm_delete_all_declarations(decl->next);
-	mcc_asm_delete_declaration(decl);
+	while (decl) {
+		struct mcc_asm_declaration *next = decl->next;
+		mcc_asm_delete_declaration(decl);
+		decl = next;
+	}
 }
 
 void mcc_asm_delete_declaration(struct mcc_asm_declaration *decl)
@@ -407,17 +438,18 @@ void mcc_asm_delete_declaration(struct mcc_asm_declaration *decl)
 	if (!decl)
 		return;
 	if (decl->type == MCC_ASM_DECLARATION_TYPE_STRING || decl->type == MCC_ASM_DECLARATION_TYPE_FLOAT) {
-		free(decl->identifier);
+		mcc_free(MCC_ALLOC_ASM, decl->identifier);
 	}
-	free(decl);
+	mcc_free(MCC_ALLOC_ASM, decl);
 }
 
 void mcc_asm_delete_all_functions(struct mcc_asm_function *function)
 {
-	if (!function)
-		return;
-	mcc_asm_delete_all_functions(function->next);
-	mcc_asm_delete_function(function);
+	while (function) {
+		struct mcc_asm_function *next = function->next;
+		mcc_asm_delete_function(function);
+		function = next;
+	}
 }
 
 void mcc_asm_delete_function(struct mcc_asm_function *function)
@@ -425,16 +457,17 @@ void mcc_asm_delete_function(struct mcc_asm_function *function)
 	if (!function)
 		return;
 	mcc_asm_delete_all_lines(function->head);
-	free(function->label);
-	free(function);
+	mcc_free(MCC_ALLOC_ASM, function->label);
+	mcc_free(MCC_ALLOC_ASM, function);
 }
 
 void mcc_asm_delete_all_lines(struct mcc_asm_line *line)
 {
-	if (!line)
-		return;
-	mcc_asm_delete_all_lines(line->next);
-	mcc_asm_delete_line(line);
+	while (line) {
+		struct mcc_asm_line *next = line->next;
+		mcc_asm_delete_line(line);
+		line = next;
+	}
 }
 
 void mcc_asm_delete_line(struct mcc_asm_line *line)
@@ -445,7 +478,7 @@ void mcc_asm_delete_line(struct mcc_asm_line *line)
 		mcc_asm_delete_operand(line->first);
 		mcc_asm_delete_operand(line->second);
 	}
-	free(line);
+	mcc_free(MCC_ALLOC_ASM_LINE, line);
 }
 
 void mcc_asm_delete_operand(struct mcc_asm_operand *operand)
@@ -453,9 +486,9 @@ void mcc_asm_delete_operand(struct mcc_asm_operand *operand)
 	if (!operand)
 		return;
 	if (operand->type == MCC_ASM_OPERAND_FUNCTION) {
-		free(operand->func_name);
+		mcc_free(MCC_ALLOC_ASM_OPERAND, operand->func_name);
 	}
-	free(operand);
+	mcc_free(MCC_ALLOC_ASM_OPERAND, operand);
 }
 
 //---------------------------------------------------------------------------------------- Functions: ASM generation
@@ -466,24 +499,15 @@ get_array_element_declaration(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg
 	assert(an_ir);
 	if (data->has_failed)
 		return NULL;
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
-	while (an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0) {
-				return an_ir;
-			}
-		}
-		if (an_ir->row->instr == MCC_IR_INSTR_ASSIGN) {
-			if (strcmp(an_ir->row->arg1->ident, arg->ident) == 0) {
-				return an_ir;
-			}
-		}
-		an_ir = an_ir->next;
-		continue;
-	}
-	data->has_failed = true;
-	return NULL;
+
+	// Local arrays are declared by an array row, array parameters by the assignment following their pop
+	struct mcc_annotated_ir *function = data->operands->function;
+	struct mcc_annotated_ir *decl = mcc_get_array_declaration(function, arg->symbol);
+	if (!decl)
+		decl = mcc_get_variable_declaration(function, arg->symbol);
+	if (!decl)
+		data->has_failed = true;
+	return decl;
 }
 
 static bool array_is_reference(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm_data *data)
@@ -512,7 +536,7 @@ get_array_element_operand(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg
 	bool is_reference = array_is_reference(an_ir, arg, data);
 
 	if (is_reference)
-		offset = get_identifier_offset(an_ir, arg->arr_ident);
+		offset = get_identifier_offset(data->operands, arg->symbol);
 
 	switch (arg->index->type) {
 	case MCC_IR_TYPE_LIT_INT:
@@ -520,11 +544,11 @@ get_array_element_operand(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg
 		mcc_asm_new_line(MCC_ASM_MOVL, mcc_asm_new_literal_operand(index_offset, data), ebx(data), data);
 		break;
 	case MCC_IR_TYPE_IDENTIFIER:
-		index_offset = get_identifier_offset(an_ir, arg->index->ident);
+		index_offset = get_identifier_offset(data->operands, arg->index->symbol);
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(index_offset, data), ebx(data), data);
 		break;
 	case MCC_IR_TYPE_ROW:
-		index_offset = get_row_offset(an_ir, arg->index->row);
+		index_offset = get_row_offset(data->operands, arg->index->row);
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(index_offset, data), ebx(data), data);
 		break;
 	default:
@@ -536,60 +560,9 @@ get_array_element_operand(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg
 		mcc_asm_new_line(MCC_ASM_MOVL, ebp(offset, data), ecx(data), data);
 		return mcc_asm_new_computed_offset_operand(0, MCC_ASM_ECX, MCC_ASM_EBX, DWORD_SIZE, data);
 	} else {
-		return mcc_asm_new_computed_offset_operand(mcc_get_array_base_stack_loc(an_ir, arg), MCC_ASM_EBP,
-		                                           MCC_ASM_EBX, DWORD_SIZE, data);
-	}
-}
-
-// function to check if 'prefix' is a proper prefix of 'string'. It is proper if 'prefix' followed by _x is equal to
-// 'string', where x is an arbitrary number
-static bool is_proper_prefix(char *prefix, char *string)
-{
-	assert(prefix);
-	assert(string);
-
-	if (strlen(prefix) >= strlen(string)) {
-		return false;
-	}
-
-	unsigned len_p = strlen(prefix);
-	if (strncmp(prefix, string, len_p) != 0) {
-		return false;
-	}
-	if ('_' != string[len_p]) {
-		return false;
-	}
-	for (unsigned i = len_p + 1; i < strlen(string); i++) {
-		// check if all characters after the character '_' are digits
-		if (string[i] < '0' || string[i] > '9') {
-			return false;
-		}
+		return mcc_asm_new_computed_offset_operand(get_array_base_offset(data->operands, arg->symbol),
+		                                           MCC_ASM_EBP, MCC_ASM_EBX, DWORD_SIZE, data);
 	}
-	return true;
-}
-
-static bool is_in_data_section(char *ident, struct mcc_asm_data *data)
-{
-	struct mcc_asm_declaration *decl = data->data_section->head;
-	bool looking_for_tmp = false;
-	// if ident is '$tmpXX' look for declaration starting from position 1
-	if (strncmp(ident, "$tmp", 4) == 0) {
-		ident = &ident[1];
-		looking_for_tmp = true;
-	}
-	while (decl) {
-		if (looking_for_tmp) {
-			if (strcmp(decl->identifier, ident) == 0 && decl->type == MCC_ASM_DECLARATION_TYPE_FLOAT) {
-				return true;
-			}
-		} else { // if not looking for tmp: check if ident is proper prefix of decl->identifier
-			if (is_proper_prefix(ident, decl->identifier)) {
-				return true;
-			}
-		}
-		decl = decl->next;
-	}
-	return false;
 }
 
 static bool is_float(struct mcc_ir_arg *arg, struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -609,7 +582,8 @@ static bool is_float(struct mcc_ir_arg *arg, struct mcc_annotated_ir *an_ir, str
 	case MCC_IR_TYPE_ROW:
 		return (arg->row->type->type == MCC_IR_ROW_FLOAT);
 	case MCC_IR_TYPE_IDENTIFIER:
-		return is_in_data_section(arg->ident, data);
+		an_ir = mcc_get_variable_declaration(data->operands->function, arg->symbol);
+		return an_ir && an_ir->row->type->type == MCC_IR_ROW_FLOAT;
 	case MCC_IR_TYPE_ARR_ELEM:
 		an_ir = get_array_element_declaration(an_ir, arg, data);
 		return (an_ir->row->type->type == MCC_IR_ROW_FLOAT);
@@ -648,7 +622,7 @@ arg_to_op(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm
 		break;
 	case MCC_IR_TYPE_ROW:
 	case MCC_IR_TYPE_IDENTIFIER:
-		operand = mcc_asm_new_register_operand(MCC_ASM_EBP, get_offset_of(an_ir, arg), data);
+		operand = mcc_asm_new_register_operand(MCC_ASM_EBP, get_offset_of(data->operands, arg), data);
 		break;
 	case MCC_IR_TYPE_ARR_ELEM:
 		operand = get_array_element_operand(an_ir, arg, data);
@@ -660,40 +634,46 @@ arg_to_op(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *arg, struct mcc_asm
 	return operand;
 }
 
-static struct mcc_asm_operand *find_string_identifier(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
+// Floats are pooled by bit pattern, which is used as key in hex
+#define FLOAT_KEY_SIZE (2 * sizeof(uint64_t) + 1)
+
+static void float_key(double value, char key[FLOAT_KEY_SIZE])
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	snprintf(key, FLOAT_KEY_SIZE, "%016" PRIx64, bits);
+}
+
+static struct mcc_asm_operand *data_operand(struct mcc_asm_declaration *decl, struct mcc_asm_data *data)
 {
-	assert(an_ir);
-	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
-	assert(an_ir->row->arg2->type == MCC_IR_TYPE_LIT_STRING);
-	assert(data);
 	if (data->has_failed)
 		return NULL;
+	if (!decl) {
+		data->has_failed = true;
+		return NULL;
+	}
 
-	struct mcc_asm_operand *op = malloc(sizeof(*op));
+	struct mcc_asm_operand *op = mcc_malloc(MCC_ALLOC_ASM_OPERAND, sizeof(*op));
 	if (!op) {
 		data->has_failed = true;
 		return NULL;
 	}
+	op->decl = decl;
+	op->type = MCC_ASM_OPERAND_DATA;
+	op->offset = 0;
+	return op;
+}
 
-	char *wanted_string = an_ir->row->arg2->lit_string;
-	struct mcc_asm_declaration *head = data->data_section->head;
-	while (head) {
-		if (head->type != MCC_ASM_DECLARATION_TYPE_STRING) {
-			head = head->next;
-			continue;
-		}
-		if (strcmp(wanted_string, head->string_value) != 0) {
-			head = head->next;
-			continue;
-		}
-		op->decl = head;
-		op->type = MCC_ASM_OPERAND_DATA;
-		op->offset = 0;
-		return op;
-	}
+static struct mcc_asm_operand *find_string_identifier(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
+{
+	assert(an_ir);
+	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
+	assert(an_ir->row->arg2->type == MCC_IR_TYPE_LIT_STRING);
+	assert(data);
+	if (data->has_failed)
+		return NULL;
 
-	free(op);
-	return NULL;
+	return data_operand(mcc_hash_map_lookup(data->data_section->strings, an_ir->row->arg2->lit_string), data);
 }
 
 static struct mcc_asm_operand *find_float_identifier(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -705,29 +685,9 @@ static struct mcc_asm_operand *find_float_identifier(struct mcc_annotated_ir *an
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_asm_operand *op = malloc(sizeof(*op));
-	if (!op) {
-		data->has_failed = true;
-		return NULL;
-	}
-
-	double wanted_float = an_ir->row->arg2->lit_float;
-	double epsilon = EPSILON;
-	struct mcc_asm_declaration *head = data->data_section->head;
-	while (head) {
-		if (head->type == MCC_ASM_DECLARATION_TYPE_FLOAT &&
-		    (fabs(wanted_float - head->float_value) < epsilon) &&
-		    (is_proper_prefix(an_ir->row->arg1->ident, head->identifier) ||
-		     strcmp(an_ir->row->arg1->ident, head->identifier) == 0)) {
-			op->decl = head;
-			op->type = MCC_ASM_OPERAND_DATA;
-			op->offset = 0;
-			return op;
-		}
-		head = head->next;
-	}
-	free(op);
-	return NULL;
+	char key[FLOAT_KEY_SIZE];
+	float_key(an_ir->row->arg2->lit_float, key);
+	return data_operand(mcc_hash_map_lookup(data->data_section->floats, key), data);
 }
 
 static void generate_string_assignment(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *data)
@@ -860,7 +820,7 @@ static void generate_return(struct mcc_annotated_ir *an_ir, struct mcc_asm_data
 		}
 	}
 	// pop ebx
-	an_ir = mcc_get_function_label(an_ir);
+	an_ir = data->operands->function;
 	if (strcmp(an_ir->row->arg1->func_label, "main") != 0) {
 		mcc_asm_new_line(MCC_ASM_POPL, ebx(data), NULL, data);
 	}
@@ -872,7 +832,7 @@ static void generate_push(struct mcc_annotated_ir *an_ir, struct mcc_asm_data *d
 {
 	assert(an_ir);
 	assert(an_ir->row->arg1);
-	if (arg_is_local_array(an_ir, an_ir->row->arg1)) {
+	if (arg_is_local_array(data->operands, an_ir->row->arg1)) {
 		mcc_asm_new_line(MCC_ASM_LEAL, arg_to_op(an_ir, an_ir->row->arg1, data), eax(data), data);
 		mcc_asm_new_line(MCC_ASM_PUSHL, eax(data), NULL, data);
 		return;
@@ -1164,10 +1124,20 @@ struct mcc_asm_function *mcc_asm_generate_function(struct mcc_annotated_ir *an_i
 		return NULL;
 	}
 
+	// Operands of this function are resolved through the operand table
+	data->operands = new_operand_table(an_ir);
+	if (!data->operands) {
+		data->has_failed = true;
+		mcc_asm_delete_function(function);
+		return NULL;
+	}
+
 	// Prolog
-	struct mcc_asm_line *push_ebp = malloc(sizeof *push_ebp);
+	struct mcc_asm_line *push_ebp = mcc_malloc(MCC_ALLOC_ASM_LINE, sizeof *push_ebp);
 	if (!push_ebp) {
 		data->has_failed = true;
+		delete_operand_table(data->operands);
+		data->operands = NULL;
 		mcc_asm_delete_function(function);
 		return NULL;
 	}
@@ -1186,6 +1156,8 @@ struct mcc_asm_function *mcc_asm_generate_function(struct mcc_annotated_ir *an_i
 
 	// Function body
 	mcc_asm_generate_function_body(function, an_ir, data);
+	delete_operand_table(data->operands);
+	data->operands = NULL;
 
 	if (data->has_failed) {
 		mcc_asm_delete_all_lines(push_ebp);
@@ -1207,6 +1179,19 @@ static struct mcc_annotated_ir *find_next_function(struct mcc_annotated_ir *an_i
 	return an_ir;
 }
 
+// Functions of the text section are generated independently, each one with its own mcc_asm_data
+struct text_function {
+	struct mcc_annotated_ir *label;
+	struct mcc_asm_function *function;
+	struct mcc_asm_data data;
+};
+
+static void generate_function_task(int index, void *userdata)
+{
+	struct text_function *text = &((struct text_function *)userdata)[index];
+	text->function = mcc_asm_generate_function(text->label, &text->data);
+}
+
 void mcc_asm_generate_text_section(struct mcc_asm_text_section *text_section,
                                    struct mcc_annotated_ir *an_ir,
                                    struct mcc_asm_data *data)
@@ -1214,54 +1199,104 @@ void mcc_asm_generate_text_section(struct mcc_asm_text_section *text_section,
 	if (data->has_failed)
 		return;
 
-	struct mcc_asm_function *first_function = mcc_asm_generate_function(an_ir, data);
-	if (!first_function) {
+	int num_functions = 0;
+	for (struct mcc_annotated_ir *label = an_ir; label; label = find_next_function(label)) {
+		num_functions++;
+	}
+	if (num_functions == 0) {
+		text_section->function = NULL;
+		return;
+	}
+
+	struct text_function *functions = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*functions) * num_functions);
+	if (!functions) {
 		data->has_failed = true;
 		return;
 	}
-	struct mcc_asm_function *latest_function = first_function;
-	an_ir = find_next_function(an_ir);
-	while (an_ir) {
-		struct mcc_asm_function *new_function = mcc_asm_generate_function(an_ir, data);
-		if (data->has_failed) {
-			mcc_asm_delete_all_functions(first_function);
-			return;
+	// Functions only share the data section, which is not modified anymore
+	int i = 0;
+	for (struct mcc_annotated_ir *label = an_ir; label; label = find_next_function(label)) {
+		functions[i++] = (struct text_function){
+		    .label = label,
+		    .data = {.data_section = data->data_section},
+		};
+	}
+	mcc_thread_pool_for(num_functions, generate_function_task, functions);
+
+	for (i = 0; i < num_functions; i++) {
+		if (!functions[i].function || functions[i].data.has_failed)
+			data->has_failed = true;
+	}
+	if (data->has_failed) {
+		for (i = 0; i < num_functions; i++) {
+			mcc_asm_delete_function(functions[i].function);
 		}
-		latest_function->next = new_function;
-		latest_function = new_function;
-		an_ir = find_next_function(an_ir);
+		mcc_free(MCC_ALLOC_OTHER, functions);
+		return;
 	}
-	text_section->function = first_function;
-	return;
-}
 
-static char *get_tmp_ident(char *id)
-{
-	memmove(id, id + 1, strlen(id));
-	char *new = malloc(sizeof(char) * strlen(id) + 1);
-	if (!new)
-		return NULL;
-	snprintf(new, strlen(id) + 1, "%s", id);
-	return new;
+	// Link functions in source order
+	for (i = 0; i + 1 < num_functions; i++) {
+		functions[i].function->next = functions[i + 1].function;
+	}
+	text_section->function = functions[0].function;
+	mcc_free(MCC_ALLOC_OTHER, functions);
 }
 
-static char *rename_identifier(char *id, int counter)
+// Name of the declaration of a literal first assigned to arg: temporary $tmpN becomes tmpN, other identifiers get a
+// counter
+static char *rename_identifier(struct mcc_ir_arg *arg, int counter)
 {
-	assert(id);
-	if (strncmp(id, "$tmp", 4) == 0) {
-		return get_tmp_ident(id);
+	assert(arg);
+	if (arg->type == MCC_IR_TYPE_IDENTIFIER && arg->is_tmp) {
+		int new_length = 4 + length_of_int(arg->tmp);
+		char *new = mcc_malloc(MCC_ALLOC_STRING, sizeof(char) * new_length);
+		if (!new)
+			return NULL;
+		snprintf(new, new_length, "tmp%u", arg->tmp);
+		return new;
 	} else {
+		char *id = arg->type == MCC_IR_TYPE_ARR_ELEM ? arg->arr_ident : arg->ident;
 		int extra_length = 2 + length_of_int(counter);
 		int new_length = strlen(id) + extra_length;
-		char *new = malloc(sizeof(char) * new_length);
+		char *new = mcc_malloc(MCC_ALLOC_STRING, sizeof(char) * new_length);
 		if (!new)
 			return NULL;
 		snprintf(new, new_length, "%s_%d", id, counter);
-		counter++;
 		return new;
 	}
 }
 
+// Declare the literal assigned in row, unless an identical one is already pooled
+static struct mcc_asm_declaration *
+pool_literal(struct mcc_asm_data_section *data_section, struct mcc_ir_row *row, int counter, struct mcc_asm_data *data)
+{
+	struct mcc_asm_declaration *decl = NULL;
+	char *identifier = NULL;
+
+	if (row->arg2->type == MCC_IR_TYPE_LIT_STRING) {
+		if (mcc_hash_map_contains(data_section->strings, row->arg2->lit_string))
+			return NULL;
+		identifier = rename_identifier(row->arg1, counter);
+		decl = mcc_asm_new_string_declaration(identifier, row->arg2->lit_string, NULL, data);
+		if (decl && mcc_hash_map_insert(data_section->strings, row->arg2->lit_string, decl) != 0)
+			data->has_failed = true;
+	} else {
+		char key[FLOAT_KEY_SIZE];
+		float_key(row->arg2->lit_float, key);
+		if (mcc_hash_map_contains(data_section->floats, key))
+			return NULL;
+		identifier = rename_identifier(row->arg1, counter);
+		decl = mcc_asm_new_float_declaration(identifier, row->arg2->lit_float, NULL, data);
+		if (decl && mcc_hash_map_insert(data_section->floats, key, decl) != 0)
+			data->has_failed = true;
+	}
+	mcc_free(MCC_ALLOC_STRING, identifier);
+	if (!decl)
+		data->has_failed = true;
+	return decl;
+}
+
 void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
                                    struct mcc_annotated_ir *an_ir,
                                    struct mcc_asm_data *data)
@@ -1271,65 +1306,48 @@ void mcc_asm_generate_data_section(struct mcc_asm_data_section *data_section,
 	assert(data);
 	if (data->has_failed)
 		return;
-	struct mcc_asm_declaration *head = data_section->head;
+	struct mcc_asm_declaration *tail = data_section->head;
+	while (tail && tail->next) {
+		tail = tail->next;
+	}
 	int counter = 0;
 
-	// Allocate all declared strings
-	while (an_ir) {
-		if (an_ir->row->instr != MCC_IR_INSTR_ASSIGN) {
-			an_ir = an_ir->next;
+	// Declare each distinct string and float literal once
+	for (; an_ir && !data->has_failed; an_ir = an_ir->next) {
+		struct mcc_ir_row *row = an_ir->row;
+		if (row->instr != MCC_IR_INSTR_ASSIGN ||
+		    (row->arg2->type != MCC_IR_TYPE_LIT_STRING && row->arg2->type != MCC_IR_TYPE_LIT_FLOAT))
 			continue;
-		}
-		struct mcc_asm_declaration *decl = NULL;
-		if (an_ir->row->arg2->type == MCC_IR_TYPE_LIT_STRING) {
-			char *string_identifier = rename_identifier(an_ir->row->arg1->ident, counter);
-			decl =
-			    mcc_asm_new_string_declaration(string_identifier, an_ir->row->arg2->lit_string, NULL, data);
-			free(string_identifier);
-			counter++;
-		} else if (an_ir->row->arg2->type == MCC_IR_TYPE_LIT_FLOAT) {
-			char *float_identifier = rename_identifier(an_ir->row->arg1->ident, counter);
-			decl = mcc_asm_new_float_declaration(float_identifier, an_ir->row->arg2->lit_float, NULL, data);
-			free(float_identifier);
-			counter++;
-		} else {
-			an_ir = an_ir->next;
+
+		struct mcc_asm_declaration *decl = pool_literal(data_section, row, counter, data);
+		if (!decl)
 			continue;
-		}
-		if (!decl) {
-			mcc_asm_delete_all_declarations(head);
-			data->has_failed = false;
-			return;
-		}
-		if (!head) {
-			head = decl;
-			data_section->head = head;
+		counter++;
+		if (!tail) {
+			data_section->head = decl;
 		} else {
-			head->next = decl;
-			head = decl;
+			tail->next = decl;
 		}
-		an_ir = an_ir->next;
+		tail = decl;
 	}
-
-	return;
 }
 
-struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
+static struct mcc_asm *generate_asm(struct mcc_annotated_ir *an_ir)
 {
-	struct mcc_asm_data *data = malloc(sizeof(*data));
+	struct mcc_asm_data *data = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*data));
 	if (!data) {
 		return NULL;
 	}
 	data->has_failed = false;
-	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
+	data->operands = NULL;
 	struct mcc_asm *assembly = mcc_asm_new_asm(NULL, NULL, data);
 	struct mcc_asm_text_section *text_section = mcc_asm_new_text_section(NULL, data);
 	struct mcc_asm_data_section *data_section = mcc_asm_new_data_section(NULL, data);
-	if (!an_ir || data->has_failed) {
+	if (data->has_failed) {
 		mcc_asm_delete_asm(assembly);
 		mcc_asm_delete_text_section(text_section);
 		mcc_asm_delete_data_section(data_section);
-		mcc_delete_annotated_ir(an_ir);
+		mcc_free(MCC_ALLOC_OTHER, data);
 		return NULL;
 	}
 	assembly->data_section = data_section;
@@ -1340,12 +1358,31 @@ struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
 	mcc_asm_generate_text_section(assembly->text_section, an_ir, data);
 	if (data->has_failed) {
 		mcc_asm_delete_asm(assembly);
-		mcc_delete_annotated_ir(an_ir);
+		assembly = NULL;
 	}
 
-	free(data);
+	mcc_free(MCC_ALLOC_OTHER, data);
+
+	return assembly;
+}
+
+struct mcc_asm *mcc_asm_generate(struct mcc_ir_row *ir)
+{
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
+	if (!an_ir)
+		return NULL;
+	struct mcc_asm *assembly = mcc_asm_generate_annotated(an_ir);
 	mcc_delete_annotated_ir(an_ir);
+	return assembly;
+}
+
+struct mcc_asm *mcc_asm_generate_annotated(struct mcc_annotated_ir *an_ir)
+{
+	assert(an_ir);
 
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_ASM);
+	struct mcc_asm *assembly = generate_asm(an_ir);
+	mcc_alloc_set_phase(phase);
 	return assembly;
 }
 
@@ -4,19 +4,46 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
+#include "mcc/arena.h"
+
+// ---------------------------------------------------------------- Nodes
+
+// Allocate node in the current arena if there is one. Nodes in an arena are not freed by the delete functions.
+static void *new_node(size_t size)
+{
+	struct mcc_ast_node *node = mcc_arena_malloc(MCC_ALLOC_AST_NODE, size);
+	if (!node)
+		return NULL;
+	node->arena = mcc_arena_get_current();
+	return node;
+}
+
 // ---------------------------------------------------------------- Expressions
 
+// The data type stays unknown until the semantic checks
+static struct mcc_ast_expression *new_expression(enum mcc_ast_expression_type type)
+{
+	struct mcc_ast_expression *expr = new_node(sizeof(*expr));
+	if (!expr)
+		return NULL;
+	expr->type = type;
+	expr->data_type.type = VOID;
+	expr->data_type.array_size = -1;
+	expr->data_type.is_known = false;
+	return expr;
+}
+
 struct mcc_ast_expression *mcc_ast_new_expression_literal(struct mcc_ast_literal *literal)
 {
 	if (!literal)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_LITERAL);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_LITERAL;
 	expr->literal = literal;
 	return expr;
 }
@@ -28,12 +55,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_binary_op(enum mcc_ast_binary_
 	if (!rhs || !lhs)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_BINARY_OP);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_BINARY_OP;
 	expr->op = op;
 	expr->lhs = lhs;
 	expr->rhs = rhs;
@@ -45,12 +71,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_parenth(struct mcc_ast_express
 	if (!expression)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_PARENTH);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_PARENTH;
 	expr->expression = expression;
 	return expr;
 }
@@ -60,12 +85,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_unary_op(enum mcc_ast_unary_op
 	if (!child)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_UNARY_OP);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_UNARY_OP;
 	expr->u_op = u_op;
 	expr->child = child;
 	return expr;
@@ -77,12 +101,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_variable(struct mcc_ast_identi
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_VARIABLE);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_VARIABLE;
 	expr->identifier = identifier;
 
 	return expr;
@@ -95,12 +118,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_array_element(struct mcc_ast_i
 	if (!identifier || !index)
 		return NULL;
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT;
 	expr->array_identifier = identifier;
 	expr->index = index;
 
@@ -112,12 +134,11 @@ struct mcc_ast_expression *mcc_ast_new_expression_function_call(struct mcc_ast_i
 {
 	assert(identifier);
 
-	struct mcc_ast_expression *expr = malloc(sizeof(*expr));
+	struct mcc_ast_expression *expr = new_expression(MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL);
 	if (!expr) {
 		return NULL;
 	}
 
-	expr->type = MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL;
 	expr->function_identifier = identifier;
 	expr->arguments = arguments;
 
@@ -128,6 +149,8 @@ void mcc_ast_delete_expression(struct mcc_ast_expression *expression)
 {
 	if (!expression)
 		return;
+	if (expression->node.arena)
+		return;
 
 	switch (expression->type) {
 	case MCC_AST_EXPRESSION_TYPE_LITERAL:
@@ -162,14 +185,14 @@ void mcc_ast_delete_expression(struct mcc_ast_expression *expression)
 		break;
 	}
 
-	free(expression);
+	mcc_free(MCC_ALLOC_AST_NODE, expression);
 }
 
 // ------------------------------------------------------------------ Types
 
 struct mcc_ast_type *mcc_ast_new_type(enum mcc_ast_types type)
 {
-	struct mcc_ast_type *newtype = malloc(sizeof(*newtype));
+	struct mcc_ast_type *newtype = new_node(sizeof(*newtype));
 	if (!newtype) {
 		return NULL;
 	}
@@ -179,7 +202,9 @@ struct mcc_ast_type *mcc_ast_new_type(enum mcc_ast_types type)
 
 void mcc_ast_delete_type(struct mcc_ast_type *type)
 {
-	free(type);
+	if (!type || type->node.arena)
+		return;
+	mcc_free(MCC_ALLOC_AST_NODE, type);
 }
 
 // ------------------------------------------------------------------
@@ -192,7 +217,7 @@ struct mcc_ast_declaration *mcc_ast_new_variable_declaration(enum mcc_ast_types
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_declaration *decl = malloc(sizeof(*decl));
+	struct mcc_ast_declaration *decl = new_node(sizeof(*decl));
 	if (!decl) {
 		return NULL;
 	}
@@ -200,7 +225,7 @@ struct mcc_ast_declaration *mcc_ast_new_variable_declaration(enum mcc_ast_types
 	struct mcc_ast_type *newtype = mcc_ast_new_type(type);
 
 	if (!newtype) {
-		free(decl);
+		mcc_arena_free(decl->node.arena, MCC_ALLOC_AST_NODE, decl);
 		return NULL;
 	}
 
@@ -214,9 +239,11 @@ struct mcc_ast_declaration *mcc_ast_new_variable_declaration(enum mcc_ast_types
 void mcc_ast_delete_variable_declaration(struct mcc_ast_declaration *decl)
 {
 	assert(decl);
+	if (decl->node.arena)
+		return;
 	mcc_ast_delete_identifier(decl->variable_identifier);
 	mcc_ast_delete_type(decl->variable_type);
-	free(decl);
+	mcc_free(MCC_ALLOC_AST_NODE, decl);
 }
 
 struct mcc_ast_declaration *mcc_ast_new_array_declaration(enum mcc_ast_types type,
@@ -227,14 +254,14 @@ struct mcc_ast_declaration *mcc_ast_new_array_declaration(enum mcc_ast_types typ
 	if (!identifier || !size)
 		return NULL;
 
-	struct mcc_ast_declaration *array_decl = malloc(sizeof(*array_decl));
+	struct mcc_ast_declaration *array_decl = new_node(sizeof(*array_decl));
 	if (!array_decl) {
 		return NULL;
 	}
 
 	struct mcc_ast_type *newtype = mcc_ast_new_type(type);
 	if (!newtype) {
-		free(array_decl);
+		mcc_arena_free(array_decl->node.arena, MCC_ALLOC_AST_NODE, array_decl);
 		return NULL;
 	}
 
@@ -250,16 +277,20 @@ void mcc_ast_delete_array_declaration(struct mcc_ast_declaration *array_decl)
 {
 	if (!array_decl)
 		return;
+	if (array_decl->node.arena)
+		return;
 	mcc_ast_delete_identifier(array_decl->array_identifier);
 	mcc_ast_delete_type(array_decl->array_type);
 	mcc_ast_delete_literal(array_decl->array_size);
-	free(array_decl);
+	mcc_free(MCC_ALLOC_AST_NODE, array_decl);
 }
 
 void mcc_ast_delete_declaration(struct mcc_ast_declaration *decl)
 {
 	if (!decl)
 		return;
+	if (decl->node.arena)
+		return;
 	switch (decl->declaration_type) {
 	case MCC_AST_DECLARATION_TYPE_VARIABLE:
 		mcc_ast_delete_variable_declaration(decl);
@@ -278,7 +309,7 @@ struct mcc_ast_assignment *mcc_ast_new_variable_assignment(struct mcc_ast_identi
 {
 	if (!identifier || !assigned_value)
 		return NULL;
-	struct mcc_ast_assignment *assignment = malloc(sizeof(*assignment));
+	struct mcc_ast_assignment *assignment = new_node(sizeof(*assignment));
 	if (assignment == NULL) {
 		return NULL;
 	}
@@ -296,7 +327,7 @@ struct mcc_ast_assignment *mcc_ast_new_array_assignment(struct mcc_ast_identifie
 	if (!index || !identifier || !assigned_value)
 		return NULL;
 
-	struct mcc_ast_assignment *assignment = malloc(sizeof(*assignment));
+	struct mcc_ast_assignment *assignment = new_node(sizeof(*assignment));
 	if (!assignment) {
 		return NULL;
 	}
@@ -311,6 +342,8 @@ void mcc_ast_delete_assignment(struct mcc_ast_assignment *assignment)
 {
 	if (!assignment)
 		return;
+	if (assignment->node.arena)
+		return;
 	switch (assignment->assignment_type) {
 	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
 		mcc_ast_delete_variable_assignment(assignment);
@@ -325,19 +358,23 @@ void mcc_ast_delete_variable_assignment(struct mcc_ast_assignment *assignment)
 {
 	if (!assignment)
 		return;
+	if (assignment->node.arena)
+		return;
 	mcc_ast_delete_identifier(assignment->variable_identifier);
 	mcc_ast_delete_expression(assignment->variable_assigned_value);
-	free(assignment);
+	mcc_free(MCC_ALLOC_AST_NODE, assignment);
 }
 
 void mcc_ast_delete_array_assignment(struct mcc_ast_assignment *assignment)
 {
 	if (!assignment)
 		return;
+	if (assignment->node.arena)
+		return;
 	mcc_ast_delete_identifier(assignment->array_identifier);
 	mcc_ast_delete_expression(assignment->array_assigned_value);
 	mcc_ast_delete_expression(assignment->array_index);
-	free(assignment);
+	mcc_free(MCC_ALLOC_AST_NODE, assignment);
 }
 
 // ------------------------------------------------------------------ Identifier
@@ -347,7 +384,7 @@ struct mcc_ast_identifier *mcc_ast_new_identifier(char *identifier)
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_identifier *expr = malloc(sizeof(*expr));
+	struct mcc_ast_identifier *expr = new_node(sizeof(*expr));
 	if (!expr) {
 		return NULL;
 	}
@@ -361,9 +398,10 @@ void mcc_ast_delete_identifier(struct mcc_ast_identifier *identifier)
 {
 	if (!identifier)
 		return;
-	if (identifier->identifier_name)
-		free(identifier->identifier_name);
-	free(identifier);
+	if (identifier->node.arena)
+		return;
+	// identifier_name is interned and owned by the interner
+	mcc_free(MCC_ALLOC_AST_NODE, identifier);
 }
 
 // -------------------------------------------------------------------  Statements
@@ -374,7 +412,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_if_stmt(struct mcc_ast_expressio
 	if (!condition || !on_true)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -393,7 +431,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_if_else_stmt(struct mcc_ast_expr
 	if (!condition || !on_true || !on_false)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -411,7 +449,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_expression(struct mcc_ast_expres
 	if (!expression)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -428,7 +466,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_while(struct mcc_ast_expression
 	if (!condition || !on_true)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -445,7 +483,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_declaration(struct mcc_ast_decla
 	if (!declaration)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -461,7 +499,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_assignment(struct mcc_ast_assign
 	if (!assignment)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -478,7 +516,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_return(bool is_empty_return, str
 		if (!expression)
 			return NULL;
 	}
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -500,7 +538,7 @@ struct mcc_ast_statement *mcc_ast_new_statement_compound_stmt(struct mcc_ast_com
 	if (!compound_statement)
 		return NULL;
 
-	struct mcc_ast_statement *statement = malloc(sizeof(*statement));
+	struct mcc_ast_statement *statement = new_node(sizeof(*statement));
 	if (!statement) {
 		return NULL;
 	}
@@ -515,6 +553,8 @@ void mcc_ast_delete_statement(struct mcc_ast_statement *statement)
 {
 	if (!statement)
 		return;
+	if (statement->node.arena)
+		return;
 
 	switch (statement->type) {
 	case MCC_AST_STATEMENT_TYPE_IF_STMT:
@@ -549,7 +589,7 @@ void mcc_ast_delete_statement(struct mcc_ast_statement *statement)
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
 		mcc_ast_delete_compound_statement(statement->compound_statement);
 	}
-	free(statement);
+	mcc_free(MCC_ALLOC_AST_NODE, statement);
 }
 
 // ------------------------------------------------------------------- Compound
@@ -564,7 +604,7 @@ struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(bool is_empty,
 			return NULL;
 	}
 
-	struct mcc_ast_compound_statement *compound_statement = malloc(sizeof(*compound_statement));
+	struct mcc_ast_compound_statement *compound_statement = new_node(sizeof(*compound_statement));
 	if (!compound_statement) {
 		return NULL;
 	}
@@ -586,15 +626,15 @@ struct mcc_ast_compound_statement *mcc_ast_new_compound_stmt(bool is_empty,
 
 void mcc_ast_delete_compound_statement(struct mcc_ast_compound_statement *compound_statement)
 {
-	if (!compound_statement)
-		return;
-	if (compound_statement->has_next_statement == true) {
-		mcc_ast_delete_compound_statement(compound_statement->next_compound_statement);
-	}
-	if (!compound_statement->is_empty) {
-		mcc_ast_delete_statement(compound_statement->statement);
+	while (compound_statement && !compound_statement->node.arena) {
+		struct mcc_ast_compound_statement *next =
+		    compound_statement->has_next_statement ? compound_statement->next_compound_statement : NULL;
+		if (!compound_statement->is_empty) {
+			mcc_ast_delete_statement(compound_statement->statement);
+		}
+		mcc_free(MCC_ALLOC_AST_NODE, compound_statement);
+		compound_statement = next;
 	}
-	free(compound_statement);
 }
 
 // ------------------------------------------------------------------- Literals
@@ -602,7 +642,7 @@ void mcc_ast_delete_compound_statement(struct mcc_ast_compound_statement *compou
 struct mcc_ast_literal *mcc_ast_new_literal_int(long value)
 {
 
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = new_node(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -614,7 +654,7 @@ struct mcc_ast_literal *mcc_ast_new_literal_int(long value)
 
 struct mcc_ast_literal *mcc_ast_new_literal_float(double value)
 {
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = new_node(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -628,14 +668,14 @@ struct mcc_ast_literal *mcc_ast_new_literal_string(char *value)
 {
 	if (!value)
 		return NULL;
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = new_node(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
 
 	char *string_no_quotes = mcc_remove_quotes_from_string(value);
 	if (!string_no_quotes) {
-		free(lit);
+		mcc_arena_free(lit->node.arena, MCC_ALLOC_AST_NODE, lit);
 		return NULL;
 	}
 
@@ -649,7 +689,7 @@ char *mcc_remove_quotes_from_string(char *string)
 {
 
 	assert(string);
-	char *intermediate = (char *)malloc((strlen(string) - 1) * sizeof(char));
+	char *intermediate = (char *)mcc_arena_malloc(MCC_ALLOC_STRING, (strlen(string) - 1) * sizeof(char));
 	if (!intermediate)
 		return NULL;
 	strncpy(intermediate, string + 1, strlen(string) - 2);
@@ -659,7 +699,7 @@ char *mcc_remove_quotes_from_string(char *string)
 
 struct mcc_ast_literal *mcc_ast_new_literal_bool(bool value)
 {
-	struct mcc_ast_literal *lit = malloc(sizeof(*lit));
+	struct mcc_ast_literal *lit = new_node(sizeof(*lit));
 	if (!lit) {
 		return NULL;
 	}
@@ -673,10 +713,12 @@ void mcc_ast_delete_literal(struct mcc_ast_literal *literal)
 {
 	if (!literal)
 		return;
+	if (literal->node.arena)
+		return;
 	if (literal->type == MCC_AST_LITERAL_TYPE_STRING) {
-		free(literal->string_value);
+		mcc_free(MCC_ALLOC_STRING, literal->string_value);
 	}
-	free(literal);
+	mcc_free(MCC_ALLOC_AST_NODE, literal);
 }
 
 // ---------------------------------------------------------------------
@@ -689,7 +731,7 @@ struct mcc_ast_function_definition *mcc_ast_new_void_function_def(struct mcc_ast
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_function_definition *function_definition = malloc(sizeof(*function_definition));
+	struct mcc_ast_function_definition *function_definition = new_node(sizeof(*function_definition));
 	if (!function_definition) {
 		return NULL;
 	}
@@ -710,7 +752,7 @@ struct mcc_ast_function_definition *mcc_ast_new_type_function_def(enum mcc_ast_t
 	if (!identifier)
 		return NULL;
 
-	struct mcc_ast_function_definition *function_definition = malloc(sizeof(*function_definition));
+	struct mcc_ast_function_definition *function_definition = new_node(sizeof(*function_definition));
 	if (!function_definition) {
 		return NULL;
 	}
@@ -727,12 +769,14 @@ void mcc_ast_delete_function_definition(struct mcc_ast_function_definition *func
 {
 	if (!function_definition)
 		return;
+	if (function_definition->node.arena)
+		return;
 	mcc_ast_delete_identifier(function_definition->identifier);
 	mcc_ast_delete_compound_statement(function_definition->compound_stmt);
 	if (function_definition->parameters != NULL) {
 		mcc_ast_delete_parameters(function_definition->parameters);
 	}
-	free(function_definition);
+	mcc_free(MCC_ALLOC_AST_NODE, function_definition);
 }
 
 // --------------------------------------------------------------------- Program
@@ -743,7 +787,7 @@ struct mcc_ast_program *mcc_ast_new_program(struct mcc_ast_function_definition *
 	if (!function_definition)
 		return NULL;
 
-	struct mcc_ast_program *program = malloc(sizeof(*program));
+	struct mcc_ast_program *program = new_node(sizeof(*program));
 	if (!program)
 		return NULL;
 
@@ -761,7 +805,7 @@ struct mcc_ast_program *mcc_ast_new_program(struct mcc_ast_function_definition *
 
 struct mcc_ast_program *mcc_ast_new_empty_program(char *name)
 {
-	struct mcc_ast_program *program = malloc(sizeof(*program));
+	struct mcc_ast_program *program = new_node(sizeof(*program));
 	if (!program)
 		return NULL;
 
@@ -779,16 +823,12 @@ struct mcc_ast_program *mcc_ast_new_empty_program(char *name)
 
 void mcc_ast_delete_program(struct mcc_ast_program *program)
 {
-	if (!program)
-		return;
-
-	if (program->has_next_function == false) {
-		mcc_ast_delete_function_definition(program->function);
-	} else {
-		mcc_ast_delete_program(program->next_function);
+	while (program && !program->node.arena) {
+		struct mcc_ast_program *next = program->has_next_function ? program->next_function : NULL;
 		mcc_ast_delete_function_definition(program->function);
+		mcc_free(MCC_ALLOC_AST_NODE, program);
+		program = next;
 	}
-	free(program);
 }
 
 // ---------------------------------------------------------------------
@@ -802,7 +842,7 @@ struct mcc_ast_parameters *mcc_ast_new_parameters(bool is_empty,
 		if (!declaration)
 			return NULL;
 	}
-	struct mcc_ast_parameters *parameters = malloc(sizeof(*parameters));
+	struct mcc_ast_parameters *parameters = new_node(sizeof(*parameters));
 
 	if (!parameters) {
 		return NULL;
@@ -827,16 +867,14 @@ struct mcc_ast_parameters *mcc_ast_new_parameters(bool is_empty,
 
 void mcc_ast_delete_parameters(struct mcc_ast_parameters *parameters)
 {
-	if (!parameters)
-		return;
-	if (parameters->has_next_parameter == true) {
-		mcc_ast_delete_parameters(parameters->next_parameters);
-	}
-
-	if (!(parameters->is_empty)) {
-		mcc_ast_delete_declaration(parameters->declaration);
+	while (parameters && !parameters->node.arena) {
+		struct mcc_ast_parameters *next = parameters->has_next_parameter ? parameters->next_parameters : NULL;
+		if (!(parameters->is_empty)) {
+			mcc_ast_delete_declaration(parameters->declaration);
+		}
+		mcc_free(MCC_ALLOC_AST_NODE, parameters);
+		parameters = next;
 	}
-	free(parameters);
 }
 
 // ---------------------------------------------------------------------
@@ -849,7 +887,7 @@ mcc_ast_new_arguments(bool is_empty, struct mcc_ast_expression *expression, stru
 		if (!expression)
 			return NULL;
 	}
-	struct mcc_ast_arguments *arguments = malloc(sizeof(*arguments));
+	struct mcc_ast_arguments *arguments = new_node(sizeof(*arguments));
 	if (!arguments) {
 		return NULL;
 	}
@@ -872,122 +910,14 @@ mcc_ast_new_arguments(bool is_empty, struct mcc_ast_expression *expression, stru
 
 void mcc_ast_delete_arguments(struct mcc_ast_arguments *arguments)
 {
-	if (!arguments)
-		return;
-
-	if (arguments->has_next_expression == true) {
-		mcc_ast_delete_arguments(arguments->next_arguments);
-	}
-	if (!(arguments->is_empty)) {
-		mcc_ast_delete_expression(arguments->expression);
-	}
-	free(arguments);
-}
-
-// ------------------------------------------------------------------- Add and remove built_ins
-
-bool mcc_ast_add_built_ins(struct mcc_ast_program *program)
-{
-	assert(program);
-
-	const char input[] = "void print(string str){} \
-						void print_nl(){} \
-						void print_int(int a){} \
-						void print_float(float b){} \
-						int read_int(){return 0;} \
-						float read_float(){return 0.0;}";
-
-	struct mcc_parser_result result =
-	    mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, program->node.sloc.filename);
-	if (result.status != MCC_PARSER_STATUS_OK) {
-		return false;
-	}
-
-	if (!program->function) {
-		program->function = (&result)->program->function;
-		program->has_next_function = true;
-		program->next_function = (&result)->program->next_function;
-		(&result)->program->function = NULL;
-		free((&result)->program);
-	} else if (!program->next_function) {
-		program->next_function = (&result)->program;
-		program->has_next_function = true;
-		(&result)->program = NULL;
-	} else {
-		struct mcc_ast_program *program_iter = program->next_function;
-		while (program_iter->next_function) {
-			program_iter = program_iter->next_function;
-		}
-		program_iter->next_function = (&result)->program;
-		program_iter->has_next_function = true;
-		(&result)->program = NULL;
-	}
-
-	return true;
-}
-
-static void remove_function(struct mcc_ast_program *program, struct mcc_ast_program *previous)
-{
-	assert(program);
-	assert(previous);
-	assert(previous->next_function == program);
-	previous->has_next_function = program->has_next_function;
-	previous->next_function = program->next_function;
-	program->has_next_function = false;
-	program->next_function = NULL;
-	mcc_ast_delete_program(program);
-}
-
-static bool name_is_built_in(char *function_name)
-{
-	if (strcmp(function_name, "print") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_nl") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_int") == 0) {
-		return true;
-	} else if (strcmp(function_name, "print_float") == 0) {
-		return true;
-	} else if (strcmp(function_name, "read_int") == 0) {
-		return true;
-	} else if (strcmp(function_name, "read_float") == 0) {
-		return true;
-	} else {
-		return false;
-	}
-}
-
-struct mcc_ast_program *mcc_ast_remove_built_ins(struct mcc_ast_program *program)
-{
-	assert(program);
-	struct mcc_ast_program *head;
-	head = program;
-	struct mcc_ast_program *previous;
-
-	// Remove all built_ins from the beginning of the AST.
-	while (name_is_built_in(program->function->identifier->identifier_name)) {
-		previous = program;
-		program = program->next_function;
-		previous->has_next_function = false;
-		previous->next_function = NULL;
-		mcc_ast_delete_program(previous);
-	}
-
-	head = program;
-	previous = program;
-	program = previous->next_function;
-
-	// Remove all intermediate built_ins from the AST
-	while (program) {
-		if (name_is_built_in(program->function->identifier->identifier_name)) {
-			remove_function(program, previous);
-			program = previous->next_function;
-			continue;
+	while (arguments && !arguments->node.arena) {
+		struct mcc_ast_arguments *next = arguments->has_next_expression ? arguments->next_arguments : NULL;
+		if (!(arguments->is_empty)) {
+			mcc_ast_delete_expression(arguments->expression);
 		}
-		previous = program;
-		program = program->next_function;
+		mcc_free(MCC_ALLOC_AST_NODE, arguments);
+		arguments = next;
 	}
-	return head;
 }
 
 // ------------------------------------------------------------------- Transforming the complete AST
@@ -1005,7 +935,7 @@ struct mcc_parser_result *mcc_ast_limit_result_to_function(struct mcc_parser_res
 	// RECOMMENDED USE: call it like this: 		ptr = limit_result_to_function_scope(ptr,function_name)
 
 	// New struct mcc_parser_result that will be returned
-	struct mcc_parser_result *new_result = malloc(sizeof(struct mcc_parser_result));
+	struct mcc_parser_result *new_result = mcc_malloc(MCC_ALLOC_OTHER, sizeof(struct mcc_parser_result));
 	if (!new_result) {
 		return NULL;
 	}
@@ -1039,7 +969,7 @@ struct mcc_parser_result *mcc_ast_limit_result_to_function(struct mcc_parser_res
 		// check if wanted function is found
 		if (strcmp(wanted_function_name, cur_program->function->identifier->identifier_name) == 0) {
 			if (!found_function) {
-				free(new_result);
+				mcc_free(MCC_ALLOC_OTHER, new_result);
 				return NULL;
 			} else {
 				right_function = cur_program;
@@ -1071,7 +1001,7 @@ struct mcc_parser_result *mcc_ast_limit_result_to_function(struct mcc_parser_res
 
 		return new_result;
 	} else {
-		free(new_result);
+		mcc_free(MCC_ALLOC_OTHER, new_result);
 		return NULL;
 	}
 }
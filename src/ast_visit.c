@@ -1,6 +1,11 @@
 #include "mcc/ast_visit.h"
 
 #include <assert.h>
+#include <stdlib.h>
+
+#include "mcc/alloc.h"
+
+#define INITIAL_CAPACITY 64
 
 #define visit(node, callback, visitor) \
 	if (callback) { \
@@ -18,144 +23,193 @@
 #define visit_if_post_order(node, callback, visitor) \
 	visit_if((visitor)->order == MCC_AST_VISIT_POST_ORDER, node, callback, visitor)
 
-void mcc_ast_visit_expression(struct mcc_ast_expression *expression, struct mcc_ast_visitor *visitor)
+//---------------------------------------------------------------------------------------- Explicit stack
+
+// The traversal keeps pending work on a heap stack instead of the native one: nodes still to be entered, and nodes
+// whose post-order callbacks are due once their children are done. Children are pushed in reverse, so they are popped
+// in the order the callbacks expect. Sibling chains are pushed one link at a time, which keeps the stack small in
+// pre-order; in post-order it holds one pending entry per open node.
+
+enum visit_kind {
+	VISIT_EXPRESSION,
+	VISIT_STATEMENT,
+	VISIT_COMPOUND_STATEMENT,
+	VISIT_LITERAL,
+	VISIT_DECLARATION,
+	VISIT_ASSIGNMENT,
+	VISIT_TYPE,
+	VISIT_IDENTIFIER,
+	VISIT_FUNCTION_DEFINITION,
+	VISIT_PARAMETERS,
+	VISIT_ARGUMENTS,
+	VISIT_PROGRAM,
+};
+
+struct visit_item {
+	enum visit_kind kind;
+	bool is_leaving;
+	void *node;
+};
+
+struct visit_stack {
+	size_t size;
+	size_t capacity;
+	struct visit_item *items;
+	bool has_failed;
+};
+
+static void push_item(struct visit_stack *stack, enum visit_kind kind, bool is_leaving, void *node)
+{
+	if (stack->has_failed)
+		return;
+	if (stack->size == stack->capacity) {
+		size_t capacity = stack->capacity ? 2 * stack->capacity : INITIAL_CAPACITY;
+		struct visit_item *items = mcc_realloc(MCC_ALLOC_OTHER, stack->items, capacity * sizeof(*items));
+		if (!items) {
+			stack->has_failed = true;
+			return;
+		}
+		stack->items = items;
+		stack->capacity = capacity;
+	}
+	stack->items[stack->size++] = (struct visit_item){.kind = kind, .is_leaving = is_leaving, .node = node};
+}
+
+// Schedule a child to be entered
+#define push(stack, kind, node) push_item(stack, kind, false, node)
+
+// Schedule the post-order callbacks of a node, to run after everything pushed afterwards
+#define push_leave(stack, kind, node, visitor) \
+	if ((visitor)->order == MCC_AST_VISIT_POST_ORDER) { \
+		push_item(stack, kind, true, node); \
+	}
+
+//---------------------------------------------------------------------------------------- Entering nodes
+
+static void enter_expression(struct mcc_ast_expression *expression,
+                             struct mcc_ast_visitor *visitor,
+                             struct visit_stack *stack)
 {
 	assert(expression);
-	assert(visitor);
 
 	visit_if_pre_order(expression, visitor->expression, visitor);
+	push_leave(stack, VISIT_EXPRESSION, expression, visitor);
 
 	switch (expression->type) {
 	case MCC_AST_EXPRESSION_TYPE_LITERAL:
 		visit_if_pre_order(expression, visitor->expression_literal, visitor);
-		mcc_ast_visit(expression->literal, visitor);
-		visit_if_post_order(expression, visitor->expression_literal, visitor);
+		push(stack, VISIT_LITERAL, expression->literal);
 		break;
 
 	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
 		visit_if_pre_order(expression, visitor->expression_binary_op, visitor);
-		mcc_ast_visit(expression->lhs, visitor);
-		mcc_ast_visit(expression->rhs, visitor);
-		visit_if_post_order(expression, visitor->expression_binary_op, visitor);
+		push(stack, VISIT_EXPRESSION, expression->rhs);
+		push(stack, VISIT_EXPRESSION, expression->lhs);
 		break;
 
 	case MCC_AST_EXPRESSION_TYPE_PARENTH:
 		visit_if_pre_order(expression, visitor->expression_parenth, visitor);
-		mcc_ast_visit(expression->expression, visitor);
-		visit_if_post_order(expression, visitor->expression_parenth, visitor);
+		push(stack, VISIT_EXPRESSION, expression->expression);
 		break;
 
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
 		visit_if_pre_order(expression, visitor->expression_unary_op, visitor);
-		mcc_ast_visit(expression->child, visitor);
-		visit_if_post_order(expression, visitor->expression_unary_op, visitor);
+		push(stack, VISIT_EXPRESSION, expression->child);
 		break;
 
 	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
 		visit_if_pre_order(expression, visitor->expression_variable, visitor);
-		mcc_ast_visit(expression->identifier, visitor);
-		visit_if_post_order(expression, visitor->expression_variable, visitor);
+		push(stack, VISIT_IDENTIFIER, expression->identifier);
 		break;
 
 	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
 		visit_if_pre_order(expression, visitor->expression_array_element, visitor);
-		mcc_ast_visit(expression->array_identifier, visitor);
-		mcc_ast_visit(expression->index, visitor);
-		visit_if_post_order(expression, visitor->expression_array_element, visitor);
+		push(stack, VISIT_EXPRESSION, expression->index);
+		push(stack, VISIT_IDENTIFIER, expression->array_identifier);
 		break;
 	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
 		visit_if_pre_order(expression, visitor->expression_function_call, visitor);
-		mcc_ast_visit(expression->function_identifier, visitor);
 		if (!expression->arguments->is_empty) {
-			mcc_ast_visit(expression->arguments, visitor);
+			push(stack, VISIT_ARGUMENTS, expression->arguments);
 		}
-		visit_if_post_order(expression, visitor->expression_function_call, visitor);
+		push(stack, VISIT_IDENTIFIER, expression->function_identifier);
+		break;
 	}
-
-	visit_if_post_order(expression, visitor->expression, visitor);
 }
 
-void mcc_ast_visit_statement(struct mcc_ast_statement *statement, struct mcc_ast_visitor *visitor)
+static void enter_statement(struct mcc_ast_statement *statement,
+                            struct mcc_ast_visitor *visitor,
+                            struct visit_stack *stack)
 {
 	assert(statement);
-	assert(visitor);
 
 	visit_if_pre_order(statement, visitor->statement, visitor);
+	push_leave(stack, VISIT_STATEMENT, statement, visitor);
 
 	switch (statement->type) {
 	case MCC_AST_STATEMENT_TYPE_IF_STMT:
 		visit_if_pre_order(statement, visitor->statement_if_stmt, visitor);
-		mcc_ast_visit(statement->if_condition, visitor);
-		mcc_ast_visit(statement->if_on_true, visitor);
-		visit_if_post_order(statement, visitor->statement_if_stmt, visitor);
+		push(stack, VISIT_STATEMENT, statement->if_on_true);
+		push(stack, VISIT_EXPRESSION, statement->if_condition);
 		break;
 	case MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT:
 		visit_if_pre_order(statement, visitor->statement_if_else_stmt, visitor);
-		mcc_ast_visit(statement->if_else_condition, visitor);
-		mcc_ast_visit(statement->if_else_on_true, visitor);
-		mcc_ast_visit(statement->if_else_on_false, visitor);
-		visit_if_post_order(statement, visitor->statement_if_else_stmt, visitor);
+		push(stack, VISIT_STATEMENT, statement->if_else_on_false);
+		push(stack, VISIT_STATEMENT, statement->if_else_on_true);
+		push(stack, VISIT_EXPRESSION, statement->if_else_condition);
 		break;
 	case MCC_AST_STATEMENT_TYPE_EXPRESSION:
 		visit_if_pre_order(statement, visitor->statement_expression_stmt, visitor);
-		mcc_ast_visit(statement->stmt_expression, visitor);
-		visit_if_post_order(statement, visitor->statement_expression_stmt, visitor);
+		push(stack, VISIT_EXPRESSION, statement->stmt_expression);
 		break;
 	case MCC_AST_STATEMENT_TYPE_WHILE:
 		visit_if_pre_order(statement, visitor->statement_while, visitor);
-		mcc_ast_visit(statement->while_condition, visitor);
-		mcc_ast_visit(statement->while_on_true, visitor);
-		visit_if_post_order(statement, visitor->statement_while, visitor);
+		push(stack, VISIT_STATEMENT, statement->while_on_true);
+		push(stack, VISIT_EXPRESSION, statement->while_condition);
 		break;
 	case MCC_AST_STATEMENT_TYPE_DECLARATION:
 		visit_if_pre_order(statement, visitor->statement_declaration, visitor);
-		mcc_ast_visit(statement->declaration, visitor);
-		visit_if_post_order(statement, visitor->statement_declaration, visitor);
+		push(stack, VISIT_DECLARATION, statement->declaration);
 		break;
 	case MCC_AST_STATEMENT_TYPE_ASSIGNMENT:
 		visit_if_pre_order(statement, visitor->statement_assignment, visitor);
-		mcc_ast_visit(statement->assignment, visitor);
-		visit_if_post_order(statement, visitor->statement_assignment, visitor);
+		push(stack, VISIT_ASSIGNMENT, statement->assignment);
 		break;
 	case MCC_AST_STATEMENT_TYPE_RETURN:
 		visit_if_pre_order(statement, visitor->statement_return, visitor);
 		if (!(statement->is_empty_return)) {
-			mcc_ast_visit(statement->return_value, visitor);
+			push(stack, VISIT_EXPRESSION, statement->return_value);
 		}
-		visit_if_post_order(statement, visitor->statement_return, visitor);
 		break;
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
 		visit_if_pre_order(statement, visitor->statement_compound_stmt, visitor);
-		mcc_ast_visit(statement->compound_statement, visitor);
-		visit_if_post_order(statement, visitor->statement_compound_stmt, visitor);
+		push(stack, VISIT_COMPOUND_STATEMENT, statement->compound_statement);
 		break;
 	}
-
-	visit_if_post_order(statement, visitor->statement, visitor);
 }
 
-void mcc_ast_visit_compound_statement(struct mcc_ast_compound_statement *compound_statement,
-                                      struct mcc_ast_visitor *visitor)
+static void enter_compound_statement(struct mcc_ast_compound_statement *compound_statement,
+                                     struct mcc_ast_visitor *visitor,
+                                     struct visit_stack *stack)
 {
 	assert(compound_statement);
-	assert(visitor);
 
 	visit_if_pre_order(compound_statement, visitor->compound_statement, visitor);
-	if (!compound_statement->is_empty) {
-		mcc_ast_visit(compound_statement->statement, visitor);
-	}
+	push_leave(stack, VISIT_COMPOUND_STATEMENT, compound_statement, visitor);
 	if (compound_statement->has_next_statement) {
-		mcc_ast_visit(compound_statement->next_compound_statement, visitor);
+		push(stack, VISIT_COMPOUND_STATEMENT, compound_statement->next_compound_statement);
+	}
+	if (!compound_statement->is_empty) {
+		push(stack, VISIT_STATEMENT, compound_statement->statement);
 	}
-	visit_if_post_order(compound_statement, visitor->compound_statement, visitor);
 }
 
-void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor)
+static void enter_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor, struct visit_stack *stack)
 {
 	assert(literal);
-	assert(visitor);
 
 	visit_if_pre_order(literal, visitor->literal, visitor);
+	push_leave(stack, VISIT_LITERAL, literal, visitor);
 
 	switch (literal->type) {
 	case MCC_AST_LITERAL_TYPE_INT:
@@ -171,124 +225,367 @@ void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visit
 		visit(literal, visitor->literal_string, visitor);
 		break;
 	}
-
-	visit_if_post_order(literal, visitor->literal, visitor);
 }
 
-void mcc_ast_visit_declaration(struct mcc_ast_declaration *declaration, struct mcc_ast_visitor *visitor)
+static void enter_declaration(struct mcc_ast_declaration *declaration,
+                              struct mcc_ast_visitor *visitor,
+                              struct visit_stack *stack)
 {
 	assert(declaration);
-	assert(visitor);
+
+	push_leave(stack, VISIT_DECLARATION, declaration, visitor);
 
 	switch (declaration->declaration_type) {
 	case MCC_AST_DECLARATION_TYPE_VARIABLE:
 		visit_if_pre_order(declaration, visitor->variable_declaration, visitor);
-		mcc_ast_visit(declaration->variable_type, visitor);
-		mcc_ast_visit(declaration->variable_identifier, visitor);
-		visit_if_post_order(declaration, visitor->variable_declaration, visitor);
+		push(stack, VISIT_IDENTIFIER, declaration->variable_identifier);
+		push(stack, VISIT_TYPE, declaration->variable_type);
 		break;
 	case MCC_AST_DECLARATION_TYPE_ARRAY:
 		visit_if_pre_order(declaration, visitor->array_declaration, visitor);
-		mcc_ast_visit(declaration->array_type, visitor);
-		mcc_ast_visit(declaration->array_size, visitor);
-		mcc_ast_visit(declaration->array_identifier, visitor);
-		visit_if_post_order(declaration, visitor->array_declaration, visitor);
+		push(stack, VISIT_IDENTIFIER, declaration->array_identifier);
+		push(stack, VISIT_LITERAL, declaration->array_size);
+		push(stack, VISIT_TYPE, declaration->array_type);
 		break;
 	}
 }
 
-void mcc_ast_visit_assignment(struct mcc_ast_assignment *assignment, struct mcc_ast_visitor *visitor)
+static void enter_assignment(struct mcc_ast_assignment *assignment,
+                             struct mcc_ast_visitor *visitor,
+                             struct visit_stack *stack)
 {
 	assert(assignment);
-	assert(visitor);
+
+	push_leave(stack, VISIT_ASSIGNMENT, assignment, visitor);
 
 	switch (assignment->assignment_type) {
 	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
 		visit_if_pre_order(assignment, visitor->variable_assignment, visitor);
-		mcc_ast_visit(assignment->variable_identifier, visitor);
-		mcc_ast_visit(assignment->variable_assigned_value, visitor);
-		visit_if_post_order(assignment, visitor->variable_assignment, visitor);
+		push(stack, VISIT_EXPRESSION, assignment->variable_assigned_value);
+		push(stack, VISIT_IDENTIFIER, assignment->variable_identifier);
 		break;
 	case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
 		visit_if_pre_order(assignment, visitor->array_assignment, visitor);
-		mcc_ast_visit(assignment->array_identifier, visitor);
-		mcc_ast_visit(assignment->array_index, visitor);
-		mcc_ast_visit(assignment->array_assigned_value, visitor);
-		visit_if_post_order(assignment, visitor->array_assignment, visitor);
+		push(stack, VISIT_EXPRESSION, assignment->array_assigned_value);
+		push(stack, VISIT_EXPRESSION, assignment->array_index);
+		push(stack, VISIT_IDENTIFIER, assignment->array_identifier);
 		break;
 	}
 }
 
-void mcc_ast_visit_type(struct mcc_ast_type *type, struct mcc_ast_visitor *visitor)
-{
-	assert(type);
-	assert(visitor);
-
-	visit(type, visitor->type, visitor);
-}
-
-void mcc_ast_visit_identifier(struct mcc_ast_identifier *identifier, struct mcc_ast_visitor *visitor)
-{
-	assert(identifier);
-	assert(visitor);
-
-	visit(identifier, visitor->identifier, visitor);
-}
-
-void mcc_ast_visit_function_definition(struct mcc_ast_function_definition *function_definition,
-                                       struct mcc_ast_visitor *visitor)
+static void enter_function_definition(struct mcc_ast_function_definition *function_definition,
+                                      struct mcc_ast_visitor *visitor,
+                                      struct visit_stack *stack)
 {
 	assert(function_definition);
-	assert(visitor);
 
 	visit_if_pre_order(function_definition, visitor->function_definition, visitor);
-	mcc_ast_visit(function_definition->identifier, visitor);
-	mcc_ast_visit(function_definition->parameters, visitor);
-	mcc_ast_visit(function_definition->compound_stmt, visitor);
-	visit_if_post_order(function_definition, visitor->function_definition, visitor);
+	push_leave(stack, VISIT_FUNCTION_DEFINITION, function_definition, visitor);
+	push(stack, VISIT_COMPOUND_STATEMENT, function_definition->compound_stmt);
+	push(stack, VISIT_PARAMETERS, function_definition->parameters);
+	push(stack, VISIT_IDENTIFIER, function_definition->identifier);
 }
 
-void mcc_ast_visit_parameters(struct mcc_ast_parameters *parameters, struct mcc_ast_visitor *visitor)
+static void enter_parameters(struct mcc_ast_parameters *parameters,
+                             struct mcc_ast_visitor *visitor,
+                             struct visit_stack *stack)
 {
 	assert(parameters);
-	assert(visitor);
 
 	visit_if_pre_order(parameters, visitor->parameters, visitor);
-	if (parameters->has_next_parameter) {
-		mcc_ast_visit(parameters->next_parameters, visitor);
-	}
+	push_leave(stack, VISIT_PARAMETERS, parameters, visitor);
+	// The following parameters are visited before the declaration
 	if (!(parameters->is_empty)) {
-		mcc_ast_visit(parameters->declaration, visitor);
+		push(stack, VISIT_DECLARATION, parameters->declaration);
+	}
+	if (parameters->has_next_parameter) {
+		push(stack, VISIT_PARAMETERS, parameters->next_parameters);
 	}
-	visit_if_post_order(parameters, visitor->parameters, visitor);
 }
 
-void mcc_ast_visit_arguments(struct mcc_ast_arguments *arguments, struct mcc_ast_visitor *visitor)
+static void enter_arguments(struct mcc_ast_arguments *arguments,
+                            struct mcc_ast_visitor *visitor,
+                            struct visit_stack *stack)
 {
 	assert(arguments);
-	assert(visitor);
 
 	visit_if_pre_order(arguments, visitor->arguments, visitor);
-	mcc_ast_visit(arguments->expression, visitor);
+	push_leave(stack, VISIT_ARGUMENTS, arguments, visitor);
 	if (arguments->has_next_expression == true) {
-		mcc_ast_visit(arguments->next_arguments, visitor);
+		push(stack, VISIT_ARGUMENTS, arguments->next_arguments);
 	}
-	visit_if_post_order(arguments, visitor->arguments, visitor);
+	push(stack, VISIT_EXPRESSION, arguments->expression);
 }
 
-void mcc_ast_visit_program(struct mcc_ast_program *program, struct mcc_ast_visitor *visitor)
+static void enter_program(struct mcc_ast_program *program, struct mcc_ast_visitor *visitor, struct visit_stack *stack)
 {
 	assert(program);
-	assert(visitor);
 
 	visit_if_pre_order(program, visitor->program, visitor);
+	// An empty program has no post-order callback
 	if (!program->function) {
 		return;
 	}
-	mcc_ast_visit(program->function, visitor);
+	push_leave(stack, VISIT_PROGRAM, program, visitor);
 	if (program->has_next_function) {
-		mcc_ast_visit(program->next_function, visitor);
+		push(stack, VISIT_PROGRAM, program->next_function);
+	}
+	push(stack, VISIT_FUNCTION_DEFINITION, program->function);
+}
+
+static void enter(struct visit_item item, struct mcc_ast_visitor *visitor, struct visit_stack *stack)
+{
+	switch (item.kind) {
+	case VISIT_EXPRESSION:
+		enter_expression(item.node, visitor, stack);
+		break;
+	case VISIT_STATEMENT:
+		enter_statement(item.node, visitor, stack);
+		break;
+	case VISIT_COMPOUND_STATEMENT:
+		enter_compound_statement(item.node, visitor, stack);
+		break;
+	case VISIT_LITERAL:
+		enter_literal(item.node, visitor, stack);
+		break;
+	case VISIT_DECLARATION:
+		enter_declaration(item.node, visitor, stack);
+		break;
+	case VISIT_ASSIGNMENT:
+		enter_assignment(item.node, visitor, stack);
+		break;
+	case VISIT_TYPE:
+		assert(item.node);
+		visit((struct mcc_ast_type *)item.node, visitor->type, visitor);
+		break;
+	case VISIT_IDENTIFIER:
+		assert(item.node);
+		visit((struct mcc_ast_identifier *)item.node, visitor->identifier, visitor);
+		break;
+	case VISIT_FUNCTION_DEFINITION:
+		enter_function_definition(item.node, visitor, stack);
+		break;
+	case VISIT_PARAMETERS:
+		enter_parameters(item.node, visitor, stack);
+		break;
+	case VISIT_ARGUMENTS:
+		enter_arguments(item.node, visitor, stack);
+		break;
+	case VISIT_PROGRAM:
+		enter_program(item.node, visitor, stack);
+		break;
+	}
+}
+
+//---------------------------------------------------------------------------------------- Leaving nodes
+
+static void leave_expression(struct mcc_ast_expression *expression, struct mcc_ast_visitor *visitor)
+{
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_LITERAL:
+		visit(expression, visitor->expression_literal, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
+		visit(expression, visitor->expression_binary_op, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_PARENTH:
+		visit(expression, visitor->expression_parenth, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+		visit(expression, visitor->expression_unary_op, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
+		visit(expression, visitor->expression_variable, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		visit(expression, visitor->expression_array_element, visitor);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+		visit(expression, visitor->expression_function_call, visitor);
+		break;
+	}
+
+	visit(expression, visitor->expression, visitor);
+}
+
+static void leave_statement(struct mcc_ast_statement *statement, struct mcc_ast_visitor *visitor)
+{
+	switch (statement->type) {
+	case MCC_AST_STATEMENT_TYPE_IF_STMT:
+		visit(statement, visitor->statement_if_stmt, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_IF_ELSE_STMT:
+		visit(statement, visitor->statement_if_else_stmt, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_EXPRESSION:
+		visit(statement, visitor->statement_expression_stmt, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_WHILE:
+		visit(statement, visitor->statement_while, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_DECLARATION:
+		visit(statement, visitor->statement_declaration, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_ASSIGNMENT:
+		visit(statement, visitor->statement_assignment, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_RETURN:
+		visit(statement, visitor->statement_return, visitor);
+		break;
+	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
+		visit(statement, visitor->statement_compound_stmt, visitor);
+		break;
 	}
-	visit_if_post_order(program, visitor->program, visitor);
+
+	visit(statement, visitor->statement, visitor);
 }
 
+static void leave_declaration(struct mcc_ast_declaration *declaration, struct mcc_ast_visitor *visitor)
+{
+	switch (declaration->declaration_type) {
+	case MCC_AST_DECLARATION_TYPE_VARIABLE:
+		visit(declaration, visitor->variable_declaration, visitor);
+		break;
+	case MCC_AST_DECLARATION_TYPE_ARRAY:
+		visit(declaration, visitor->array_declaration, visitor);
+		break;
+	}
+}
+
+static void leave_assignment(struct mcc_ast_assignment *assignment, struct mcc_ast_visitor *visitor)
+{
+	switch (assignment->assignment_type) {
+	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
+		visit(assignment, visitor->variable_assignment, visitor);
+		break;
+	case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
+		visit(assignment, visitor->array_assignment, visitor);
+		break;
+	}
+}
+
+// Only pushed in post-order, so the post-order callbacks are called unconditionally
+static void leave(struct visit_item item, struct mcc_ast_visitor *visitor)
+{
+	switch (item.kind) {
+	case VISIT_EXPRESSION:
+		leave_expression(item.node, visitor);
+		break;
+	case VISIT_STATEMENT:
+		leave_statement(item.node, visitor);
+		break;
+	case VISIT_COMPOUND_STATEMENT:
+		visit((struct mcc_ast_compound_statement *)item.node, visitor->compound_statement, visitor);
+		break;
+	case VISIT_LITERAL:
+		visit((struct mcc_ast_literal *)item.node, visitor->literal, visitor);
+		break;
+	case VISIT_DECLARATION:
+		leave_declaration(item.node, visitor);
+		break;
+	case VISIT_ASSIGNMENT:
+		leave_assignment(item.node, visitor);
+		break;
+	case VISIT_FUNCTION_DEFINITION:
+		visit((struct mcc_ast_function_definition *)item.node, visitor->function_definition, visitor);
+		break;
+	case VISIT_PARAMETERS:
+		visit((struct mcc_ast_parameters *)item.node, visitor->parameters, visitor);
+		break;
+	case VISIT_ARGUMENTS:
+		visit((struct mcc_ast_arguments *)item.node, visitor->arguments, visitor);
+		break;
+	case VISIT_PROGRAM:
+		visit((struct mcc_ast_program *)item.node, visitor->program, visitor);
+		break;
+	case VISIT_TYPE:
+	case VISIT_IDENTIFIER:
+		// No post-order callbacks
+		break;
+	}
+}
+
+//---------------------------------------------------------------------------------------- Traversal
+
+static void traverse(enum visit_kind kind, void *node, struct mcc_ast_visitor *visitor)
+{
+	assert(node);
+	assert(visitor);
+
+	struct visit_stack stack = {.size = 0, .capacity = 0, .items = NULL, .has_failed = false};
+	push(&stack, kind, node);
+	while (stack.size > 0 && !stack.has_failed) {
+		struct visit_item item = stack.items[--stack.size];
+		if (item.is_leaving) {
+			leave(item, visitor);
+		} else {
+			enter(item, visitor, &stack);
+		}
+	}
+	if (stack.has_failed) {
+		visitor->has_failed = true;
+	}
+	mcc_free(MCC_ALLOC_OTHER, stack.items);
+}
+
+void mcc_ast_visit_expression(struct mcc_ast_expression *expression, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_EXPRESSION, expression, visitor);
+}
+
+void mcc_ast_visit_statement(struct mcc_ast_statement *statement, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_STATEMENT, statement, visitor);
+}
+
+void mcc_ast_visit_compound_statement(struct mcc_ast_compound_statement *compound_statement,
+                                      struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_COMPOUND_STATEMENT, compound_statement, visitor);
+}
+
+void mcc_ast_visit_literal(struct mcc_ast_literal *literal, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_LITERAL, literal, visitor);
+}
+
+void mcc_ast_visit_declaration(struct mcc_ast_declaration *declaration, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_DECLARATION, declaration, visitor);
+}
+
+void mcc_ast_visit_assignment(struct mcc_ast_assignment *assignment, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_ASSIGNMENT, assignment, visitor);
+}
+
+void mcc_ast_visit_type(struct mcc_ast_type *type, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_TYPE, type, visitor);
+}
+
+void mcc_ast_visit_identifier(struct mcc_ast_identifier *identifier, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_IDENTIFIER, identifier, visitor);
+}
+
+void mcc_ast_visit_function_definition(struct mcc_ast_function_definition *function_definition,
+                                       struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_FUNCTION_DEFINITION, function_definition, visitor);
+}
+
+void mcc_ast_visit_parameters(struct mcc_ast_parameters *parameters, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_PARAMETERS, parameters, visitor);
+}
+
+void mcc_ast_visit_arguments(struct mcc_ast_arguments *arguments, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_ARGUMENTS, arguments, visitor);
+}
+
+void mcc_ast_visit_program(struct mcc_ast_program *program, struct mcc_ast_visitor *visitor)
+{
+	traverse(VISIT_PROGRAM, program, visitor);
+}
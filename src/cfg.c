@@ -5,37 +5,9 @@
 #include <stdlib.h>
 #include <string.h>
 
-//---------------------------------------------------------------------------------------- Annotate IR with leaders
-
-// Annotate IR to determine leaders
-struct annotated_ir {
-	bool is_leader;
-	struct annotated_ir *next;
-	struct annotated_ir *prev;
-	struct mcc_ir_row *row;
-};
-
-static struct annotated_ir *new_annotated_ir(struct mcc_ir_row *row, bool is_leader)
-{
-	assert(row);
-	struct annotated_ir *ir = malloc(sizeof(*ir));
-	if (!ir)
-		return NULL;
-	ir->is_leader = is_leader;
-	ir->row = row;
-	ir->next = NULL;
-	ir->prev = NULL;
-	return ir;
-}
-
-static void delete_annotated_ir(struct annotated_ir *head)
-{
-	if (!head)
-		return;
+#include "mcc/alloc.h"
 
-	delete_annotated_ir(head->next);
-	free(head);
-}
+//---------------------------------------------------------------------------------------- Leaders
 
 static bool is_leader(enum mcc_ir_instruction current, enum mcc_ir_instruction previous)
 {
@@ -57,283 +29,253 @@ static bool is_leader(enum mcc_ir_instruction current, enum mcc_ir_instruction p
 	return false;
 }
 
-static struct annotated_ir *annotate_ir(struct mcc_ir_row *head)
+static bool is_function_label(struct mcc_basic_block *block)
 {
-	assert(head);
-	struct annotated_ir *head_an = new_annotated_ir(head, true);
-	if (!head_an)
-		return NULL;
-	struct annotated_ir *first_an = head_an;
-	struct annotated_ir *temp;
-	head = head->next_row;
+	return block->leader->instr == MCC_IR_INSTR_FUNC_LABEL;
+}
 
-	while (head) {
-		if (is_leader(head->instr, head_an->row->instr)) {
-			temp = new_annotated_ir(head, true);
-		} else {
-			temp = new_annotated_ir(head, false);
-		}
-		if (!temp) {
-			delete_annotated_ir(first_an);
-			return NULL;
-		}
-		head_an->next = temp;
-		temp->prev = head_an;
-		head_an = temp;
-		head = head->next_row;
-		continue;
-	}
-	return first_an;
+static void set_successors(struct mcc_basic_block *block)
+{
+	block->num_successors = 0;
+	if (block->child_left)
+		block->successors[block->num_successors++] = block->child_left;
+	if (block->child_right && block->child_right != block->child_left)
+		block->successors[block->num_successors++] = block->child_right;
 }
 
 //---------------------------------------------------------------------------------------- Functions: CFG
 
-// Truncate IR before the next leader
-static void truncate_ir_in_BB(struct mcc_ir_row *head)
+// Blocks of the CFG in IR order, and the block starting with each label
+struct cfg_builder {
+	unsigned num_blocks;
+	struct mcc_basic_block **blocks;
+	unsigned num_labels;
+	struct mcc_basic_block **labels;
+};
+
+static void delete_cfg(struct mcc_basic_block *head)
 {
-	assert(head);
-	struct mcc_ir_row *previous = head;
-	head = head->next_row;
 	while (head) {
-		if (is_leader(head->instr, previous->instr)) {
-			previous->next_row = NULL;
-			head->prev_row = NULL;
-		}
-		previous = head;
-		head = head->next_row;
+		struct mcc_basic_block *next = head->next;
+		mcc_free(MCC_ALLOC_CFG, head->predecessors);
+		mcc_free(MCC_ALLOC_CFG, head);
+		head = next;
 	}
 }
 
-// Truncate IR in entire CFG
-static void truncate_ir(struct mcc_basic_block *head)
-{
-	if (!head)
-		return;
-	truncate_ir(head->next);
-	truncate_ir_in_BB(head->leader);
-}
-
-static struct mcc_ir_row *get_last_row(struct mcc_basic_block *head)
+// Count blocks and labels, so that both can be kept in arrays
+static void count_blocks(struct mcc_ir_row *ir, struct cfg_builder *builder)
 {
-	assert(head);
-	struct mcc_ir_row *ir_head = head->leader;
-	struct mcc_ir_row *previous = ir_head;
-	ir_head = ir_head->next_row;
-	while (ir_head) {
-		if (is_leader(ir_head->instr, previous->instr)) {
-			break;
-		}
-		previous = ir_head;
-		ir_head = ir_head->next_row;
+	builder->num_blocks = 1;
+	builder->num_labels = 0;
+	for (struct mcc_ir_row *row = ir; row; row = row->next_row) {
+		if (row->prev_row && is_leader(row->instr, row->prev_row->instr))
+			builder->num_blocks++;
+		if (row->instr == MCC_IR_INSTR_LABEL && row->arg1->label >= builder->num_labels)
+			builder->num_labels = row->arg1->label + 1;
 	}
-	return previous;
 }
 
-static bool row_is_target_label(struct mcc_ir_row *row, unsigned label)
+// Put all basic block leaders into their own BB. Link them to a single linear chain of BBs with the "next" field
+static bool get_basic_blocks(struct mcc_ir_row *ir, struct cfg_builder *builder)
 {
-	assert(row);
-	if (row->instr == MCC_IR_INSTR_LABEL) {
-		if (row->arg1->label == label) {
-			return true;
+	unsigned id = 0;
+	struct mcc_basic_block *previous = NULL;
+	for (struct mcc_ir_row *row = ir; row; row = row->next_row) {
+		if (row != ir && !is_leader(row->instr, row->prev_row->instr))
+			continue;
+
+		struct mcc_basic_block *block = mcc_cfg_new_basic_block(row, NULL, NULL);
+		if (!block) {
+			delete_cfg(id > 0 ? builder->blocks[0] : NULL);
+			return false;
 		}
+		block->id = id;
+		builder->blocks[id++] = block;
+		if (previous)
+			previous->next = block;
+		previous = block;
+
+		if (row->instr == MCC_IR_INSTR_LABEL)
+			builder->labels[row->arg1->label] = block;
 	}
-	return false;
-}
-
-static bool jump_target_is_in_bb(struct mcc_ir_row *jump_row, struct mcc_basic_block *block)
-{
-	struct mcc_ir_row *head = block->leader;
-	int target_label;
-	if (jump_row->instr == MCC_IR_INSTR_JUMP) {
-		target_label = jump_row->arg1->label;
-	} else if (jump_row->instr == MCC_IR_INSTR_JUMPFALSE) {
-		target_label = jump_row->arg2->label;
-	} else {
-		return false;
-	}
-
-	if (row_is_target_label(head, target_label))
-		return true;
-
-	return false;
+	return true;
 }
 
-static struct mcc_basic_block *get_bb_jump_target(struct mcc_ir_row *jump_row, struct mcc_basic_block *head)
+static struct mcc_basic_block *get_label_block(unsigned label, struct cfg_builder *builder)
 {
-	if (!head)
+	if (label >= builder->num_labels)
 		return NULL;
-	if (jump_target_is_in_bb(jump_row, head))
-		return head;
-	struct mcc_basic_block *next = get_bb_jump_target(jump_row, head->next);
-	if (next)
-		return next;
-	return NULL;
+	return builder->labels[label];
 }
 
-// Set children for one basic block
-static void set_children(struct mcc_basic_block *head, struct mcc_basic_block *first)
+// Set children for one basic block, given the last row of its IR
+static void set_children(struct mcc_basic_block *block, struct mcc_ir_row *last_row, struct cfg_builder *builder)
 {
-	assert(head);
-	assert(first);
-	struct mcc_ir_row *last_row = get_last_row(head);
-
 	switch (last_row->instr) {
 	case MCC_IR_INSTR_JUMP:
-		head->child_left = NULL;
-		head->child_right = get_bb_jump_target(last_row, first);
-		return;
+		block->child_left = NULL;
+		block->child_right = get_label_block(last_row->arg1->label, builder);
+		break;
 	case MCC_IR_INSTR_JUMPFALSE:
 		// After the jump, the next IR line is given from the linear IR
-		if (head->next) {
-			head->child_left = head->next;
-		} else {
-			head->child_left = NULL;
-		}
-		head->child_right = get_bb_jump_target(last_row, first);
-		return;
+		block->child_left = block->next;
+		block->child_right = get_label_block(last_row->arg2->label, builder);
+		break;
 	case MCC_IR_INSTR_RETURN:
-		head->child_left = NULL;
-		head->child_right = NULL;
-		return;
+		block->child_left = NULL;
+		block->child_right = NULL;
+		break;
 	default:
-		if (head->next) {
-			head->child_right = head->next;
-		} else {
-			head->child_right = NULL;
-		}
-		return;
+		block->child_left = NULL;
+		block->child_right = block->next;
+		break;
 	}
-}
 
-// Transform linear cfg into directed graph
-static void sort_cfg(struct mcc_basic_block *head, struct mcc_basic_block *first)
-{
-	assert(first);
-	if (!head)
-		return;
-	sort_cfg(head->next, first);
-	set_children(head, first);
+	set_successors(block);
 }
 
-static void mcc_delete_cfg(struct mcc_basic_block *head)
+static bool set_predecessors(struct cfg_builder *builder)
 {
-	if (!head)
-		return;
-	mcc_delete_cfg(head->next);
-	free(head);
+	for (unsigned i = 0; i < builder->num_blocks; i++) {
+		struct mcc_basic_block *block = builder->blocks[i];
+		for (unsigned j = 0; j < block->num_successors; j++) {
+			block->successors[j]->num_predecessors++;
+		}
+	}
+	for (unsigned i = 0; i < builder->num_blocks; i++) {
+		struct mcc_basic_block *block = builder->blocks[i];
+		if (block->num_predecessors == 0)
+			continue;
+		block->predecessors = mcc_malloc(MCC_ALLOC_CFG, block->num_predecessors * sizeof(*block->predecessors));
+		if (!block->predecessors)
+			return false;
+		block->num_predecessors = 0;
+	}
+	for (unsigned i = 0; i < builder->num_blocks; i++) {
+		struct mcc_basic_block *block = builder->blocks[i];
+		for (unsigned j = 0; j < block->num_successors; j++) {
+			struct mcc_basic_block *successor = block->successors[j];
+			successor->predecessors[successor->num_predecessors++] = block;
+		}
+	}
+	return true;
 }
 
-// Put all basic block leaders into their own BB. Link them to a single linear chain of BBs with the "next" field
-static struct mcc_basic_block *get_basic_blocks(struct annotated_ir *an_ir)
+static struct mcc_basic_block *generate_cfg(struct mcc_ir_row *ir)
 {
-	struct mcc_basic_block *bb_first = mcc_cfg_new_basic_block(an_ir->row, NULL, NULL);
-	if (!bb_first) {
+
+	struct cfg_builder builder;
+	count_blocks(ir, &builder);
+	builder.blocks = mcc_malloc(MCC_ALLOC_OTHER, builder.num_blocks * sizeof(*builder.blocks));
+	builder.labels =
+	    mcc_calloc(MCC_ALLOC_OTHER, builder.num_labels ? builder.num_labels : 1, sizeof(*builder.labels));
+	if (!builder.blocks || !builder.labels || !get_basic_blocks(ir, &builder)) {
+		mcc_free(MCC_ALLOC_OTHER, builder.blocks);
+		mcc_free(MCC_ALLOC_OTHER, builder.labels);
 		return NULL;
 	}
+	struct mcc_basic_block *root = builder.blocks[0];
 
-	struct mcc_basic_block *bb_head = bb_first;
-	an_ir = an_ir->next;
-
-	while (an_ir) {
-		if (an_ir->is_leader) {
-			struct mcc_basic_block *new = mcc_cfg_new_basic_block(an_ir->row, NULL, NULL);
-			if (!new) {
-				mcc_delete_cfg(bb_first);
-				return NULL;
+	// Rearrange linear chain into graph, by setting the child nodes. A block ends before the leader of the next one.
+	for (unsigned i = 0; i < builder.num_blocks; i++) {
+		struct mcc_ir_row *last_row;
+		if (i + 1 < builder.num_blocks) {
+			last_row = builder.blocks[i + 1]->leader->prev_row;
+		} else {
+			last_row = builder.blocks[i]->leader;
+			while (last_row->next_row) {
+				last_row = last_row->next_row;
 			}
-			bb_head->next = new;
-			bb_head = new;
 		}
-		an_ir = an_ir->next;
+		set_children(builder.blocks[i], last_row, &builder);
 	}
-
-	return bb_first;
-}
-
-struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_row *ir)
-{
-	struct annotated_ir *an_ir = annotate_ir(ir);
-	if (!an_ir)
-		return NULL;
-	struct annotated_ir *an_ir_first = an_ir;
-
-	struct mcc_basic_block *basic_blocks = get_basic_blocks(an_ir_first);
-	if (!basic_blocks) {
-		delete_annotated_ir(an_ir_first);
+	if (!set_predecessors(&builder)) {
+		delete_cfg(root);
+		mcc_free(MCC_ALLOC_OTHER, builder.blocks);
+		mcc_free(MCC_ALLOC_OTHER, builder.labels);
 		return NULL;
 	}
 
-	// Rearrange linear chain into graph, by setting the child nodes
-	struct mcc_basic_block *root = basic_blocks;
-	sort_cfg(root, root);
-
 	// Truncate IR inside the basic blocks to end before next leader
-	truncate_ir(root);
-
-	// Cleanup
-	delete_annotated_ir(an_ir_first);
+	for (unsigned i = 1; i < builder.num_blocks; i++) {
+		struct mcc_ir_row *leader = builder.blocks[i]->leader;
+		leader->prev_row->next_row = NULL;
+		leader->prev_row = NULL;
+	}
 
+	mcc_free(MCC_ALLOC_OTHER, builder.blocks);
+	mcc_free(MCC_ALLOC_OTHER, builder.labels);
 	return root;
 }
 
-static void remove_all_bbs_above(struct mcc_basic_block *first, struct mcc_basic_block *head)
+struct mcc_basic_block *mcc_cfg_generate(struct mcc_ir_row *ir)
 {
-	assert(first);
-	assert(head);
-	if (first == head) {
-		return;
-	}
-	struct mcc_basic_block *previous = first;
-	while (previous) {
-		if (previous->next == head) {
-			previous->next = NULL;
-			mcc_delete_cfg_and_ir(first);
-			return;
-		}
-		previous = previous->next;
-	}
+	assert(ir);
+
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_CFG);
+	struct mcc_basic_block *root = generate_cfg(ir);
+	mcc_alloc_set_phase(phase);
+	return root;
 }
 
-static void remove_cfg_after_next_function_label(struct mcc_basic_block *head)
+// Drop edges leaving the blocks with IDs in [first, last]
+static void restrict_edges(struct mcc_basic_block *block, unsigned first, unsigned last)
 {
-	assert(head);
-	struct mcc_basic_block *previous = head;
-	head = previous->next;
-	while (head) {
-		if (head->leader->arg1) {
-			if (head->leader->arg1->type == MCC_IR_TYPE_FUNC_LABEL) {
-				previous->next = NULL;
-				mcc_delete_cfg_and_ir(head);
-				break;
-			}
-		}
-		previous = previous->next;
-		head = head->next;
+	if (block->child_left && (block->child_left->id < first || block->child_left->id > last))
+		block->child_left = NULL;
+	if (block->child_right && (block->child_right->id < first || block->child_right->id > last))
+		block->child_right = NULL;
+
+	set_successors(block);
+
+	unsigned num_predecessors = 0;
+	for (unsigned i = 0; i < block->num_predecessors; i++) {
+		struct mcc_basic_block *predecessor = block->predecessors[i];
+		if (predecessor->id >= first && predecessor->id <= last)
+			block->predecessors[num_predecessors++] = predecessor;
 	}
+	block->num_predecessors = num_predecessors;
 }
 
 struct mcc_basic_block *mcc_cfg_limit_to_function(char *function_identifier, struct mcc_basic_block *cfg_first)
 {
 	assert(function_identifier);
 	assert(cfg_first);
+
+	// Find the function and the block preceding it
+	struct mcc_basic_block *previous = NULL;
 	struct mcc_basic_block *head = cfg_first;
-	while (head) {
-		if (head->leader->arg1) {
-			if (head->leader->arg1->type == MCC_IR_TYPE_FUNC_LABEL) {
-				// Right function
-				if (strcmp(head->leader->arg1->func_label, function_identifier) == 0) {
-					remove_all_bbs_above(cfg_first, head);
-					remove_cfg_after_next_function_label(head);
-					break;
-				}
-			}
-		}
+	while (head && !(is_function_label(head) && strcmp(head->leader->arg1->func_label, function_identifier) == 0)) {
+		previous = head;
 		head = head->next;
 	}
 	if (!head) {
 		mcc_delete_cfg_and_ir(cfg_first);
 		return NULL;
 	}
+
+	// The function ends before the next function label
+	struct mcc_basic_block *last = head;
+	while (last->next && !is_function_label(last->next)) {
+		last = last->next;
+	}
+
+	// Remove edges to other functions before deleting them
+	for (struct mcc_basic_block *block = head; block != last->next; block = block->next) {
+		restrict_edges(block, head->id, last->id);
+	}
+	if (previous) {
+		previous->next = NULL;
+		mcc_delete_cfg_and_ir(cfg_first);
+	}
+	mcc_delete_cfg_and_ir(last->next);
+	last->next = NULL;
+
+	unsigned id = 0;
+	for (struct mcc_basic_block *block = head; block; block = block->next) {
+		block->id = id++;
+	}
 	return head;
 }
 
@@ -345,22 +287,27 @@ struct mcc_basic_block *mcc_cfg_new_basic_block(struct mcc_ir_row *leader,
                                                 struct mcc_basic_block *child_right)
 {
 	assert(leader);
-	struct mcc_basic_block *block = malloc(sizeof(*block));
+	struct mcc_basic_block *block = mcc_malloc(MCC_ALLOC_CFG, sizeof(*block));
 	if (!block)
 		return NULL;
 	block->next = NULL;
 	block->child_left = child_left;
 	block->child_right = child_right;
 	block->leader = leader;
+	block->id = 0;
+	block->num_predecessors = 0;
+	block->predecessors = NULL;
+	set_successors(block);
 	return block;
 }
 
 void mcc_delete_cfg_and_ir(struct mcc_basic_block *head)
 {
-	if (!head)
-		return;
-	mcc_delete_cfg_and_ir(head->next);
-	mcc_ir_delete_ir(head->leader);
-	free(head);
+	while (head) {
+		struct mcc_basic_block *next = head->next;
+		mcc_ir_delete_ir(head->leader);
+		mcc_free(MCC_ALLOC_CFG, head->predecessors);
+		mcc_free(MCC_ALLOC_CFG, head);
+		head = next;
+	}
 }
-
@@ -0,0 +1,132 @@
+#define _GNU_SOURCE
+#include "mcc/input.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mcc/alloc.h"
+
+#define INITIAL_CAPACITY 4096
+
+// The scanner expects two NUL bytes after the source text
+#define NUM_TERMINATORS 2
+
+// ------------------------------------------------------------------------------------- Streams
+
+struct mcc_input *mcc_input_from_stream(FILE *stream)
+{
+	assert(stream);
+
+	struct mcc_input *input = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*input));
+	if (!input)
+		return NULL;
+	input->size = 0;
+	input->capacity = INITIAL_CAPACITY;
+	input->is_mapped = false;
+	input->buffer = mcc_malloc(MCC_ALLOC_OTHER, input->capacity);
+	if (!input->buffer) {
+		mcc_free(MCC_ALLOC_OTHER, input);
+		return NULL;
+	}
+
+	// Double the buffer whenever it is full, so every byte is copied a constant number of times on average
+	for (;;) {
+		size_t free_space = input->capacity - NUM_TERMINATORS - input->size;
+		size_t num_read = fread(input->buffer + input->size, 1, free_space, stream);
+		input->size += num_read;
+		if (num_read < free_space)
+			break;
+
+		char *buffer = mcc_realloc(MCC_ALLOC_OTHER, input->buffer, input->capacity * 2);
+		if (!buffer) {
+			mcc_input_delete(input);
+			return NULL;
+		}
+		input->buffer = buffer;
+		input->capacity *= 2;
+	}
+
+	if (ferror(stream)) {
+		mcc_input_delete(input);
+		return NULL;
+	}
+
+	memset(input->buffer + input->size, 0, NUM_TERMINATORS);
+	return input;
+}
+
+// --------------------------------------------------------------------------------------- Files
+
+// Map the file privately and reserve the terminating NUL bytes behind it. The reservation is an anonymous mapping
+// that the file is mapped over, so the terminators exist even if the file ends exactly on a page boundary.
+static struct mcc_input *map_file(int fd, size_t size)
+{
+	struct mcc_input *input = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*input));
+	if (!input)
+		return NULL;
+	input->size = size;
+	input->capacity = size + NUM_TERMINATORS;
+	input->is_mapped = true;
+
+	input->buffer = mmap(NULL, input->capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (input->buffer == MAP_FAILED) {
+		mcc_free(MCC_ALLOC_OTHER, input);
+		return NULL;
+	}
+	if (size > 0 &&
+	    mmap(input->buffer, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+		munmap(input->buffer, input->capacity);
+		mcc_free(MCC_ALLOC_OTHER, input);
+		return NULL;
+	}
+	return input;
+}
+
+struct mcc_input *mcc_input_from_file(const char *filename)
+{
+	assert(filename);
+
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+		return NULL;
+	}
+
+	// Pipes and devices cannot be mapped, read them like a stream
+	if (!S_ISREG(info.st_mode)) {
+		FILE *stream = fdopen(fd, "r");
+		if (!stream) {
+			close(fd);
+			return NULL;
+		}
+		struct mcc_input *input = mcc_input_from_stream(stream);
+		fclose(stream);
+		return input;
+	}
+
+	struct mcc_input *input = map_file(fd, (size_t)info.st_size);
+	// The mapping stays valid after closing the file
+	close(fd);
+	return input;
+}
+
+void mcc_input_delete(struct mcc_input *input)
+{
+	if (!input)
+		return;
+	if (input->is_mapped) {
+		munmap(input->buffer, input->capacity);
+	} else {
+		mcc_free(MCC_ALLOC_OTHER, input->buffer);
+	}
+	mcc_free(MCC_ALLOC_OTHER, input);
+}
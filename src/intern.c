@@ -0,0 +1,127 @@
+#include "mcc/intern.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/alloc.h"
+#include "mcc/arena.h"
+#include "utils/hash_map.h"
+
+#define INITIAL_CAPACITY 256
+
+// Open addressing set of strings with linear probing. The strings themselves live in a private arena.
+static struct {
+	struct mcc_arena *strings;
+	char **slots;
+	size_t size;
+	size_t capacity;
+} table = {NULL, NULL, 0, 0};
+
+// Files may be parsed on several threads at once, and later stages look names up concurrently
+static pthread_rwlock_t table_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+// Returns the slot holding string, or the empty slot where it would be inserted
+static char **find_slot(char **slots, size_t capacity, const char *string)
+{
+	size_t mask = capacity - 1;
+	size_t index = mcc_hash_string(string) & mask;
+	while (slots[index] && strcmp(slots[index], string) != 0) {
+		index = (index + 1) & mask;
+	}
+	return &slots[index];
+}
+
+static int init_table(void)
+{
+	table.strings = mcc_arena_new();
+	if (!table.strings)
+		return 1;
+	table.slots = mcc_calloc(MCC_ALLOC_OTHER, INITIAL_CAPACITY, sizeof(*table.slots));
+	if (!table.slots) {
+		mcc_arena_delete(table.strings);
+		table.strings = NULL;
+		return 1;
+	}
+	table.size = 0;
+	table.capacity = INITIAL_CAPACITY;
+	return 0;
+}
+
+static int grow(void)
+{
+	size_t capacity = table.capacity * 2;
+	char **slots = mcc_calloc(MCC_ALLOC_OTHER, capacity, sizeof(*slots));
+	if (!slots)
+		return 1;
+
+	for (size_t i = 0; i < table.capacity; i++) {
+		if (table.slots[i]) {
+			*find_slot(slots, capacity, table.slots[i]) = table.slots[i];
+		}
+	}
+	mcc_free(MCC_ALLOC_OTHER, table.slots);
+	table.slots = slots;
+	table.capacity = capacity;
+	return 0;
+}
+
+static char *intern(const char *string)
+{
+	if (!table.slots && init_table() != 0)
+		return NULL;
+
+	char **slot = find_slot(table.slots, table.capacity, string);
+	if (*slot)
+		return *slot;
+
+	// Keep load factor below 3/4
+	if (4 * (table.size + 1) > 3 * table.capacity) {
+		if (grow() != 0)
+			return NULL;
+		slot = find_slot(table.slots, table.capacity, string);
+	}
+
+	*slot = mcc_arena_alloc_string(table.strings, string);
+	if (!*slot)
+		return NULL;
+	table.size++;
+	return *slot;
+}
+
+char *mcc_intern(const char *string)
+{
+	assert(string);
+
+	// Most names were interned before, those only need the shared lock
+	char *interned = mcc_intern_find(string);
+	if (interned)
+		return interned;
+
+	// Another thread may have inserted the string in the meantime, intern probes again
+	pthread_rwlock_wrlock(&table_lock);
+	interned = intern(string);
+	pthread_rwlock_unlock(&table_lock);
+	return interned;
+}
+
+char *mcc_intern_find(const char *string)
+{
+	assert(string);
+
+	pthread_rwlock_rdlock(&table_lock);
+	char *interned = table.slots ? *find_slot(table.slots, table.capacity, string) : NULL;
+	pthread_rwlock_unlock(&table_lock);
+	return interned;
+}
+
+void mcc_intern_release(void)
+{
+	mcc_arena_delete(table.strings);
+	mcc_free(MCC_ALLOC_OTHER, table.slots);
+	table.strings = NULL;
+	table.slots = NULL;
+	table.size = 0;
+	table.capacity = 0;
+}
@@ -1,12 +1,18 @@
 #include "mcc/ir.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
 #include "mcc/ast_visit.h"
+#include "mcc/intern.h"
+#include "mcc/ir_packed.h"
+#include "mcc/thread_pool.h"
+#include "utils/hash_map.h"
 #include "utils/length_of_int.h"
 
 // clang-format off
@@ -78,7 +84,7 @@ new_ir_row_type(enum mcc_ir_row_types row_type, signed size, struct ir_generatio
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_ir_row_type *type = malloc(sizeof(*type));
+	struct mcc_ir_row_type *type = mcc_malloc(MCC_ALLOC_IR_ROW, sizeof(*type));
 	if (!type) {
 		data->has_failed = true;
 		return NULL;
@@ -100,13 +106,14 @@ static struct mcc_ir_row_type *typeless(struct ir_generation_userdata *data)
 static struct mcc_ir_arg *new_arg_func_label(struct mcc_ast_function_definition *def,
                                              struct ir_generation_userdata *data)
 {
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
 	}
 	arg->type = MCC_IR_TYPE_FUNC_LABEL;
-	arg->func_label = strdup(def->identifier->identifier_name);
+	arg->func_label = mcc_strdup(MCC_ALLOC_IR_ARG, def->identifier->identifier_name);
+	arg->num_symbols = 0;
 	return arg;
 }
 
@@ -116,7 +123,7 @@ static struct mcc_ir_arg *new_arg_row(struct mcc_ir_row *row, struct ir_generati
 	if (data->has_failed)
 		return NULL;
 
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
@@ -131,7 +138,7 @@ static struct mcc_ir_arg *new_arg_int(long lit, struct ir_generation_userdata *d
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
@@ -146,7 +153,7 @@ static struct mcc_ir_arg *new_arg_float(double lit, struct ir_generation_userdat
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
@@ -161,7 +168,7 @@ static struct mcc_ir_arg *new_arg_bool(bool lit, struct ir_generation_userdata *
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
@@ -176,12 +183,12 @@ static struct mcc_ir_arg *new_arg_string(char *lit, struct ir_generation_userdat
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *string = strdup(lit);
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	char *string = mcc_strdup(MCC_ALLOC_IR_ARG, lit);
 	if (!arg || !string) {
 		data->has_failed = true;
-		free(arg);
-		free(string);
+		mcc_free(MCC_ALLOC_IR_ARG, arg);
+		mcc_free(MCC_ALLOC_IR_ARG, string);
 		return NULL;
 	}
 	arg->type = MCC_IR_TYPE_LIT_STRING;
@@ -194,7 +201,7 @@ static struct mcc_ir_arg *new_arg_label(struct ir_generation_userdata *data)
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
 	if (!arg) {
 		data->has_failed = true;
 		return NULL;
@@ -210,16 +217,17 @@ static struct mcc_ir_arg *new_arg_identifier(struct mcc_ast_identifier *ident, s
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident->identifier_name);
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	char *str = mcc_strdup(MCC_ALLOC_IR_ARG, ident->identifier_name);
 	if (!arg || !str) {
 		data->has_failed = true;
-		free(arg);
-		free(str);
+		mcc_free(MCC_ALLOC_IR_ARG, arg);
+		mcc_free(MCC_ALLOC_IR_ARG, str);
 		return NULL;
 	}
 	arg->type = MCC_IR_TYPE_IDENTIFIER;
 	arg->ident = str;
+	arg->is_tmp = false;
 	return arg;
 }
 
@@ -228,16 +236,34 @@ static struct mcc_ir_arg *new_arg_identifier_from_string(char *ident, struct ir_
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident);
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	char *str = mcc_strdup(MCC_ALLOC_IR_ARG, ident);
 	if (!arg || !str) {
 		data->has_failed = true;
-		free(arg);
-		free(str);
+		mcc_free(MCC_ALLOC_IR_ARG, arg);
+		mcc_free(MCC_ALLOC_IR_ARG, str);
 		return NULL;
 	}
 	arg->type = MCC_IR_TYPE_IDENTIFIER;
 	arg->ident = str;
+	arg->is_tmp = false;
+	return arg;
+}
+
+static struct mcc_ir_arg *new_arg_tmp(unsigned tmp, struct ir_generation_userdata *data)
+{
+	assert(data);
+	if (data->has_failed)
+		return NULL;
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	if (!arg) {
+		data->has_failed = true;
+		return NULL;
+	}
+	arg->type = MCC_IR_TYPE_IDENTIFIER;
+	arg->ident = NULL;
+	arg->is_tmp = true;
+	arg->tmp = tmp;
 	return arg;
 }
 
@@ -250,7 +276,7 @@ static struct mcc_ir_row *new_row(struct mcc_ir_arg *arg1,
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_row *row = malloc(sizeof(*row));
+	struct mcc_ir_row *row = mcc_malloc(MCC_ALLOC_IR_ROW, sizeof(*row));
 	if (!row) {
 		data->has_failed = true;
 		return NULL;
@@ -265,21 +291,61 @@ static struct mcc_ir_row *new_row(struct mcc_ir_arg *arg1,
 	return row;
 }
 
-static struct mcc_ir_row *new_ir_row_array_tmp(struct mcc_ir_arg *index, struct ir_generation_userdata *data)
+static struct mcc_ir_arg *copy_label_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
 {
+	assert(arg);
 	assert(data);
+
 	if (data->has_failed)
 		return NULL;
-	unsigned size = 4 + length_of_int(data->tmp_counter) + 1;
-	char *ident = malloc(sizeof(char) * size);
-	if (!ident) {
+
+	struct mcc_ir_arg *new = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*new));
+	if (!new) {
 		data->has_failed = true;
 		return NULL;
 	}
-	snprintf(ident, size, "$tmp%d", data->tmp_counter);
+	new->type = MCC_IR_TYPE_LABEL;
+	new->label = arg->label;
+	return new;
+}
+
+static struct mcc_ir_arg *copy_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
+{
+	if (data->has_failed)
+		return NULL;
+
+	assert(arg);
+	assert(data);
+
+	switch (arg->type) {
+	case MCC_IR_TYPE_LIT_INT:
+		return new_arg_int(arg->lit_int, data);
+	case MCC_IR_TYPE_LIT_BOOL:
+		return new_arg_bool(arg->lit_bool, data);
+	case MCC_IR_TYPE_LIT_FLOAT:
+		return new_arg_float(arg->lit_float, data);
+	case MCC_IR_TYPE_LIT_STRING:
+		return new_arg_string(arg->lit_string, data);
+	case MCC_IR_TYPE_IDENTIFIER:
+		if (arg->is_tmp)
+			return new_arg_tmp(arg->tmp, data);
+		return new_arg_identifier_from_string(arg->ident, data);
+	case MCC_IR_TYPE_LABEL:
+		return copy_label_arg(arg, data);
+	case MCC_IR_TYPE_ROW:
+		return new_arg_row(arg->row, data);
+	default:
+		return NULL;
+	}
+}
+
+static struct mcc_ir_row *new_ir_row_array_tmp(struct mcc_ir_arg *index, struct ir_generation_userdata *data)
+{
+	assert(data);
+	if (data->has_failed)
+		return NULL;
+	struct mcc_ir_arg *arg1 = new_arg_tmp(data->tmp_counter, data);
 	data->tmp_counter++;
-	struct mcc_ir_arg *arg1 = new_arg_identifier_from_string(ident, data);
-	free(ident);
 	struct mcc_ir_arg *arg2 = index;
 	// is always of type int because it is only used when index of array element is again array element
 	struct mcc_ir_row_type *type = new_ir_row_type(MCC_IR_ROW_INT, -1, data);
@@ -294,19 +360,19 @@ new_arg_arr_elem(struct mcc_ast_identifier *ident, struct mcc_ir_arg *index, str
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	struct mcc_ir_arg *arg = malloc(sizeof(*arg));
-	char *str = strdup(ident->identifier_name);
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	char *str = mcc_strdup(MCC_ALLOC_IR_ARG, ident->identifier_name);
 	if (!arg || !str) {
 		data->has_failed = true;
-		free(arg);
-		free(str);
+		mcc_free(MCC_ALLOC_IR_ARG, arg);
+		mcc_free(MCC_ALLOC_IR_ARG, str);
 		return NULL;
 	}
 	arg->type = MCC_IR_TYPE_ARR_ELEM;
 	arg->arr_ident = str;
 	if (index->type == MCC_IR_TYPE_ARR_ELEM) {
 		struct mcc_ir_row *row = new_ir_row_array_tmp(index, data);
-		arg->index = new_arg_identifier_from_string(row->arg1->ident, data);
+		arg->index = copy_arg(row->arg1, data);
 	} else {
 		arg->index = index;
 	}
@@ -318,16 +384,8 @@ static struct mcc_ir_row *new_ir_row_float_tmp(double f_value, struct ir_generat
 	assert(data);
 	if (data->has_failed)
 		return NULL;
-	unsigned size = 4 + length_of_int(data->tmp_counter) + 1;
-	char *ident = malloc(sizeof(char) * size);
-	if (!ident) {
-		data->has_failed = true;
-		return NULL;
-	}
-	snprintf(ident, size, "$tmp%d", data->tmp_counter);
+	struct mcc_ir_arg *arg1 = new_arg_tmp(data->tmp_counter, data);
 	data->tmp_counter++;
-	struct mcc_ir_arg *arg1 = new_arg_identifier_from_string(ident, data);
-	free(ident);
 	struct mcc_ir_arg *arg2 = new_arg_float(f_value, data);
 	struct mcc_ir_row_type *type = new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data);
 	struct mcc_ir_row *row = new_row(arg1, arg2, MCC_IR_INSTR_ASSIGN, type, data);
@@ -337,12 +395,11 @@ static struct mcc_ir_row *new_ir_row_float_tmp(double f_value, struct ir_generat
 	return row;
 }
 
-static void number_rows(struct mcc_ir_row *head)
+// Number the rows that have a result in order, returns how many there are
+static unsigned number_rows(struct mcc_ir_row *head)
 {
-	if (!head)
-		return;
-	int i = 0;
-	do {
+	unsigned i = 0;
+	for (; head; head = head->next_row) {
 		switch (head->instr) {
 		case MCC_IR_INSTR_AND:
 		case MCC_IR_INSTR_OR:
@@ -367,8 +424,8 @@ static void number_rows(struct mcc_ir_row *head)
 		default:
 			break;
 		}
-		head = head->next_row;
-	} while (head);
+	}
+	return i;
 }
 
 static struct mcc_ir_arg *arg_from_declaration(struct mcc_ast_declaration *decl, struct ir_generation_userdata *data)
@@ -404,7 +461,7 @@ struct mcc_ir_arg *mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, stru
 		row = new_ir_row_float_tmp(literal->f_value, data);
 		if (!row)
 			return NULL;
-		arg = new_arg_identifier_from_string(row->arg1->ident, data);
+		arg = copy_arg(row->arg1, data);
 		break;
 	case MCC_AST_LITERAL_TYPE_BOOL:
 		arg = mcc_ir_new_arg(literal->bool_value, data);
@@ -417,52 +474,6 @@ struct mcc_ir_arg *mcc_ir_generate_arg_lit(struct mcc_ast_literal *literal, stru
 	return arg;
 }
 
-static struct mcc_ir_arg *copy_label_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
-{
-	assert(arg);
-	assert(data);
-
-	if (data->has_failed)
-		return NULL;
-
-	struct mcc_ir_arg *new = malloc(sizeof(*new));
-	if (!new) {
-		data->has_failed = true;
-		return NULL;
-	}
-	new->type = MCC_IR_TYPE_LABEL;
-	new->label = arg->label;
-	return new;
-}
-
-static struct mcc_ir_arg *copy_arg(struct mcc_ir_arg *arg, struct ir_generation_userdata *data)
-{
-	if (data->has_failed)
-		return NULL;
-
-	assert(arg);
-	assert(data);
-
-	switch (arg->type) {
-	case MCC_IR_TYPE_LIT_INT:
-		return new_arg_int(arg->lit_int, data);
-	case MCC_IR_TYPE_LIT_BOOL:
-		return new_arg_bool(arg->lit_bool, data);
-	case MCC_IR_TYPE_LIT_FLOAT:
-		return new_arg_float(arg->lit_float, data);
-	case MCC_IR_TYPE_LIT_STRING:
-		return new_arg_string(arg->lit_string, data);
-	case MCC_IR_TYPE_IDENTIFIER:
-		return new_arg_identifier_from_string(arg->ident, data);
-	case MCC_IR_TYPE_LABEL:
-		return copy_label_arg(arg, data);
-	case MCC_IR_TYPE_ROW:
-		return new_arg_row(arg->row, data);
-	default:
-		return NULL;
-	}
-}
-
 //------------------------------------------------------------------------------ IR generation
 
 static struct mcc_ir_row_type *
@@ -502,28 +513,33 @@ st_row_to_ir_type(struct mcc_symbol_table_row *row, int array_size, struct ir_ge
 	return type;
 }
 
-static struct mcc_ir_row_type *
-ident_to_ir_type(struct mcc_ir_arg *arg, struct mcc_ast_expression *exp, struct ir_generation_userdata *data)
+static enum mcc_ir_row_types ast_type_to_ir_type(enum mcc_ast_types type)
+{
+	switch (type) {
+	case INT:
+		return MCC_IR_ROW_INT;
+	case FLOAT:
+		return MCC_IR_ROW_FLOAT;
+	case BOOL:
+		return MCC_IR_ROW_BOOL;
+	case STRING:
+		return MCC_IR_ROW_STRING;
+	default:
+		return MCC_IR_ROW_TYPELESS;
+	}
+}
+
+// Type of a named operand from the semantic checks, the element type for arrays and the return type for calls
+static struct mcc_ir_row_type *expression_type(struct mcc_ast_expression *exp, struct ir_generation_userdata *data)
 {
-	assert(arg);
 	assert(exp);
 	assert(data);
+	// IR is only generated for checked ASTs
+	assert(exp->data_type.is_known);
 	if (data->has_failed)
 		return NULL;
-	// if argument is dummy for tmp of float declaration return row_type float
-	if (strncmp(arg->ident, "$tmp", 4) == 0) {
-		return new_ir_row_type(MCC_IR_ROW_FLOAT, -1, data);
-	}
-	struct mcc_symbol_table_row *row = NULL;
-	if (exp->type == MCC_AST_EXPRESSION_TYPE_VARIABLE) {
-		row = mcc_symbol_table_check_upwards_for_declaration(arg->ident, exp->variable_row);
-	} else if (exp->type == MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT) {
-		row = mcc_symbol_table_check_upwards_for_declaration(arg->ident, exp->array_row);
-	} else if (exp->type == MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL) {
-		row = mcc_symbol_table_check_for_function_declaration(arg->ident, exp->function_row);
-	}
 
-	return st_row_to_ir_type(row, -1, data);
+	return new_ir_row_type(ast_type_to_ir_type(exp->data_type.type), -1, data);
 }
 
 static struct mcc_ir_row_type *
@@ -549,11 +565,9 @@ get_type_of_row(struct mcc_ir_arg *arg, struct mcc_ast_expression *exp, struct i
 	case MCC_IR_TYPE_LABEL:
 		return new_ir_row_type(MCC_IR_ROW_TYPELESS, -1, data);
 	case MCC_IR_TYPE_IDENTIFIER:
-		return ident_to_ir_type(arg, exp, data);
 	case MCC_IR_TYPE_ARR_ELEM:
-		return ident_to_ir_type(arg, exp, data);
 	case MCC_IR_TYPE_FUNC_LABEL:
-		return ident_to_ir_type(arg, exp, data);
+		return expression_type(exp, data);
 	}
 	return NULL;
 }
@@ -682,17 +696,15 @@ void mcc_ir_generate_arguments(struct mcc_ast_arguments *arguments, struct ir_ge
 	if (!arguments->is_empty) {
 		if (arguments->expression->type == MCC_AST_EXPRESSION_TYPE_LITERAL &&
 		    arguments->expression->literal->type == MCC_AST_LITERAL_TYPE_STRING) {
-			unsigned size = 5 + length_of_int(data->tmp_counter);
-			char tmp[size];
-			snprintf(tmp, size, "$tmp%d", data->tmp_counter);
+			unsigned tmp = data->tmp_counter;
 			data->tmp_counter += 1;
 			struct mcc_ir_arg *lit = mcc_ir_generate_expression(arguments->expression, data);
 			if (!lit)
 				return;
 			struct mcc_ir_row_type *type1 = get_type_of_row(lit, arguments->expression, data);
 			struct mcc_ir_row_type *type2 = get_type_of_row(lit, arguments->expression, data);
-			struct mcc_ir_arg *ident1 = new_arg_identifier_from_string(tmp, data);
-			struct mcc_ir_arg *ident2 = new_arg_identifier_from_string(tmp, data);
+			struct mcc_ir_arg *ident1 = new_arg_tmp(tmp, data);
+			struct mcc_ir_arg *ident2 = new_arg_tmp(tmp, data);
 			struct mcc_ir_row *row1 = NULL, *row2 = NULL;
 			row1 = new_row(ident1, lit, MCC_IR_INSTR_ASSIGN, type1, data);
 			append_row(row1, data);
@@ -1089,52 +1101,124 @@ void mcc_ir_generate_function_definition(struct mcc_ast_function_definition *def
 struct renaming_userdata {
 	struct ir_generation_userdata *ir_data;
 	int num;
-	struct mcc_ast_identifier *ident;
+	// declaration rows of shadowing variables mapped to their new name
+	struct mcc_hash_map *renamed;
 };
 
-static void rename_row(struct mcc_symbol_table_row *row, struct renaming_userdata *data)
+// Returns the interned name "$r<num>" of a shadowing variable
+static char *shadowing_name(int num)
+{
+	size_t size = 3 + length_of_int(num);
+	char name[size];
+	snprintf(name, size, "$r%d", num);
+	return mcc_intern(name);
+}
+
+// callback of the modifying visitor. Checks if compound statement is a declaration, if so checks in symbol table if it
+// shadows a variable. If it does, the declaration gets a new name, which is applied by rename_shadowing_variables
+static void cb_variable_shadowing(struct mcc_ast_compound_statement *comp_stmt, void *data)
 {
-	assert(row);
 	assert(data);
+	assert(comp_stmt);
+	struct renaming_userdata *re_data = data;
+	if (re_data->ir_data->has_failed)
+		return;
+	if (comp_stmt->is_empty || comp_stmt->statement->type != MCC_AST_STATEMENT_TYPE_DECLARATION)
+		return;
+	struct mcc_ast_declaration *decl = comp_stmt->statement->declaration;
+	struct mcc_symbol_table_row *row = decl->row;
+	struct mcc_symbol_table_row *prev = NULL;
+	// get previous row in symbol table
+	if (row->prev_row) {
+		prev = row->prev_row;
+	} else if (row->scope->parent_row) {
+		if (row->scope->parent_row->row_structure == MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION) {
+			return;
+		} else {
+			prev = row->scope->parent_row;
+		}
+	}
+	// check if a row with same name exists upwards in the symbol table, if yes rename
+	prev = mcc_symbol_table_check_upwards_for_declaration(row->name, prev);
+	if (prev) {
+		char *name = shadowing_name(re_data->num);
+		if (!name || mcc_hash_map_insert(re_data->renamed, row, name) != 0) {
+			re_data->ir_data->has_failed = true;
+			return;
+		}
+		re_data->num += 1;
+	}
+}
 
-	size_t size = 3 + length_of_int(data->num);
-	row->name = (char *)realloc(row->name, size);
-	if (!row->name) {
-		data->ir_data->has_failed = true;
+// Resolve the declaration of an identifier via the symbol table row it is linked to and rename the identifier if the
+// declaration is shadowing
+static void rename_identifier(struct mcc_ast_identifier *ident,
+                              struct mcc_symbol_table_row *row,
+                              struct renaming_userdata *re_data)
+{
+	if (!row)
+		return;
+	struct mcc_symbol_table_row *declaration =
+	    mcc_symbol_table_check_upwards_for_declaration(ident->identifier_name, row);
+	if (!declaration)
 		return;
+	char *name = mcc_hash_map_lookup(re_data->renamed, declaration);
+	if (name) {
+		ident->identifier_name = name;
 	}
-	snprintf(row->name, size, "$r%d", data->num);
 }
 
-static void rename_ident(struct mcc_ast_identifier *ident, struct renaming_userdata *data)
+static void cb_rename_expression_variable(struct mcc_ast_expression *expression, void *data)
 {
-	assert(ident);
+	assert(expression);
 	assert(data);
-	if (data->ir_data->has_failed)
-		return;
+	rename_identifier(expression->identifier, expression->variable_row, data);
+}
 
-	size_t size = 3 + length_of_int(data->num);
-	ident->identifier_name = (char *)realloc(ident->identifier_name, size);
-	if (!ident->identifier_name) {
-		data->ir_data->has_failed = true;
-		return;
+static void cb_rename_expression_array_element(struct mcc_ast_expression *expression, void *data)
+{
+	assert(expression);
+	assert(data);
+	rename_identifier(expression->array_identifier, expression->array_row, data);
+}
+
+static void cb_rename_variable_assignment(struct mcc_ast_assignment *assignment, void *data)
+{
+	assert(assignment);
+	assert(data);
+	rename_identifier(assignment->variable_identifier, assignment->row, data);
+}
+
+static void cb_rename_array_assignment(struct mcc_ast_assignment *assignment, void *data)
+{
+	assert(assignment);
+	assert(data);
+	rename_identifier(assignment->array_identifier, assignment->row, data);
+}
+
+static void cb_rename_variable_declaration(struct mcc_ast_declaration *declaration, void *data)
+{
+	assert(declaration);
+	assert(data);
+	struct renaming_userdata *re_data = data;
+	char *name = mcc_hash_map_lookup(re_data->renamed, declaration->row);
+	if (name) {
+		declaration->variable_identifier->identifier_name = name;
 	}
-	snprintf(ident->identifier_name, size, "$r%d", data->num);
 }
 
-static void cb_rename_ident(struct mcc_ast_identifier *ident, void *data)
+static void cb_rename_array_declaration(struct mcc_ast_declaration *declaration, void *data)
 {
-	assert(ident);
+	assert(declaration);
 	assert(data);
 	struct renaming_userdata *re_data = data;
-	if (re_data->ir_data->has_failed)
-		return;
-	if (strcmp(ident->identifier_name, re_data->ident->identifier_name) == 0) {
-		rename_ident(ident, re_data);
+	char *name = mcc_hash_map_lookup(re_data->renamed, declaration->row);
+	if (name) {
+		declaration->array_identifier->identifier_name = name;
 	}
 }
 
-// Setup an AST Visitor for visiting declarations
+// Setup an AST Visitor for renaming all identifiers that refer to a shadowing declaration
 static struct mcc_ast_visitor rename_ident_visitor(struct renaming_userdata *data)
 {
 	return (struct mcc_ast_visitor){
@@ -1142,55 +1226,34 @@ static struct mcc_ast_visitor rename_ident_visitor(struct renaming_userdata *dat
 
 	    .userdata = data,
 
-	    .identifier = cb_rename_ident,
+	    .expression_variable = cb_rename_expression_variable,
+	    .expression_array_element = cb_rename_expression_array_element,
+	    .variable_assignment = cb_rename_variable_assignment,
+	    .array_assignment = cb_rename_array_assignment,
+	    .variable_declaration = cb_rename_variable_declaration,
+	    .array_declaration = cb_rename_array_declaration,
 	};
 }
 
-// callback of the modifying visitor. Checks if compound statement is a declaration, if so checks in symbol table if it
-// shadows a variable. If it does, all variables in the subtree of that compound statement become renamed
-static void cb_variable_shadowing(struct mcc_ast_compound_statement *comp_stmt, void *data)
+// Rename the identifiers of all shadowing variables in a single pass. Every identifier is resolved against the symbol
+// table under its old name first, afterwards the rows are renamed.
+static void rename_shadowing_variables(struct mcc_ast_program *ast, struct renaming_userdata *re_data)
 {
-	assert(data);
-	assert(comp_stmt);
-	struct renaming_userdata *re_data = data;
-	if (re_data->ir_data->has_failed)
+	if (re_data->ir_data->has_failed || re_data->renamed->size == 0)
 		return;
-	if (comp_stmt->is_empty || comp_stmt->statement->type != MCC_AST_STATEMENT_TYPE_DECLARATION)
+
+	struct mcc_ast_visitor visitor = rename_ident_visitor(re_data);
+	mcc_ast_visit(ast, &visitor);
+	if (visitor.has_failed) {
+		re_data->ir_data->has_failed = true;
 		return;
-	struct mcc_ast_declaration *decl = comp_stmt->statement->declaration;
-	struct mcc_symbol_table_row *row = decl->row;
-	struct mcc_symbol_table_row *prev = NULL;
-	// get previous row in symbol table
-	if (row->prev_row) {
-		prev = row->prev_row;
-	} else if (row->scope->parent_row) {
-		if (row->scope->parent_row->row_structure == MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION) {
-			return;
-		} else {
-			prev = row->scope->parent_row;
-		}
-	}
-	// get identifier of declaration
-	struct mcc_ast_identifier *ident = NULL;
-	switch (decl->declaration_type) {
-	case MCC_AST_DECLARATION_TYPE_VARIABLE:
-		ident = decl->variable_identifier;
-		break;
-	case MCC_AST_DECLARATION_TYPE_ARRAY:
-		ident = decl->array_identifier;
-		break;
 	}
-	// check if a row with same name exists upwards in the symbol table, if yes rename
-	prev = mcc_symbol_table_check_upwards_for_declaration(ident->identifier_name, prev);
-	if (prev) {
-		re_data->ident = ident;
-		if (comp_stmt->next_compound_statement) {
-			struct mcc_ast_visitor visitor = rename_ident_visitor(data);
-			mcc_ast_visit(comp_stmt->next_compound_statement, &visitor);
+
+	for (size_t i = 0; i < re_data->renamed->capacity; i++) {
+		struct mcc_hash_map_entry *entry = &re_data->renamed->entries[i];
+		if (entry->key) {
+			mcc_symbol_table_rename_row(entry->key, entry->value);
 		}
-		rename_ident(ident, re_data);
-		rename_row(row, re_data);
-		re_data->num += 1;
 	}
 }
 
@@ -1203,23 +1266,17 @@ static void append_empty_return(struct mcc_ast_compound_statement *comp_stmt, st
 	if (re_data->ir_data->has_failed) {
 		return;
 	}
-	struct mcc_ast_statement *stmt = malloc(sizeof(*stmt));
+	struct mcc_ast_statement *stmt = mcc_ast_new_statement_return(true, NULL);
 	if (!stmt) {
 		re_data->ir_data->has_failed = true;
 		return;
 	}
-	stmt->type = MCC_AST_STATEMENT_TYPE_RETURN;
-	stmt->is_empty_return = true;
-	stmt->return_value = NULL;
-	struct mcc_ast_compound_statement *new_comp_stmt = malloc(sizeof(*new_comp_stmt));
+	struct mcc_ast_compound_statement *new_comp_stmt = mcc_ast_new_compound_stmt(false, stmt, NULL);
 	if (!new_comp_stmt) {
+		mcc_ast_delete_statement(stmt);
 		re_data->ir_data->has_failed = true;
 		return;
 	}
-	new_comp_stmt->statement = stmt;
-	new_comp_stmt->is_empty = false;
-	new_comp_stmt->has_next_statement = false;
-	new_comp_stmt->next_compound_statement = NULL;
 	comp_stmt->has_next_statement = true;
 	comp_stmt->next_compound_statement = new_comp_stmt;
 }
@@ -1271,55 +1328,184 @@ static void modify_ast(struct mcc_ast_program *ast, struct ir_generation_userdat
 	if (ir_data->has_failed)
 		return;
 
-	struct renaming_userdata *re_data = malloc(sizeof(*re_data));
+	struct renaming_userdata *re_data = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*re_data));
 	if (!re_data) {
 		ir_data->has_failed = true;
 		return;
 	}
 	re_data->ir_data = ir_data;
 	re_data->num = 0;
+	re_data->renamed = mcc_hash_map_new(MCC_HASH_MAP_KEY_POINTER);
+	if (!re_data->renamed) {
+		mcc_free(MCC_ALLOC_OTHER, re_data);
+		ir_data->has_failed = true;
+		return;
+	}
 	struct mcc_ast_visitor visitor = modifying_visitor(re_data);
 	mcc_ast_visit(ast, &visitor);
-	free(re_data);
+	if (visitor.has_failed)
+		ir_data->has_failed = true;
+	rename_shadowing_variables(ast, re_data);
+	mcc_hash_map_delete(re_data->renamed);
+	mcc_free(MCC_ALLOC_OTHER, re_data);
 }
 
-struct mcc_ir_row *mcc_ir_generate(struct mcc_ast_program *ast)
+// --------------------------------------------------------------------------------------- Functions in parallel
+
+// Number the named operands of a function in order of appearance, equal names share an ID. Names are unique within
+// a function at this point, since shadowing variables have been renamed. Temporaries are looked up by their number
+// in tmp_symbols, which holds UINT_MAX for the ones not seen yet.
+static void number_symbol(struct mcc_ir_arg *arg,
+                          struct mcc_hash_map *symbols,
+                          unsigned *tmp_symbols,
+                          unsigned *num_symbols,
+                          struct ir_generation_userdata *data)
 {
-	struct ir_generation_userdata *data = malloc(sizeof(*data));
-	if (!data)
-		return NULL;
-	data->head = NULL;
-	data->has_failed = false;
-	data->current = NULL;
-	data->label_counter = 0;
-	data->tmp_counter = 0;
+	if (!arg)
+		return;
+
+	char *name;
+	switch (arg->type) {
+	case MCC_IR_TYPE_IDENTIFIER:
+		if (arg->is_tmp) {
+			if (tmp_symbols[arg->tmp] == UINT_MAX)
+				tmp_symbols[arg->tmp] = (*num_symbols)++;
+			arg->symbol = tmp_symbols[arg->tmp];
+			return;
+		}
+		name = arg->ident;
+		break;
+	case MCC_IR_TYPE_ARR_ELEM:
+		name = arg->arr_ident;
+		number_symbol(arg->index, symbols, tmp_symbols, num_symbols, data);
+		break;
+	default:
+		return;
+	}
+
+	struct mcc_ir_arg *first = mcc_hash_map_lookup(symbols, name);
+	if (first) {
+		arg->symbol = first->symbol;
+		return;
+	}
+	arg->symbol = (*num_symbols)++;
+	if (mcc_hash_map_insert(symbols, name, arg) != 0)
+		data->has_failed = true;
+}
+
+static void number_symbols(struct ir_generation_userdata *data)
+{
+	if (data->has_failed || !data->head)
+		return;
+	assert(data->head->instr == MCC_IR_INSTR_FUNC_LABEL);
+
+	struct mcc_hash_map *symbols = mcc_hash_map_new(MCC_HASH_MAP_KEY_STRING);
+	unsigned *tmp_symbols = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*tmp_symbols) * (data->tmp_counter + 1));
+	if (!symbols || !tmp_symbols) {
+		mcc_hash_map_delete(symbols);
+		mcc_free(MCC_ALLOC_OTHER, tmp_symbols);
+		data->has_failed = true;
+		return;
+	}
+	for (unsigned i = 0; i < data->tmp_counter; i++) {
+		tmp_symbols[i] = UINT_MAX;
+	}
+	unsigned num_symbols = 0;
+	for (struct mcc_ir_row *row = data->head; row; row = row->next_row) {
+		number_symbol(row->arg1, symbols, tmp_symbols, &num_symbols, data);
+		number_symbol(row->arg2, symbols, tmp_symbols, &num_symbols, data);
+	}
+	data->head->arg1->num_symbols = num_symbols;
+	mcc_hash_map_delete(symbols);
+	mcc_free(MCC_ALLOC_OTHER, tmp_symbols);
+}
 
-	// remove all built_ins before creating the IR
-	ast = mcc_ast_remove_built_ins(ast);
+struct function_ir {
+	struct mcc_ast_program *program;
+	struct mcc_ir_packed_function *packed;
+	bool has_failed;
+	unsigned num_labels;
+	unsigned num_tmps;
+	unsigned num_row_nos;
+};
+
+// Functions do not depend on each other, each one is generated with its own userdata. Its rows are packed right away
+// and deleted, so the linked rows of only one function per thread exist at a time.
+static void generate_function_ir(int index, void *userdata)
+{
+	struct function_ir *function = &((struct function_ir *)userdata)[index];
+	struct ir_generation_userdata data = {0};
+	mcc_ir_generate_program(function->program, &data);
+	number_symbols(&data);
+
+	// Set row numbers (used for naming temporaries in IR) for the visual representation
+	function->num_row_nos = number_rows(data.head);
+	function->num_labels = data.label_counter;
+	function->num_tmps = data.tmp_counter;
+	function->has_failed = data.has_failed || !data.head || !mcc_ir_pack_function(data.head, function->packed);
+	mcc_ir_delete_ir(data.head);
+}
+
+static struct mcc_ir_packed *generate_ir(struct mcc_ast_program *ast)
+{
+	struct ir_generation_userdata data = {0};
 
 	// Add return statements for void functions and enforce variable shadowing
-	modify_ast(ast, data);
-	if (data->has_failed) {
-		free(data);
+	modify_ast(ast, &data);
+	if (data.has_failed)
 		return NULL;
-	}
 
-	while (ast) {
-		mcc_ir_generate_program(ast, data);
-		ast = ast->next_function;
+	uint32_t num_functions = 0;
+	for (struct mcc_ast_program *program = ast; program; program = program->next_function) {
+		num_functions++;
+	}
+	struct mcc_ir_packed *packed = mcc_calloc(MCC_ALLOC_IR_ROW, 1, sizeof(*packed));
+	struct function_ir *functions = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*functions) * (num_functions + 1));
+	if (packed)
+		packed->functions = mcc_calloc(MCC_ALLOC_IR_ROW, num_functions + 1, sizeof(*packed->functions));
+	if (!packed || !packed->functions || !functions) {
+		mcc_ir_packed_delete(packed);
+		mcc_free(MCC_ALLOC_OTHER, functions);
+		return NULL;
+	}
+	packed->num_functions = num_functions;
+	uint32_t i = 0;
+	for (struct mcc_ast_program *program = ast; program; program = program->next_function) {
+		functions[i].program = program;
+		functions[i].packed = &packed->functions[i];
+		i++;
 	}
+	mcc_thread_pool_for(num_functions, generate_function_ir, functions);
+
+	// Number labels, temporaries and rows of each function behind the ones of all previous functions, which gives
+	// the same numbering as generating the functions one after another
+	unsigned label_offset = 0;
+	unsigned tmp_offset = 0;
+	unsigned row_no_offset = 0;
+	for (i = 0; i < num_functions; i++) {
+		data.has_failed |= functions[i].has_failed;
+		packed->functions[i].label_offset = label_offset;
+		packed->functions[i].tmp_offset = tmp_offset;
+		packed->functions[i].row_no_offset = row_no_offset;
+		label_offset += functions[i].num_labels;
+		tmp_offset += functions[i].num_tmps;
+		row_no_offset += functions[i].num_row_nos;
+	}
+	mcc_free(MCC_ALLOC_OTHER, functions);
 
-	if (data->has_failed) {
-		mcc_ir_delete_ir(data->head);
-		free(data);
+	if (data.has_failed) {
+		mcc_ir_packed_delete(packed);
 		return NULL;
 	}
-	struct mcc_ir_row *head = data->head;
-	free(data);
+	return packed;
+}
 
-	// Set row numbers (used for naming temporaries in IR) for the visual representation
-	number_rows(head);
-	return head;
+struct mcc_ir_packed *mcc_ir_generate(struct mcc_ast_program *ast)
+{
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_IR);
+	struct mcc_ir_packed *packed = generate_ir(ast);
+	mcc_alloc_set_phase(phase);
+	return packed;
 }
 
 //---------------------------------------------------------------------------------------- Cleanup
@@ -1329,28 +1515,28 @@ void mcc_ir_delete_ir_arg(struct mcc_ir_arg *arg)
 	if (!arg)
 		return;
 	if (arg->type == MCC_IR_TYPE_FUNC_LABEL) {
-		free(arg->func_label);
+		mcc_free(MCC_ALLOC_IR_ARG, arg->func_label);
 	}
 	if (arg->type == MCC_IR_TYPE_ARR_ELEM) {
 		mcc_ir_delete_ir_arg(arg->index);
 	}
 	if (arg->type == MCC_IR_TYPE_LIT_STRING) {
-		free(arg->lit_string);
+		mcc_free(MCC_ALLOC_IR_ARG, arg->lit_string);
 	}
 	if (arg->type == MCC_IR_TYPE_IDENTIFIER) {
-		free(arg->ident);
+		mcc_free(MCC_ALLOC_IR_ARG, arg->ident);
 	}
 	if (arg->type == MCC_IR_TYPE_ARR_ELEM) {
-		free(arg->arr_ident);
+		mcc_free(MCC_ALLOC_IR_ARG, arg->arr_ident);
 	}
-	free(arg);
+	mcc_free(MCC_ALLOC_IR_ARG, arg);
 }
 
 void mcc_ir_delete_ir_row_type(struct mcc_ir_row_type *type)
 {
 	if (!type)
 		return;
-	free(type);
+	mcc_free(MCC_ALLOC_IR_ROW, type);
 }
 
 void mcc_ir_delete_ir_row(struct mcc_ir_row *row)
@@ -1360,7 +1546,7 @@ void mcc_ir_delete_ir_row(struct mcc_ir_row *row)
 	mcc_ir_delete_ir_arg(row->arg1);
 	mcc_ir_delete_ir_arg(row->arg2);
 	mcc_ir_delete_ir_row_type(row->type);
-	free(row);
+	mcc_free(MCC_ALLOC_IR_ROW, row);
 }
 
 void mcc_ir_delete_ir(struct mcc_ir_row *head)
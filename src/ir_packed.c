@@ -0,0 +1,365 @@
+#include "mcc/ir_packed.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/alloc.h"
+#include "mcc/intern.h"
+
+//---------------------------------------------------------------------------------------- Types
+
+// Distinct row types are few (base types and array sizes), a linear search is enough
+static uint32_t intern_type(struct mcc_ir_packed_function *function, struct mcc_ir_row_type *type, uint32_t *capacity)
+{
+	for (uint32_t i = 0; i < function->num_types; i++) {
+		if (function->types[i].type == type->type && function->types[i].array_size == type->array_size)
+			return i;
+	}
+	if (function->num_types == *capacity) {
+		uint32_t new_capacity = *capacity ? *capacity * 2 : 8;
+		struct mcc_ir_row_type *types =
+		    mcc_realloc(MCC_ALLOC_IR_ROW, function->types, new_capacity * sizeof(*types));
+		if (!types)
+			return UINT32_MAX;
+		function->types = types;
+		*capacity = new_capacity;
+	}
+	function->types[function->num_types] = *type;
+	return function->num_types++;
+}
+
+//---------------------------------------------------------------------------------------- Packing
+
+struct pack_data {
+	struct mcc_ir_packed_function *function;
+	bool has_failed;
+};
+
+static const char *intern_name(const char *name, struct pack_data *data)
+{
+	const char *interned = mcc_intern(name);
+	if (!interned)
+		data->has_failed = true;
+	return interned;
+}
+
+// Packed rows keep the row number, so the linked row holds its index instead
+static uint32_t row_index(struct mcc_ir_row *row, struct pack_data *data)
+{
+	assert(row->row_no < data->function->num_rows);
+	return row->row_no;
+}
+
+static struct mcc_ir_packed_arg pack_arg(struct mcc_ir_arg *arg, struct pack_data *data)
+{
+	struct mcc_ir_packed_arg packed = {.type = MCC_IR_PACKED_NO_ARG};
+	if (!arg)
+		return packed;
+
+	packed.type = arg->type;
+	switch (arg->type) {
+	case MCC_IR_TYPE_LIT_INT:
+		packed.lit_int = arg->lit_int;
+		break;
+	case MCC_IR_TYPE_LIT_FLOAT:
+		packed.lit_float = arg->lit_float;
+		break;
+	case MCC_IR_TYPE_LIT_BOOL:
+		packed.lit_bool = arg->lit_bool;
+		break;
+	case MCC_IR_TYPE_LIT_STRING:
+		packed.name = intern_name(arg->lit_string, data);
+		break;
+	case MCC_IR_TYPE_ROW:
+		packed.ref = row_index(arg->row, data);
+		break;
+	case MCC_IR_TYPE_LABEL:
+		packed.ref = arg->label;
+		break;
+	case MCC_IR_TYPE_IDENTIFIER:
+		packed.is_tmp = arg->is_tmp;
+		if (arg->is_tmp)
+			packed.ref = arg->tmp;
+		else
+			packed.name = intern_name(arg->ident, data);
+		packed.symbol = arg->symbol;
+		break;
+	case MCC_IR_TYPE_ARR_ELEM:
+		// Element indices are never array elements themselves, so this does not nest
+		packed.name = intern_name(arg->arr_ident, data);
+		packed.symbol = arg->symbol;
+		packed.ref = data->function->num_indices;
+		data->function->indices[data->function->num_indices++] = pack_arg(arg->index, data);
+		break;
+	case MCC_IR_TYPE_FUNC_LABEL:
+		packed.name = intern_name(arg->func_label, data);
+		break;
+	}
+	return packed;
+}
+
+static void count(struct mcc_ir_row *head, uint32_t *num_rows, uint32_t *num_indices)
+{
+	*num_rows = 0;
+	*num_indices = 0;
+	for (struct mcc_ir_row *row = head; row; row = row->next_row) {
+		(*num_rows)++;
+		if (row->arg1 && row->arg1->type == MCC_IR_TYPE_ARR_ELEM)
+			(*num_indices)++;
+		if (row->arg2 && row->arg2->type == MCC_IR_TYPE_ARR_ELEM)
+			(*num_indices)++;
+	}
+}
+
+static void pack_rows(struct mcc_ir_row *head, struct pack_data *data)
+{
+	struct mcc_ir_packed_function *function = data->function;
+	uint32_t type_capacity = 0;
+
+	for (struct mcc_ir_row *row = head; row && !data->has_failed; row = row->next_row) {
+		struct mcc_ir_packed_row *packed_row = &function->rows[function->num_rows];
+		packed_row->instr = row->instr;
+		packed_row->row_no = row->row_no;
+		row->row_no = function->num_rows++;
+		packed_row->type = intern_type(function, row->type, &type_capacity);
+		if (packed_row->type == UINT32_MAX)
+			data->has_failed = true;
+		packed_row->arg1 = pack_arg(row->arg1, data);
+		packed_row->arg2 = pack_arg(row->arg2, data);
+	}
+}
+
+static void delete_function(struct mcc_ir_packed_function *function)
+{
+	mcc_free(MCC_ALLOC_IR_ROW, function->rows);
+	mcc_free(MCC_ALLOC_IR_ROW, function->indices);
+	mcc_free(MCC_ALLOC_IR_ROW, function->types);
+	function->rows = NULL;
+	function->indices = NULL;
+	function->types = NULL;
+}
+
+bool mcc_ir_pack_function(struct mcc_ir_row *head, struct mcc_ir_packed_function *function)
+{
+	assert(head);
+	assert(head->instr == MCC_IR_INSTR_FUNC_LABEL);
+	assert(function);
+
+	uint32_t num_rows, num_indices;
+	count(head, &num_rows, &num_indices);
+
+	function->num_symbols = head->arg1->num_symbols;
+	function->num_rows = 0;
+	function->num_indices = 0;
+	function->num_types = 0;
+	function->types = NULL;
+	function->rows = mcc_malloc(MCC_ALLOC_IR_ROW, num_rows * sizeof(*function->rows));
+	function->indices = mcc_malloc(MCC_ALLOC_IR_ROW, (num_indices ? num_indices : 1) * sizeof(*function->indices));
+	struct pack_data data = {.function = function, .has_failed = false};
+	function->name = intern_name(head->arg1->func_label, &data);
+	if (!function->rows || !function->indices || data.has_failed) {
+		delete_function(function);
+		return false;
+	}
+
+	pack_rows(head, &data);
+	if (data.has_failed) {
+		delete_function(function);
+		return false;
+	}
+	return true;
+}
+
+//---------------------------------------------------------------------------------------- Compatibility view
+
+struct unpack_data {
+	// Linked rows of the current function, operands refer to them by index
+	struct mcc_ir_row **rows;
+	struct mcc_ir_packed_function *function;
+	bool has_failed;
+};
+
+static char *copy_name(const char *name, struct unpack_data *data)
+{
+	char *copy = mcc_strdup(MCC_ALLOC_IR_ARG, name);
+	if (!copy)
+		data->has_failed = true;
+	return copy;
+}
+
+static struct mcc_ir_arg *unpack_arg(struct mcc_ir_packed_arg *packed, struct unpack_data *data)
+{
+	if (packed->type == MCC_IR_PACKED_NO_ARG || data->has_failed)
+		return NULL;
+
+	struct mcc_ir_arg *arg = mcc_malloc(MCC_ALLOC_IR_ARG, sizeof(*arg));
+	if (!arg) {
+		data->has_failed = true;
+		return NULL;
+	}
+	arg->type = packed->type;
+	switch (arg->type) {
+	case MCC_IR_TYPE_LIT_INT:
+		arg->lit_int = packed->lit_int;
+		break;
+	case MCC_IR_TYPE_LIT_FLOAT:
+		arg->lit_float = packed->lit_float;
+		break;
+	case MCC_IR_TYPE_LIT_BOOL:
+		arg->lit_bool = packed->lit_bool;
+		break;
+	case MCC_IR_TYPE_LIT_STRING:
+		arg->lit_string = copy_name(packed->name, data);
+		break;
+	case MCC_IR_TYPE_ROW:
+		arg->row = data->rows[packed->ref];
+		break;
+	case MCC_IR_TYPE_LABEL:
+		arg->label = packed->ref + data->function->label_offset;
+		break;
+	case MCC_IR_TYPE_IDENTIFIER:
+		arg->is_tmp = packed->is_tmp;
+		if (packed->is_tmp) {
+			arg->ident = NULL;
+			arg->tmp = packed->ref + data->function->tmp_offset;
+		} else {
+			arg->ident = copy_name(packed->name, data);
+		}
+		arg->symbol = packed->symbol;
+		break;
+	case MCC_IR_TYPE_ARR_ELEM:
+		arg->arr_ident = copy_name(packed->name, data);
+		arg->symbol = packed->symbol;
+		arg->index = unpack_arg(&data->function->indices[packed->ref], data);
+		break;
+	case MCC_IR_TYPE_FUNC_LABEL:
+		arg->func_label = copy_name(packed->name, data);
+		arg->num_symbols = data->function->num_symbols;
+		break;
+	}
+	return arg;
+}
+
+static struct mcc_ir_row *new_row(struct mcc_ir_packed_function *function, struct mcc_ir_packed_row *packed_row)
+{
+	struct mcc_ir_row *row = mcc_malloc(MCC_ALLOC_IR_ROW, sizeof(*row));
+	struct mcc_ir_row_type *type = mcc_malloc(MCC_ALLOC_IR_ROW, sizeof(*type));
+	if (!row || !type) {
+		mcc_free(MCC_ALLOC_IR_ROW, row);
+		mcc_free(MCC_ALLOC_IR_ROW, type);
+		return NULL;
+	}
+	*type = *mcc_ir_packed_row_type(function, packed_row);
+	row->row_no = packed_row->row_no + function->row_no_offset;
+	row->instr = packed_row->instr;
+	row->type = type;
+	row->arg1 = NULL;
+	row->arg2 = NULL;
+	row->prev_row = NULL;
+	row->next_row = NULL;
+	return row;
+}
+
+static struct mcc_ir_row *packed_to_rows(struct mcc_ir_packed *packed)
+{
+	uint32_t num_rows = 0;
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		num_rows += packed->functions[i].num_rows;
+	}
+	if (num_rows == 0)
+		return NULL;
+
+	struct mcc_ir_row **rows = mcc_malloc(MCC_ALLOC_OTHER, num_rows * sizeof(*rows));
+	if (!rows)
+		return NULL;
+
+	// Create all rows first, since operands refer to rows by index
+	struct mcc_ir_row *head = NULL;
+	uint32_t num_created = 0;
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		struct mcc_ir_packed_function *function = &packed->functions[i];
+		for (uint32_t j = 0; j < function->num_rows; j++) {
+			struct mcc_ir_row *row = new_row(function, &function->rows[j]);
+			if (!row) {
+				mcc_ir_delete_ir(head);
+				mcc_free(MCC_ALLOC_OTHER, rows);
+				return NULL;
+			}
+			if (num_created > 0) {
+				rows[num_created - 1]->next_row = row;
+				row->prev_row = rows[num_created - 1];
+			} else {
+				head = row;
+			}
+			rows[num_created++] = row;
+		}
+	}
+
+	struct unpack_data data = {.rows = rows, .has_failed = false};
+	for (uint32_t i = 0; i < packed->num_functions && !data.has_failed; i++) {
+		struct mcc_ir_packed_function *function = &packed->functions[i];
+		data.function = function;
+		for (uint32_t j = 0; j < function->num_rows; j++) {
+			data.rows[j]->arg1 = unpack_arg(&function->rows[j].arg1, &data);
+			data.rows[j]->arg2 = unpack_arg(&function->rows[j].arg2, &data);
+		}
+		data.rows += function->num_rows;
+	}
+	mcc_free(MCC_ALLOC_OTHER, rows);
+
+	if (data.has_failed) {
+		mcc_ir_delete_ir(head);
+		return NULL;
+	}
+	return head;
+}
+
+struct mcc_ir_row *mcc_ir_packed_to_rows(struct mcc_ir_packed *packed)
+{
+	assert(packed);
+
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_IR);
+	struct mcc_ir_row *head = packed_to_rows(packed);
+	mcc_alloc_set_phase(phase);
+	return head;
+}
+
+//---------------------------------------------------------------------------------------- Access
+
+struct mcc_ir_row_type *mcc_ir_packed_row_type(struct mcc_ir_packed_function *function, struct mcc_ir_packed_row *row)
+{
+	assert(function);
+	assert(row);
+	assert(row->type < function->num_types);
+
+	return &function->types[row->type];
+}
+
+size_t mcc_ir_packed_size(struct mcc_ir_packed *packed)
+{
+	assert(packed);
+
+	size_t size = sizeof(*packed);
+	size += packed->num_functions * sizeof(*packed->functions);
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		struct mcc_ir_packed_function *function = &packed->functions[i];
+		size += function->num_rows * sizeof(*function->rows);
+		size += function->num_indices * sizeof(*function->indices);
+		size += function->num_types * sizeof(*function->types);
+	}
+	return size;
+}
+
+//---------------------------------------------------------------------------------------- Cleanup
+
+void mcc_ir_packed_delete(struct mcc_ir_packed *packed)
+{
+	if (!packed)
+		return;
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		delete_function(&packed->functions[i]);
+	}
+	mcc_free(MCC_ALLOC_IR_ROW, packed->functions);
+	mcc_free(MCC_ALLOC_IR_ROW, packed);
+}
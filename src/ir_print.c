@@ -5,11 +5,28 @@
 #include <stdlib.h>
 
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "utils/print_string.h"
 #include "utils/unused.h"
 
+// Operand of a linked row, or of a packed row together with its function. NULL operands are not printed.
+struct operand {
+	struct mcc_ir_arg *arg;
+	struct mcc_ir_packed_arg *packed;
+	struct mcc_ir_packed_function *function;
+};
+
 char *bool_to_string(bool b);
 char *instr_to_string(enum mcc_ir_instruction instr);
+static void print_row(FILE *out,
+                      enum mcc_ir_instruction instr,
+                      unsigned row_no,
+                      struct mcc_ir_row_type *type,
+                      struct operand *arg1,
+                      struct operand *arg2,
+                      bool escape_quotes,
+                      bool doubly_escaped);
+static void print_operand(FILE *out, struct operand *operand, bool escape_quotes, bool doubly_escaped);
 static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, bool doubly_escaped);
 static void print_type(FILE *out, struct mcc_ir_row_type *type);
 
@@ -39,26 +56,59 @@ void mcc_ir_print_ir(FILE *out, struct mcc_ir_row *head, bool escape_quotes, boo
 	mcc_ir_print_table_end(out);
 }
 
+void mcc_ir_print_packed(FILE *out, struct mcc_ir_packed *packed, bool escape_quotes, bool doubly_escaped)
+{
+	mcc_ir_print_table_begin(out);
+
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		struct mcc_ir_packed_function *function = &packed->functions[i];
+		for (uint32_t j = 0; j < function->num_rows; j++) {
+			struct mcc_ir_packed_row *row = &function->rows[j];
+			struct operand arg1 = {.packed = &row->arg1, .function = function};
+			struct operand arg2 = {.packed = &row->arg2, .function = function};
+			print_row(out, row->instr, row->row_no + function->row_no_offset, mcc_ir_packed_row_type(function, row),
+			          &arg1, &arg2, escape_quotes, doubly_escaped);
+			fprintf(out, "\n");
+		}
+	}
+
+	mcc_ir_print_table_end(out);
+}
+
 void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes, bool doubly_escaped)
 {
-	print_type(out, row->type);
-	switch (row->instr) {
+	struct operand arg1 = {.arg = row->arg1};
+	struct operand arg2 = {.arg = row->arg2};
+	print_row(out, row->instr, row->row_no, row->type, &arg1, &arg2, escape_quotes, doubly_escaped);
+}
+
+static void print_row(FILE *out,
+                      enum mcc_ir_instruction instr,
+                      unsigned row_no,
+                      struct mcc_ir_row_type *type,
+                      struct operand *arg1,
+                      struct operand *arg2,
+                      bool escape_quotes,
+                      bool doubly_escaped)
+{
+	print_type(out, type);
+	switch (instr) {
 	// Instruction first
 	case MCC_IR_INSTR_JUMP:
 	case MCC_IR_INSTR_JUMPFALSE:
 	case MCC_IR_INSTR_PUSH:
 	case MCC_IR_INSTR_RETURN:
 		fprintf(out, "\t");
-		fprintf(out, "%s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		fprintf(out, "%s ", instr_to_string(instr));
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
 		fprintf(out, " ");
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_operand(out, arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Pop
 	case MCC_IR_INSTR_POP:
 		fprintf(out, "\t");
-		fprintf(out, "%s $t%d", instr_to_string(row->instr), row->row_no);
+		fprintf(out, "%s $t%d", instr_to_string(instr), row_no);
 		break;
 
 	// Print temporary, instruction first
@@ -66,17 +116,17 @@ void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes,
 	case MCC_IR_INSTR_NEGATIV:
 	case MCC_IR_INSTR_NOT:
 		fprintf(out, "\t");
-		fprintf(out, "$t%d =", row->row_no);
-		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		fprintf(out, "$t%d =", row_no);
+		fprintf(out, " %s ", instr_to_string(instr));
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
 		break;
 
 	case MCC_IR_INSTR_ARRAY:
 		fprintf(out, "\t");
-		fprintf(out, "%s ", instr_to_string(row->instr));
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
+		fprintf(out, "%s ", instr_to_string(instr));
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
 		fprintf(out, "[");
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_operand(out, arg2, escape_quotes, doubly_escaped);
 		fprintf(out, "]");
 
 		break;
@@ -95,28 +145,30 @@ void mcc_ir_print_ir_row(FILE *out, struct mcc_ir_row *row, bool escape_quotes,
 	case MCC_IR_INSTR_OR:
 	case MCC_IR_INSTR_PLUS:
 		fprintf(out, "\t");
-		fprintf(out, "$t%d = ", row->row_no);
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
-		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		fprintf(out, "$t%d = ", row_no);
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
+		fprintf(out, " %s ", instr_to_string(instr));
+		print_operand(out, arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Inline
 	case MCC_IR_INSTR_ASSIGN:
 		fprintf(out, "\t");
-		print_arg(out, row->arg1, escape_quotes, doubly_escaped);
-		fprintf(out, " %s ", instr_to_string(row->instr));
-		print_arg(out, row->arg2, escape_quotes, doubly_escaped);
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
+		fprintf(out, " %s ", instr_to_string(instr));
+		print_operand(out, arg2, escape_quotes, doubly_escaped);
 		break;
 
 	// Function label
 	case MCC_IR_INSTR_FUNC_LABEL:
-		fprintf(out, "  %s", row->arg1->func_label);
+		fprintf(out, "  ");
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
 		break;
 
 	// Label
 	case MCC_IR_INSTR_LABEL:
-		fprintf(out, "  L%d", row->arg1->label);
+		fprintf(out, "  ");
+		print_operand(out, arg1, escape_quotes, doubly_escaped);
 		break;
 	default:
 		break;
@@ -216,6 +268,19 @@ char *bool_to_string(bool b)
 	}
 }
 
+static void print_string(FILE *out, const char *string, bool escape_quotes, bool doubly_escaped)
+{
+	if (escape_quotes) {
+		fprintf(out, "\\\"");
+		mcc_print_string_literal(out, string, doubly_escaped);
+		fprintf(out, "\\\"");
+	} else {
+		fprintf(out, "\"");
+		mcc_print_string_literal(out, string, doubly_escaped);
+		fprintf(out, "\"");
+	}
+}
+
 static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, bool doubly_escaped)
 {
 	if (!arg)
@@ -239,7 +304,10 @@ static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, boo
 		fprintf(out, "L%d", arg->label);
 		return;
 	case MCC_IR_TYPE_IDENTIFIER:
-		fprintf(out, "%s", arg->ident);
+		if (arg->is_tmp)
+			fprintf(out, "$tmp%u", arg->tmp);
+		else
+			fprintf(out, "%s", arg->ident);
 		return;
 	case MCC_IR_TYPE_ARR_ELEM:
 		fprintf(out, "%s[", arg->arr_ident);
@@ -250,16 +318,58 @@ static void print_arg(FILE *out, struct mcc_ir_arg *arg, bool escape_quotes, boo
 		fprintf(out, "%s", arg->func_label);
 		return;
 	};
-	// MCC_IR_TYPE_LIT_STRING:
-	if (escape_quotes) {
-		fprintf(out, "\\\"");
-		mcc_print_string_literal(out, arg->lit_string, doubly_escaped);
-		fprintf(out, "\\\"");
-	} else {
-		fprintf(out, "\"");
-		mcc_print_string_literal(out, arg->lit_string, doubly_escaped);
-		fprintf(out, "\"");
-	}
+	print_string(out, arg->lit_string, escape_quotes, doubly_escaped);
 }
 
+static void print_packed_arg(FILE *out,
+                             struct mcc_ir_packed_arg *arg,
+                             struct mcc_ir_packed_function *function,
+                             bool escape_quotes,
+                             bool doubly_escaped)
+{
+	switch (arg->type) {
+	case MCC_IR_PACKED_NO_ARG:
+		return;
+	case MCC_IR_TYPE_ROW:
+		fprintf(out, "$t%d", function->rows[arg->ref].row_no + function->row_no_offset);
+		return;
+	case MCC_IR_TYPE_LIT_INT:
+		fprintf(out, "%ld", arg->lit_int);
+		return;
+	case MCC_IR_TYPE_LIT_FLOAT:
+		fprintf(out, "%f", arg->lit_float);
+		return;
+	case MCC_IR_TYPE_LIT_BOOL:
+		fprintf(out, "%s", bool_to_string(arg->lit_bool));
+		return;
+	case MCC_IR_TYPE_LIT_STRING:
+		print_string(out, arg->name, escape_quotes, doubly_escaped);
+		return;
+	case MCC_IR_TYPE_LABEL:
+		fprintf(out, "L%d", arg->ref + function->label_offset);
+		return;
+	case MCC_IR_TYPE_ARR_ELEM:
+		fprintf(out, "%s[", arg->name);
+		print_packed_arg(out, &function->indices[arg->ref], function, escape_quotes, doubly_escaped);
+		fprintf(out, "]");
+		return;
+	case MCC_IR_TYPE_IDENTIFIER:
+		if (arg->is_tmp)
+			fprintf(out, "$tmp%u", arg->ref + function->tmp_offset);
+		else
+			fprintf(out, "%s", arg->name);
+		return;
+	case MCC_IR_TYPE_FUNC_LABEL:
+		fprintf(out, "%s", arg->name);
+		return;
+	}
+}
 
+static void print_operand(FILE *out, struct operand *operand, bool escape_quotes, bool doubly_escaped)
+{
+	if (operand->packed) {
+		print_packed_arg(out, operand->packed, operand->function, escape_quotes, doubly_escaped);
+	} else {
+		print_arg(out, operand->arg, escape_quotes, doubly_escaped);
+	}
+}
@@ -45,9 +45,14 @@ while (0)
 }
 
 %{
+#include "mcc/alloc.h"
+
 int mcc_parser_lex();
 void mcc_parser_error();
 
+static struct mcc_ast_compound_statement *reverse_statements(struct mcc_ast_compound_statement *last);
+static struct mcc_ast_program *reverse_functions(struct mcc_ast_program *last);
+
 
 #define loc(ast_node, ast_sloc, ast_sloc_last) \
 	if (ast_node) { \
@@ -155,8 +160,7 @@ void mcc_parser_error();
 %destructor { mcc_ast_delete($$); } program
 %destructor { mcc_ast_delete($$); } arguments
 %destructor { mcc_ast_delete($$); } identifier
-%destructor { free($$); } STRING_LITERAL
-%destructor { free($$); } IDENTIFIER
+%destructor { mcc_free(MCC_ALLOC_STRING, $$); } STRING_LITERAL
 
 %start toplevel
 
@@ -261,18 +265,18 @@ statement           : IF LPARENTH expression RPARENTH statement %prec NOT_ELSE
                     | compound_statement { $$ = mcc_ast_new_statement_compound_stmt($1);           loc($$, @1, @1); }
                     ;
 
-statements          : statement statements { $$ = mcc_ast_new_compound_stmt(false, $1, $2);        loc($$, @1, @2); }
+statements          : statements statement { $$ = mcc_ast_new_compound_stmt(false, $2, $1);        loc($$, @2, @2); }
                     | statement            { $$ = mcc_ast_new_compound_stmt(false, $1, NULL);      loc($$, @1, @1); }
                     ;
 
-compound_statement  : CURL_OPEN statements CURL_CLOSE { $$ = $2;                                   loc($$, @1, @3); }
+compound_statement  : CURL_OPEN statements CURL_CLOSE { $$ = reverse_statements($2);               loc($$, @1, @3); }
                     | CURL_OPEN CURL_CLOSE { $$ = mcc_ast_new_compound_stmt(true,NULL,NULL);       loc($$, @1, @2); }
                     ;
 
 literal             : INT_LITERAL    { $$ = mcc_ast_new_literal_int($1);                           loc($$, @1, @1); }
                     | FLOAT_LITERAL  { $$ = mcc_ast_new_literal_float($1);                         loc($$, @1, @1); }
                     | BOOL_LITERAL   { $$ = mcc_ast_new_literal_bool($1);                          loc($$, @1, @1); }
-                    | STRING_LITERAL { $$ = mcc_ast_new_literal_string($1); free($1);              loc($$, @1, @1); }
+                    | STRING_LITERAL { $$ = mcc_ast_new_literal_string($1); mcc_free(MCC_ALLOC_STRING, $1); loc($$, @1, @1); }
                     ;
 
 parameters          : declaration    { $$ = mcc_ast_new_parameters(false, $1, NULL );              loc($$, @1, @1); }
@@ -286,11 +290,11 @@ function_def        : VOID identifier LPARENTH parameters RPARENTH compound_stat
                       { $$ = mcc_ast_new_type_function_def($1, $2, $4, $6);                        loc($$, @1, @6); }
                     ;
 
-function_defs       : function_def function_defs  { $$ = mcc_ast_new_program($1, $2);              loc($$, @1, @2); }
+function_defs       : function_defs function_def  { $$ = mcc_ast_new_program($2, $1);              loc($$, @2, @2); }
                     | function_def                { $$ = mcc_ast_new_program($1, NULL);            loc($$, @1, @1); }
                     ;
 
-program             : function_defs { $$ = $1;                                                     loc($$, @1, @1); }
+program             : function_defs { $$ = reverse_functions($1);                                  loc($$, @1, @1); }
                     ;
 
 %%
@@ -300,51 +304,49 @@ program             : function_defs { $$ = $1;
 #include <assert.h>
 
 #include "scanner.h"
+#include "mcc/alloc.h"
 #include "utils/unused.h"
 #include "utils/length_of_int.h"
 #include "mcc/parser.h"
 
-struct mcc_parser_result mcc_parse_string(const char *input_string, enum mcc_parser_entry_point entry_point, char *name)
+// Statements and functions are collected by left recursive rules, so that the parser stack does not grow with their
+// number. Each one is prepended to the list, which is reversed once complete. Like a right recursive rule would, the
+// location of each list node extends to the end of the list.
+static struct mcc_ast_compound_statement *reverse_statements(struct mcc_ast_compound_statement *last)
 {
-	assert(input_string);
-
-	char *input = strdup(input_string);
-
-	if (!input) {
-		return (struct mcc_parser_result){
-		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
-		};
+	struct mcc_ast_compound_statement *head = NULL;
+	struct mcc_ast_compound_statement *current = last;
+	while (current) {
+		struct mcc_ast_compound_statement *next = current->next_compound_statement;
+		current->next_compound_statement = head;
+		current->has_next_statement = head != NULL;
+		current->node.sloc.end_line = last->node.sloc.end_line;
+		current->node.sloc.end_col = last->node.sloc.end_col;
+		head = current;
+		current = next;
 	}
-
-	FILE *in = fmemopen((void *)input, strlen(input), "r");
-	if (!in) {
-		return (struct mcc_parser_result){
-		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
-		};
-	}
-
-	struct mcc_parser_result result = mcc_parse_file(in, entry_point, name);
-
-	free(input);
-
-	fclose(in);
-
-	return result;
+	return head;
 }
 
-struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point entry_point, char *name)
+static struct mcc_ast_program *reverse_functions(struct mcc_ast_program *last)
 {
-	assert(input);
-
-	yyscan_t scanner;
-	mcc_parser_lex_init(&scanner);
-	if (!scanner) {
-		return (struct mcc_parser_result){
-		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
-		};
+	struct mcc_ast_program *head = NULL;
+	struct mcc_ast_program *current = last;
+	while (current) {
+		struct mcc_ast_program *next = current->next_function;
+		current->next_function = head;
+		current->has_next_function = head != NULL;
+		current->node.sloc.end_line = last->node.sloc.end_line;
+		current->node.sloc.end_col = last->node.sloc.end_col;
+		head = current;
+		current = next;
 	}
-	mcc_parser_set_in(input, scanner);
+	return head;
+}
 
+// Parse the input the scanner was set up with and destroy the scanner afterwards
+static struct mcc_parser_result parse(yyscan_t scanner, enum mcc_parser_entry_point entry_point, char *name)
+{
 	struct mcc_parser_result result = {
 	    .status = MCC_PARSER_STATUS_OK,
 	    .error_buffer = NULL,
@@ -358,7 +360,10 @@ struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point
 		mcc_parser_set_extra(2, scanner);
 	}
 
-	if (yyparse(scanner, &result) != 0) {
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_PARSER);
+	int error = yyparse(scanner, &result);
+	mcc_alloc_set_phase(phase);
+	if (error != 0) {
 		result.status = MCC_PARSER_STATUS_UNKNOWN_ERROR;
 		if (!result.error_buffer) {
 			mcc_parser_lex_destroy(scanner);
@@ -374,6 +379,68 @@ struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point
 	return result;
 }
 
+struct mcc_parser_result mcc_parse_string(const char *input_string, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input_string);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+
+	// The scanner keeps its own copy of the string
+	if (!mcc_parser__scan_string(input_string, scanner)) {
+		mcc_parser_lex_destroy(scanner);
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
+		};
+	}
+
+	return parse(scanner, entry_point, name);
+}
+
+struct mcc_parser_result mcc_parse_input(struct mcc_input *input, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+
+	// Scan the buffer in place, including its two terminating NUL bytes
+	if (!mcc_parser__scan_buffer(input->buffer, input->size + 2, scanner)) {
+		mcc_parser_lex_destroy(scanner);
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNABLE_TO_OPEN_STREAM,
+		};
+	}
+
+	return parse(scanner, entry_point, name);
+}
+
+struct mcc_parser_result mcc_parse_file(FILE *input, enum mcc_parser_entry_point entry_point, char *name)
+{
+	assert(input);
+
+	yyscan_t scanner;
+	mcc_parser_lex_init(&scanner);
+	if (!scanner) {
+		return (struct mcc_parser_result){
+		    .status = MCC_PARSER_STATUS_UNKNOWN_ERROR,
+		};
+	}
+	mcc_parser_set_in(input, scanner);
+
+	return parse(scanner, entry_point, name);
+}
+
 void mcc_ast_delete_result(struct mcc_parser_result *result)
 {
 	assert(result);
@@ -418,7 +485,7 @@ void mcc_parser_error(struct MCC_PARSER_LTYPE *yylloc,
                       const char *msg)
 {
 	int size = strlen(msg) + length_of_int(yylloc->first_line) + length_of_int(yylloc->first_column) + strlen(result->filename) + 6;
-	result->error_buffer = (char *)malloc(sizeof(char) * size);
+	result->error_buffer = (char *)mcc_malloc(MCC_ALLOC_STRING, sizeof(char) * size);
 	if (!result->error_buffer)
 		return;
 	snprintf(result->error_buffer, size, "%s:%d:%d: %s\n", result->filename, yylloc->first_line, yylloc->first_column, msg);
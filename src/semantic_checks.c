@@ -6,7 +6,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
 #include "mcc/ast_visit.h"
+#include "mcc/thread_pool.h"
+#include "utils/hash_map.h"
 #include "utils/unused.h"
 
 #define not_zero(x) (x > 0 ? x : 1)
@@ -31,14 +34,18 @@
 // ------------------------------------------------------------- Forward declaration
 
 // Check and get type functions
-struct mcc_semantic_check_data_type *check_and_get_type_expression(struct mcc_ast_expression *expression,
-                                                                   struct mcc_semantic_check *check);
+static struct mcc_semantic_check_data_type check_and_get_type_expression(struct mcc_ast_expression *expression,
+                                                                         struct mcc_semantic_check *check,
+                                                                         enum mcc_semantic_check_error_code *error);
 
-struct mcc_semantic_check_data_type *check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
-                                                                   struct mcc_semantic_check *check,
-                                                                   struct mcc_symbol_table_row *row);
+static struct mcc_semantic_check_data_type check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
+                                                                         struct mcc_semantic_check *check,
+                                                                         enum mcc_semantic_check_error_code *error,
+                                                                         struct mcc_symbol_table_row *row);
 
-struct mcc_semantic_check_data_type *check_and_get_type_literal(struct mcc_ast_literal *literal, void *placeholder);
+static struct mcc_semantic_check_data_type check_and_get_type_literal(struct mcc_ast_literal *literal,
+                                                                      struct mcc_semantic_check *check,
+                                                                      enum mcc_semantic_check_error_code *error);
 
 // ------------------------------------------------------------- Functions: Error handling
 
@@ -59,13 +66,13 @@ err_to_check_with_sloc(struct mcc_semantic_check *check, struct mcc_ast_node nod
 
 	// +1 for terminating character
 	size_t size = sizeof(char) * (strlen(string) + get_sloc_string_size(node) + 1);
-	char *buffer = malloc(size);
+	char *buffer = mcc_malloc(MCC_ALLOC_STRING, size);
 	if (!buffer) {
 		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 	}
 	if (0 > snprintf(buffer, size, "%s:%d:%d: %s", node.sloc.filename, node.sloc.start_line, node.sloc.start_col,
 	                 string)) {
-		free(buffer);
+		mcc_free(MCC_ALLOC_STRING, buffer);
 		return MCC_SEMANTIC_CHECK_ERROR_SNPRINTF_FAILED;
 	}
 	check->error_buffer = buffer;
@@ -88,7 +95,7 @@ static enum mcc_semantic_check_error_code v_raise_error(int num,
 			char *temp;
 			for (int i = 0; i < num; i++) {
 				temp = va_arg(args, char *);
-				free(temp);
+				mcc_free(MCC_ALLOC_STRING, temp);
 			}
 		}
 		return MCC_SEMANTIC_CHECK_ERROR_OK;
@@ -117,7 +124,7 @@ static enum mcc_semantic_check_error_code v_raise_error(int num,
 
 	// Malloc buffer string
 	size_t size = sizeof(char) * (strlen(format_string) + args_size + 1);
-	char *buffer = malloc(size);
+	char *buffer = mcc_malloc(MCC_ALLOC_STRING, size);
 	if (!buffer) {
 		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
 	}
@@ -125,21 +132,21 @@ static enum mcc_semantic_check_error_code v_raise_error(int num,
 	// Get args again and print string into buffer
 	if (0 > vsnprintf(buffer, size, format_string, args_cp2)) {
 		va_end(args_cp2);
-		free(buffer);
+		mcc_free(MCC_ALLOC_STRING, buffer);
 		return MCC_SEMANTIC_CHECK_ERROR_SNPRINTF_FAILED;
 	}
 	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
 
 	// Write buffer string into check
 	error = err_to_check_with_sloc(check, node, buffer);
-	free(buffer);
+	mcc_free(MCC_ALLOC_STRING, buffer);
 
 	// If strings are from heap, free them
 	if (is_from_heap) {
 		char *temp;
 		for (int i = 0; i < num; i++) {
 			temp = va_arg(args, char *);
-			free(temp);
+			mcc_free(MCC_ALLOC_STRING, temp);
 		}
 	}
 
@@ -190,7 +197,7 @@ static enum mcc_semantic_check_error_code raise_type_error(enum mcc_semantic_che
 // Generate struct for semantic check
 struct mcc_semantic_check *mcc_semantic_check_initialize_check()
 {
-	struct mcc_semantic_check *check = malloc(sizeof(*check));
+	struct mcc_semantic_check *check = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*check));
 	if (check) {
 		check->status = MCC_SEMANTIC_CHECK_OK;
 		check->error_buffer = NULL;
@@ -198,34 +205,53 @@ struct mcc_semantic_check *mcc_semantic_check_initialize_check()
 	return check;
 }
 
-// Wrapper for running one of the checks with 2 early aborts:
-// Error code of the previous check is not OK: Error code is handed back immediately
-// Status code of the previous check is not OK: Abort with error code OK, but don't change check
-enum mcc_semantic_check_error_code
-run_check_early_abrt(enum mcc_semantic_check_error_code (*fctptr)(struct mcc_ast_program *ast,
-                                                                  struct mcc_symbol_table *table,
-                                                                  struct mcc_semantic_check *check),
-                     struct mcc_ast_program *ast,
-                     struct mcc_symbol_table *table,
-                     struct mcc_semantic_check *check,
-                     enum mcc_semantic_check_error_code previous_return)
+// The individual checks, in the order their errors are reported by mcc_semantic_check_run_all
+enum check_kind {
+	CHECK_TYPE,
+	CHECK_NONVOID,
+	CHECK_MAIN_FUNCTION,
+	CHECK_MULTIPLE_FUNCTION_DEFINITIONS,
+	CHECK_MULTIPLE_VARIABLE_DECLARATIONS,
+	CHECK_FUNCTION_ARGUMENTS,
+	CHECK_COUNT,
+};
+
+static enum mcc_semantic_check_error_code
+run_checks(struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *checks);
+
+// Move the error of a single check into check, unless check already failed
+static void take_error(struct mcc_semantic_check *check, struct mcc_semantic_check *from)
 {
+	if (check->status == MCC_SEMANTIC_CHECK_OK && from->status == MCC_SEMANTIC_CHECK_FAIL) {
+		check->status = MCC_SEMANTIC_CHECK_FAIL;
+		check->error_buffer = from->error_buffer;
+	} else {
+		mcc_free(MCC_ALLOC_STRING, from->error_buffer);
+	}
+	from->status = MCC_SEMANTIC_CHECK_OK;
+	from->error_buffer = NULL;
+}
 
+// Run all checks and only report the error of one of them
+static enum mcc_semantic_check_error_code run_single_check(enum check_kind kind,
+                                                           struct mcc_ast_program *ast,
+                                                           struct mcc_symbol_table *symbol_table,
+                                                           struct mcc_semantic_check *check)
+{
 	assert(ast);
-	assert(table);
+	assert(symbol_table);
 	assert(check);
-	assert(fctptr);
-
-	if (previous_return != MCC_SEMANTIC_CHECK_ERROR_OK) {
-		return previous_return;
-	}
 
-	if (check->status != MCC_SEMANTIC_CHECK_OK) {
-		return MCC_SEMANTIC_CHECK_ERROR_OK;
+	struct mcc_semantic_check checks[CHECK_COUNT];
+	enum mcc_semantic_check_error_code error = run_checks(ast, symbol_table, checks);
+	for (int i = 0; i < CHECK_COUNT; i++) {
+		if (i == (int)kind && error == MCC_SEMANTIC_CHECK_ERROR_OK) {
+			take_error(check, &checks[i]);
+		} else {
+			mcc_free(MCC_ALLOC_STRING, checks[i].error_buffer);
+		}
 	}
-
-	// Run the semantic check and return its return value
-	return (*fctptr)(ast, table, check);
+	return error;
 }
 
 // Run all semantic checks, returns NULL if library functions fail
@@ -235,75 +261,61 @@ struct mcc_semantic_check *mcc_semantic_check_run_all(struct mcc_ast_program *as
 	assert(ast);
 	assert(symbol_table);
 
-	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_SEMANTIC_CHECKS);
+	struct mcc_semantic_check checks[CHECK_COUNT];
+	enum mcc_semantic_check_error_code error = run_checks(ast, symbol_table, checks);
 
-	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
-	if (!check)
-		return NULL;
+	struct mcc_semantic_check *check = NULL;
+	if (error == MCC_SEMANTIC_CHECK_ERROR_OK)
+		check = mcc_semantic_check_initialize_check();
 
-	error = run_check_early_abrt(mcc_semantic_check_run_type_check, ast, symbol_table, check, error);
-	error = run_check_early_abrt(mcc_semantic_check_run_nonvoid_check, ast, symbol_table, check, error);
-	error = run_check_early_abrt(mcc_semantic_check_run_main_function, ast, symbol_table, check, error);
-	error =
-	    run_check_early_abrt(mcc_semantic_check_run_multiple_function_definitions, ast, symbol_table, check, error);
-	error = run_check_early_abrt(mcc_semantic_check_run_multiple_variable_declarations, ast, symbol_table, check,
-	                             error);
-	error = run_check_early_abrt(mcc_semantic_check_run_function_arguments, ast, symbol_table, check, error);
-
-	if (error != MCC_SEMANTIC_CHECK_ERROR_OK) {
-		mcc_semantic_check_delete_single_check(check);
-		return NULL;
+	// Report the error of the first check that failed
+	for (int i = 0; i < CHECK_COUNT; i++) {
+		if (check) {
+			take_error(check, &checks[i]);
+		} else {
+			mcc_free(MCC_ALLOC_STRING, checks[i].error_buffer);
+		}
 	}
+	mcc_alloc_set_phase(phase);
 	return check;
 }
 
 // ------------------------------------------------------------- check_and_get_type functionalities
 
-// getter for default data type
-static struct mcc_semantic_check_data_type *get_new_data_type()
+static struct mcc_semantic_check_data_type new_data_type(enum mcc_semantic_check_data_types type)
 {
-	struct mcc_semantic_check_data_type *type = malloc(sizeof(*type));
-	if (!type)
-		return NULL;
-	type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-	type->is_array = false;
-	type->array_size = -1;
-	return type;
+	return (struct mcc_semantic_check_data_type){.type = type, .array_size = -1, .is_array = false};
 }
 
-// get data type of given symbol tabel row
-static struct mcc_semantic_check_data_type *get_data_type_from_row(struct mcc_symbol_table_row *row)
+static enum mcc_semantic_check_data_types row_to_semantic_check_type(enum mcc_symbol_table_row_type type)
 {
-	assert(row);
-
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
-	switch (row->row_type) {
+	switch (type) {
 	case MCC_SYMBOL_TABLE_ROW_TYPE_INT:
-		type->type = MCC_SEMANTIC_CHECK_INT;
-		break;
+		return MCC_SEMANTIC_CHECK_INT;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_FLOAT:
-		type->type = MCC_SEMANTIC_CHECK_FLOAT;
-		break;
+		return MCC_SEMANTIC_CHECK_FLOAT;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_BOOL:
-		type->type = MCC_SEMANTIC_CHECK_BOOL;
-		break;
+		return MCC_SEMANTIC_CHECK_BOOL;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_STRING:
-		type->type = MCC_SEMANTIC_CHECK_STRING;
-		break;
+		return MCC_SEMANTIC_CHECK_STRING;
 	case MCC_SYMBOL_TABLE_ROW_TYPE_VOID:
-		type->type = MCC_SEMANTIC_CHECK_VOID;
-		break;
+		return MCC_SEMANTIC_CHECK_VOID;
 	default:
-		type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-		break;
+		return MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
+}
+
+// get data type of given symbol tabel row
+static struct mcc_semantic_check_data_type get_data_type_from_row(struct mcc_symbol_table_row *row)
+{
+	assert(row);
 
+	struct mcc_semantic_check_data_type type = new_data_type(row_to_semantic_check_type(row->row_type));
 	if (row->array_size != -1) {
-		type->is_array = true;
+		type.is_array = true;
 	}
-	type->array_size = row->array_size;
+	type.array_size = row->array_size;
 	return type;
 }
 
@@ -325,25 +337,52 @@ static enum mcc_semantic_check_data_types ast_to_semantic_check_type(enum mcc_as
 	}
 }
 
-static struct mcc_semantic_check_data_type *get_data_type_declaration(struct mcc_ast_declaration *decl,
-                                                                      struct mcc_semantic_check *check)
+static enum mcc_ast_types semantic_check_to_ast_type(enum mcc_semantic_check_data_types type)
+{
+	switch (type) {
+	case MCC_SEMANTIC_CHECK_INT:
+		return INT;
+	case MCC_SEMANTIC_CHECK_FLOAT:
+		return FLOAT;
+	case MCC_SEMANTIC_CHECK_BOOL:
+		return BOOL;
+	case MCC_SEMANTIC_CHECK_STRING:
+		return STRING;
+	default:
+		return VOID;
+	}
+}
+
+// placeholders unused but needed due to macro
+static struct mcc_semantic_check_data_type get_data_type_declaration(struct mcc_ast_declaration *decl,
+                                                                     struct mcc_semantic_check *check,
+                                                                     enum mcc_semantic_check_error_code *error)
 {
 	assert(decl);
 	UNUSED(check);
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
+	UNUSED(error);
+
+	struct mcc_semantic_check_data_type type;
 	if (decl->declaration_type == MCC_AST_DECLARATION_TYPE_VARIABLE) {
-		type->is_array = false;
-		type->type = ast_to_semantic_check_type(decl->variable_type->type_value);
+		type = new_data_type(ast_to_semantic_check_type(decl->variable_type->type_value));
 	} else {
-		type->is_array = true;
-		type->array_size = decl->array_size->i_value;
-		type->type = ast_to_semantic_check_type(decl->array_type->type_value);
+		type = new_data_type(ast_to_semantic_check_type(decl->array_type->type_value));
+		type.is_array = true;
+		type.array_size = decl->array_size->i_value;
 	}
 	return type;
 }
 
+// Keep the type of a checked expression in the AST, for the later stages
+static struct mcc_semantic_check_data_type set_expression_type(struct mcc_ast_expression *expression,
+                                                               struct mcc_semantic_check_data_type type)
+{
+	expression->data_type.type = semantic_check_to_ast_type(type.type);
+	expression->data_type.array_size = type.array_size;
+	expression->data_type.is_known = (type.type != MCC_SEMANTIC_CHECK_UNKNOWN);
+	return type;
+}
+
 static bool is_int(struct mcc_semantic_check_data_type *type)
 {
 	assert(type);
@@ -398,19 +437,19 @@ static char *to_string(struct mcc_semantic_check_data_type *type)
 		break;
 	}
 	size_t size = 11 + (size_t)floor(log10(not_zero(type->array_size)));
-	char *buffer = malloc(size);
+	char *buffer = mcc_malloc(MCC_ALLOC_STRING, size);
 	if (!buffer) {
 		return NULL;
 	}
 
 	if (type->is_array) {
 		if (0 > snprintf(buffer, size, "%s[%d]", type_string, type->array_size)) {
-			free(buffer);
+			mcc_free(MCC_ALLOC_STRING, buffer);
 			return NULL;
 		}
 	} else {
 		if (0 > snprintf(buffer, size, "%s", type_string)) {
-			free(buffer);
+			mcc_free(MCC_ALLOC_STRING, buffer);
 			return NULL;
 		}
 	}
@@ -419,161 +458,132 @@ static char *to_string(struct mcc_semantic_check_data_type *type)
 }
 
 // check and get type of binary expression. Returns MCC_SEMANTIC_CHECK_UNKNOWN if error occurs
-static struct mcc_semantic_check_data_type *check_and_get_type_binary_expression(struct mcc_ast_expression *expression,
-                                                                                 struct mcc_semantic_check *check)
+static struct mcc_semantic_check_data_type
+check_and_get_type_binary_expression(struct mcc_ast_expression *expression,
+                                     struct mcc_semantic_check *check,
+                                     enum mcc_semantic_check_error_code *error)
 {
 	assert(expression->lhs);
 	assert(expression->rhs);
 	assert(check);
 
 	bool success = false;
-	struct mcc_semantic_check_data_type *lhs = check_and_get_type(expression->lhs, check);
-	if (!lhs)
-		return NULL;
-	struct mcc_semantic_check_data_type *rhs = check_and_get_type(expression->rhs, check);
-	if (!rhs) {
-		free(lhs);
-		return NULL;
-	}
+	struct mcc_semantic_check_data_type lhs = check_and_get_type(expression->lhs, check, error);
+	struct mcc_semantic_check_data_type rhs = check_and_get_type(expression->rhs, check, error);
 	enum mcc_ast_binary_op op = expression->op;
 
 	switch (op) {
 	case MCC_AST_BINARY_OP_ADD:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SUB:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_MUL:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_DIV:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SMALLER:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_GREATER:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_SMALLEREQ:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_GREATEREQ:
-		success = types_equal(lhs, rhs) && !is_bool(lhs);
+		success = types_equal(&lhs, &rhs) && !is_bool(&lhs);
 		break;
 	case MCC_AST_BINARY_OP_CONJ:
-		success = is_bool(lhs) && is_bool(rhs);
+		success = is_bool(&lhs) && is_bool(&rhs);
 		break;
 	case MCC_AST_BINARY_OP_DISJ:
-		success = is_bool(lhs) && is_bool(rhs);
+		success = is_bool(&lhs) && is_bool(&rhs);
 		break;
 	case MCC_AST_BINARY_OP_EQUAL:
-		success = types_equal(lhs, rhs);
+		success = types_equal(&lhs, &rhs);
 		break;
 	case MCC_AST_BINARY_OP_NOTEQUAL:
-		success = types_equal(lhs, rhs);
+		success = types_equal(&lhs, &rhs);
 		break;
 	default:
 		break;
 	}
 
-	if (!success || lhs->is_array || rhs->is_array || is_string(lhs) || is_string(rhs)) {
-		if (mcc_semantic_check_raise_error(2, check, expression->node,
-		                                   "operation on incompatible types '%s' and '%s'.", true,
-		                                   to_string(lhs), to_string(rhs)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(rhs);
-			free(lhs);
-			return NULL;
-		}
-		lhs->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (!success || lhs.is_array || rhs.is_array || is_string(&lhs) || is_string(&rhs)) {
+		*error = mcc_semantic_check_raise_error(*error, 2, check, expression->node,
+		                                        "operation on incompatible types '%s' and '%s'.", true,
+		                                        to_string(&lhs), to_string(&rhs));
+		lhs.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
-	if (success && (lhs->type == MCC_SEMANTIC_CHECK_UNKNOWN)) {
-		if (mcc_semantic_check_raise_error(0, check, expression->node, "unknown type.", false) !=
-		    MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(rhs);
-			free(lhs);
-			return NULL;
-		}
+	if (success && (lhs.type == MCC_SEMANTIC_CHECK_UNKNOWN)) {
+		*error = mcc_semantic_check_raise_error(*error, 0, check, expression->node, "unknown type.", false);
 	}
 	if (!(op == MCC_AST_BINARY_OP_ADD || op == MCC_AST_BINARY_OP_SUB || op == MCC_AST_BINARY_OP_MUL ||
 	      op == MCC_AST_BINARY_OP_DIV)) {
-		lhs->type = MCC_SEMANTIC_CHECK_BOOL;
+		lhs.type = MCC_SEMANTIC_CHECK_BOOL;
 	}
-	free(rhs);
 	return lhs;
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_unary_expression(struct mcc_ast_expression *expression,
-                                                                         struct mcc_semantic_check *check)
+static struct mcc_semantic_check_data_type
+check_and_get_type_unary_expression(struct mcc_ast_expression *expression,
+                                    struct mcc_semantic_check *check,
+                                    enum mcc_semantic_check_error_code *error)
 {
 	assert(expression->type == MCC_AST_EXPRESSION_TYPE_UNARY_OP);
 	assert(expression->child);
 	assert(check);
 
-	struct mcc_semantic_check_data_type *child = check_and_get_type(expression->child, check);
-	if (!child)
-		return NULL;
+	struct mcc_semantic_check_data_type child = check_and_get_type(expression->child, check, error);
 	enum mcc_ast_unary_op u_op = expression->u_op;
 
-	if (child->is_array || is_string(child) || ((u_op == MCC_AST_UNARY_OP_NEGATIV) && is_bool(child)) ||
-	    ((u_op == MCC_AST_UNARY_OP_NOT) && !is_bool(child))) {
-		if (mcc_semantic_check_raise_error(1, check, expression->node,
-		                                   "unary operation not compatible with '%s'.", true,
-		                                   to_string(child)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(child);
-			return NULL;
-		}
-		child->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (child.is_array || is_string(&child) || ((u_op == MCC_AST_UNARY_OP_NEGATIV) && is_bool(&child)) ||
+	    ((u_op == MCC_AST_UNARY_OP_NOT) && !is_bool(&child))) {
+		*error = mcc_semantic_check_raise_error(*error, 1, check, expression->node,
+		                                        "unary operation not compatible with '%s'.", true,
+		                                        to_string(&child));
+		child.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
 	return child;
 }
 
 // get and check the type of an array element. Includes ensuring index to be of type 'INT'
-static struct mcc_semantic_check_data_type *check_and_get_type_array_element(struct mcc_ast_expression *array_element,
-                                                                             struct mcc_semantic_check *check)
+static struct mcc_semantic_check_data_type
+check_and_get_type_array_element(struct mcc_ast_expression *array_element,
+                                 struct mcc_semantic_check *check,
+                                 enum mcc_semantic_check_error_code *error)
 {
 	assert(array_element->type == MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT);
 	assert(check);
 
-	struct mcc_semantic_check_data_type *index = check_and_get_type(array_element->index, check);
-	if (!index)
-		return NULL;
-	struct mcc_semantic_check_data_type *identifier =
-	    check_and_get_type(array_element->array_identifier, check, array_element->array_row);
-	if (!identifier) {
-		free(index);
-		return NULL;
-	}
+	struct mcc_semantic_check_data_type index = check_and_get_type(array_element->index, check, error);
+	struct mcc_semantic_check_data_type identifier =
+	    check_and_get_type(array_element->array_identifier, check, error, array_element->array_row);
 	char *name = array_element->array_identifier->identifier_name;
-	if (!is_int(index)) {
-		if (mcc_semantic_check_raise_error(1, check, array_element->node, "expected type 'INT' but was '%s'.",
-		                                   true, to_string(index)) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(index);
-			free(identifier);
-			return NULL;
-		}
-		identifier->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-	}
-	if (!identifier->is_array) {
-		if (mcc_semantic_check_raise_error(1, check, array_element->node,
-		                                   "subscripted value '%s' is not an array.", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			free(index);
-			free(identifier);
-			return NULL;
-		}
-		identifier->type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	if (!is_int(&index)) {
+		*error = mcc_semantic_check_raise_error(*error, 1, check, array_element->node,
+		                                        "expected type 'INT' but was '%s'.", true, to_string(&index));
+		identifier.type = MCC_SEMANTIC_CHECK_UNKNOWN;
+	}
+	if (!identifier.is_array) {
+		*error = mcc_semantic_check_raise_error(*error, 1, check, array_element->node,
+		                                        "subscripted value '%s' is not an array.", false, name);
+		identifier.type = MCC_SEMANTIC_CHECK_UNKNOWN;
 	}
-	identifier->is_array = false;
-	identifier->array_size = -1;
-	free(index);
+	identifier.is_array = false;
+	identifier.array_size = -1;
 	return identifier;
 }
 
 // gets the type of a function call expression. Arguments are checked seperatly.
-static struct mcc_semantic_check_data_type *check_and_get_type_function_call(struct mcc_ast_expression *function_call,
-                                                                             struct mcc_semantic_check *check)
+static struct mcc_semantic_check_data_type
+check_and_get_type_function_call(struct mcc_ast_expression *function_call,
+                                 struct mcc_semantic_check *check,
+                                 enum mcc_semantic_check_error_code *error)
 {
 	assert(function_call->type == MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL);
 	assert(check);
@@ -583,76 +593,79 @@ static struct mcc_semantic_check_data_type *check_and_get_type_function_call(str
 	row = mcc_symbol_table_check_for_function_declaration(name, row);
 
 	if (!row) {
-		if (mcc_semantic_check_raise_error(1, check, function_call->node,
-		                                   "'%s' undeclared (first use in this function).", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return NULL;
-		}
-		return get_new_data_type();
-	} else {
-		return get_data_type_from_row(row);
+		*error = mcc_semantic_check_raise_error(*error, 1, check, function_call->node,
+		                                        "'%s' undeclared (first use in this function).", false, name);
+		return new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
 	}
+	return get_data_type_from_row(row);
 }
 
-// get the type of a literal, placeholder unused but needed due to macro
-struct mcc_semantic_check_data_type *check_and_get_type_literal(struct mcc_ast_literal *literal, void *placeholder)
+// get the type of a literal, placeholders unused but needed due to macro
+static struct mcc_semantic_check_data_type check_and_get_type_literal(struct mcc_ast_literal *literal,
+                                                                      struct mcc_semantic_check *check,
+                                                                      enum mcc_semantic_check_error_code *error)
 {
 	assert(literal);
-	UNUSED(placeholder);
-
-	struct mcc_semantic_check_data_type *type = get_new_data_type();
-	if (!type)
-		return NULL;
+	UNUSED(check);
+	UNUSED(error);
 
 	switch (literal->type) {
 	case MCC_AST_LITERAL_TYPE_INT:
-		type->type = MCC_SEMANTIC_CHECK_INT;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_INT);
 	case MCC_AST_LITERAL_TYPE_FLOAT:
-		type->type = MCC_SEMANTIC_CHECK_FLOAT;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_FLOAT);
 	case MCC_AST_LITERAL_TYPE_BOOL:
-		type->type = MCC_SEMANTIC_CHECK_BOOL;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_BOOL);
 	case MCC_AST_LITERAL_TYPE_STRING:
-		type->type = MCC_SEMANTIC_CHECK_STRING;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_STRING);
 	default:
-		type->type = MCC_SEMANTIC_CHECK_UNKNOWN;
-		break;
+		return new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
 	}
-	return type;
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_expression(struct mcc_ast_expression *expression,
-                                                                   struct mcc_semantic_check *check)
+// Errors are raised into check, the type is kept in the expression
+static struct mcc_semantic_check_data_type check_and_get_type_expression(struct mcc_ast_expression *expression,
+                                                                         struct mcc_semantic_check *check,
+                                                                         enum mcc_semantic_check_error_code *error)
 {
 	assert(expression);
 	assert(check);
+	assert(error);
 
+	struct mcc_semantic_check_data_type type;
 	switch (expression->type) {
 	case MCC_AST_EXPRESSION_TYPE_LITERAL:
-		return check_and_get_type(expression->literal, NULL);
+		type = check_and_get_type(expression->literal, check, error);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
-		return check_and_get_type_binary_expression(expression, check);
+		type = check_and_get_type_binary_expression(expression, check, error);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_PARENTH:
-		return check_and_get_type(expression->expression, check);
+		type = check_and_get_type(expression->expression, check, error);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
-		return check_and_get_type_unary_expression(expression, check);
+		type = check_and_get_type_unary_expression(expression, check, error);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_VARIABLE:
-		return check_and_get_type(expression->identifier, check, expression->variable_row);
+		type = check_and_get_type(expression->identifier, check, error, expression->variable_row);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
-		return check_and_get_type_array_element(expression, check);
+		type = check_and_get_type_array_element(expression, check, error);
+		break;
 	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
-		return check_and_get_type_function_call(expression, check);
+		type = check_and_get_type_function_call(expression, check, error);
+		break;
 	default:
-		return NULL;
+		type = new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
+		break;
 	}
+	return set_expression_type(expression, type);
 }
 
-struct mcc_semantic_check_data_type *check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
-                                                                   struct mcc_semantic_check *check,
-                                                                   struct mcc_symbol_table_row *row)
+static struct mcc_semantic_check_data_type check_and_get_type_identifier(struct mcc_ast_identifier *identifier,
+                                                                         struct mcc_semantic_check *check,
+                                                                         enum mcc_semantic_check_error_code *error,
+                                                                         struct mcc_symbol_table_row *row)
 {
 	assert(identifier);
 	assert(check);
@@ -661,271 +674,187 @@ struct mcc_semantic_check_data_type *check_and_get_type_identifier(struct mcc_as
 	char *name = identifier->identifier_name;
 	row = mcc_symbol_table_check_upwards_for_declaration(name, row);
 	if (!row) {
-		if (mcc_semantic_check_raise_error(1, check, identifier->node,
-		                                   "'%s' undeclared (first use in this function).", false,
-		                                   name) != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return NULL;
-		}
-		return get_new_data_type();
+		*error = mcc_semantic_check_raise_error(*error, 1, check, identifier->node,
+		                                        "'%s' undeclared (first use in this function).", false, name);
+		return new_data_type(MCC_SEMANTIC_CHECK_UNKNOWN);
 	}
 
 	return get_data_type_from_row(row);
 }
 
-// ------------------------------------------------------------- type checker
+// ------------------------------------------------------------- State of the checks
 
-// struct for user data concerning the type checker
-struct return_value_userdata {
-	struct mcc_semantic_check *check;
-	struct mcc_semantic_check_data_type *function_type;
+// All checks share a single traversal of each function. Each check keeps its own first error, so that the errors are
+// the same as if the checks ran one after another.
+struct checks_userdata {
+	struct mcc_semantic_check *checks;
 	enum mcc_semantic_check_error_code error;
-};
 
-static void cb_return_value(struct mcc_ast_statement *statement, void *r_v_userdata)
-{
-	assert(statement);
-	assert(r_v_userdata);
+	// Type errors of the current function. Its return values are checked before its other statements.
+	struct mcc_ast_function_definition *function;
+	struct mcc_semantic_check return_check;
+	struct mcc_semantic_check statement_check;
 
-	struct return_value_userdata *userdata = r_v_userdata;
-	struct mcc_semantic_check *check = userdata->check;
-	struct mcc_semantic_check_data_type *function_type = userdata->function_type;
-	struct mcc_semantic_check_data_type *return_type = NULL;
-	if (statement->return_value) {
-		return_type = check_and_get_type(statement->return_value, check);
-		if (!return_type) {
-			userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-			return;
-		}
-	} else {
-		return_type = get_new_data_type();
-		if (!return_type) {
-			userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-			return;
-		}
-		return_type->type = MCC_SEMANTIC_CHECK_VOID;
-	}
-	if (!types_equal(function_type, return_type)) {
-		userdata->error =
-		    mcc_semantic_check_raise_error(userdata->error, 2, check, statement->return_value->node,
-		                                   "return value of type '%s', expected '%s'.", true,
-		                                   to_string(return_type), to_string(function_type));
-	}
-	free(return_type);
-}
+	// Last definition of each function name, for checking function calls
+	struct mcc_hash_map *functions;
+};
 
-// Setup an AST Visitor for checking that return values have the correct type
-static struct mcc_ast_visitor return_value_visitor(struct return_value_userdata *r_v_userdata)
+// Report the type errors of the function checked last
+static void end_function(struct checks_userdata *data)
 {
-	return (struct mcc_ast_visitor){
-	    .order = MCC_AST_VISIT_PRE_ORDER,
+	take_error(&data->checks[CHECK_TYPE], &data->return_check);
+	take_error(&data->checks[CHECK_TYPE], &data->statement_check);
+	data->function = NULL;
+}
 
-	    .userdata = r_v_userdata,
+// ------------------------------------------------------------- type checker
 
-	    .statement_return = cb_return_value,
-	};
-}
+static void check_calls(struct mcc_ast_expression *expression, struct checks_userdata *data);
 
-static void cb_type_check_return_value(struct mcc_ast_function_definition *function, void *data)
+static void cb_type_check_return_value(struct mcc_ast_statement *statement, void *userdata)
 {
-	assert(function);
-	assert(data);
+	assert(statement);
+	assert(userdata);
 
-	struct type_checking_userdata *t_c_userdata = data;
-	struct return_value_userdata *r_v_userdata = malloc(sizeof(*r_v_userdata));
-	if (!r_v_userdata) {
-		t_c_userdata->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-		return;
+	struct checks_userdata *data = userdata;
+	struct mcc_semantic_check *check = &data->return_check;
+	assert(data->function);
+
+	struct mcc_semantic_check_data_type function_type =
+	    new_data_type(ast_to_semantic_check_type(data->function->type));
+	struct mcc_semantic_check_data_type return_type = new_data_type(MCC_SEMANTIC_CHECK_VOID);
+	if (statement->return_value) {
+		return_type = check_and_get_type(statement->return_value, check, &data->error);
 	}
-	r_v_userdata->check = t_c_userdata->check;
-	r_v_userdata->error = t_c_userdata->error;
-	r_v_userdata->function_type = get_new_data_type();
-	if (!r_v_userdata->function_type) {
-		t_c_userdata->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-		return;
+	if (!types_equal(&function_type, &return_type)) {
+		struct mcc_ast_node node = statement->return_value ? statement->return_value->node : statement->node;
+		data->error = mcc_semantic_check_raise_error(data->error, 2, check, node,
+		                                             "return value of type '%s', expected '%s'.", true,
+		                                             to_string(&return_type), to_string(&function_type));
 	}
-	r_v_userdata->function_type->type = ast_to_semantic_check_type(function->type);
 
-	struct mcc_ast_visitor visitor = return_value_visitor(r_v_userdata);
-	mcc_ast_visit(function, &visitor);
-	t_c_userdata->error = r_v_userdata->error;
-	r_v_userdata->error = 0;
-	r_v_userdata->check = NULL;
-	free(r_v_userdata->function_type);
-	free(r_v_userdata);
+	if (statement->return_value)
+		check_calls(statement->return_value, data);
 }
 
-static void cb_type_conversion_assignment(struct mcc_ast_statement *statement, void *data)
+static void cb_type_conversion_assignment(struct mcc_ast_statement *statement, void *userdata)
 {
 	assert(statement);
-	assert(data);
+	assert(userdata);
 
-	struct type_checking_userdata *userdata = data;
-	struct mcc_semantic_check *check = userdata->check;
+	struct checks_userdata *data = userdata;
+	struct mcc_semantic_check *check = &data->statement_check;
 	struct mcc_ast_assignment *assignment = statement->assignment;
-	struct mcc_semantic_check_data_type *lhs_type = NULL, *rhs_type = NULL, *index = NULL;
+	struct mcc_semantic_check_data_type lhs_type, rhs_type;
+	struct mcc_semantic_check_data_type index = new_data_type(MCC_SEMANTIC_CHECK_INT);
+	bool is_array_assignment = false;
 
 	switch (assignment->assignment_type) {
 	case MCC_AST_ASSIGNMENT_TYPE_VARIABLE:
-		lhs_type = check_and_get_type(assignment->variable_identifier, check, assignment->row);
-		rhs_type = check_and_get_type(assignment->variable_assigned_value, check);
+		lhs_type = check_and_get_type(assignment->variable_identifier, check, &data->error, assignment->row);
+		rhs_type = check_and_get_type(assignment->variable_assigned_value, check, &data->error);
 		break;
 	case MCC_AST_ASSIGNMENT_TYPE_ARRAY:
-		lhs_type = check_and_get_type(assignment->array_identifier, check, assignment->row);
-		rhs_type = check_and_get_type(assignment->array_assigned_value, check);
-		index = check_and_get_type(assignment->array_index, check);
+		lhs_type = check_and_get_type(assignment->array_identifier, check, &data->error, assignment->row);
+		rhs_type = check_and_get_type(assignment->array_assigned_value, check, &data->error);
+		index = check_and_get_type(assignment->array_index, check, &data->error);
+		is_array_assignment = true;
 		break;
 	default:
 		return;
 	}
 
-	if (!lhs_type || !rhs_type || (!index && assignment->assignment_type == MCC_AST_ASSIGNMENT_TYPE_ARRAY)) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-		free(lhs_type);
-		free(rhs_type);
-		free(index);
-		return;
+	if (is_array_assignment) {
+		lhs_type.is_array = false;
+		lhs_type.array_size = -1;
+	}
+	if (is_array_assignment && !is_int(&index)) {
+		data->error = mcc_semantic_check_raise_error(data->error, 0, check, assignment->node,
+		                                             "array subscript is not an integer.", false);
+	} else if (!types_equal(&lhs_type, &rhs_type)) {
+		data->error =
+		    mcc_semantic_check_raise_error(data->error, 2, check, assignment->node,
+		                                   "implicit type conversion. Expected '%s' but was '%s'", true,
+		                                   to_string(&lhs_type), to_string(&rhs_type));
+	} else if (lhs_type.is_array) {
+		data->error =
+		    mcc_semantic_check_raise_error(data->error, 0, check, assignment->node,
+		                                   "assignment to Variable of array type not possible.", false);
+	}
+
+	// Function calls are checked in the order of the AST
+	if (is_array_assignment) {
+		check_calls(assignment->array_index, data);
+		check_calls(assignment->array_assigned_value, data);
 	} else {
-		if (assignment->assignment_type == MCC_AST_ASSIGNMENT_TYPE_ARRAY) {
-			lhs_type->is_array = false;
-			lhs_type->array_size = -1;
-		}
-		if (index && !is_int(index)) {
-			userdata->error = mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
-			                                                 "array subscript is not an integer.", false);
-		} else if (!types_equal(lhs_type, rhs_type)) {
-			userdata->error =
-			    mcc_semantic_check_raise_error(userdata->error, 2, check, assignment->node,
-			                                   "implicit type conversion. Expected '%s' but was '%s'", true,
-			                                   to_string(lhs_type), to_string(rhs_type));
-		} else if (lhs_type->is_array) {
-			userdata->error =
-			    mcc_semantic_check_raise_error(userdata->error, 0, check, assignment->node,
-			                                   "assignment to Variable of array type not possible.", false);
-		}
+		check_calls(assignment->variable_assigned_value, data);
 	}
-	free(lhs_type);
-	free(rhs_type);
-	free(index);
 }
 
-static void cb_type_check_if_stmt(struct mcc_ast_statement *statement, void *data)
+// Conditions of if-statements and while-loops have to be of type 'BOOL'
+static void check_condition(struct mcc_ast_expression *condition, struct checks_userdata *data, const char *message)
 {
-	assert(statement->if_condition);
+	assert(condition);
 	assert(data);
 
-	struct type_checking_userdata *userdata = data;
-	struct mcc_semantic_check *check = userdata->check;
-	struct mcc_ast_expression *if_condition = statement->if_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(if_condition, check);
+	struct mcc_semantic_check *check = &data->statement_check;
+	struct mcc_semantic_check_data_type type = check_and_get_type(condition, check, &data->error);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
-		userdata->error = mcc_semantic_check_raise_error(
-		    userdata->error, 1, check, if_condition->node,
-		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(type));
+	if (!is_bool(&type)) {
+		data->error = mcc_semantic_check_raise_error(data->error, 1, check, condition->node, message, true,
+		                                             to_string(&type));
 	}
-	free(type);
+	check_calls(condition, data);
 }
 
-static void cb_type_check_if_else_stmt(struct mcc_ast_statement *statement, void *data)
+static void cb_type_check_if_stmt(struct mcc_ast_statement *statement, void *userdata)
 {
-	assert(statement->if_else_condition);
-	assert(data);
-
-	struct type_checking_userdata *userdata = data;
-	struct mcc_semantic_check *check = userdata->check;
-	struct mcc_ast_expression *if_condition = statement->if_else_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(if_condition, check);
+	assert(statement->if_condition);
+	assert(userdata);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
-		userdata->error = mcc_semantic_check_raise_error(
-		    userdata->error, 1, check, if_condition->node,
-		    "condition of if-statement of type '%s', expected type 'BOOL'.", true, to_string(type));
-	}
-	free(type);
+	check_condition(statement->if_condition, userdata,
+	                "condition of if-statement of type '%s', expected type 'BOOL'.");
 }
 
-static void cb_type_check_while_stmt(struct mcc_ast_statement *statement, void *data)
+static void cb_type_check_if_else_stmt(struct mcc_ast_statement *statement, void *userdata)
 {
-	assert(statement->while_condition);
-	assert(data);
-
-	struct type_checking_userdata *userdata = data;
-	struct mcc_semantic_check *check = userdata->check;
-	struct mcc_ast_expression *while_condition = statement->while_condition;
-	struct mcc_semantic_check_data_type *type = check_and_get_type(while_condition, check);
+	assert(statement->if_else_condition);
+	assert(userdata);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	} else if (!is_bool(type)) {
-		userdata->error = mcc_semantic_check_raise_error(
-		    userdata->error, 1, check, while_condition->node,
-		    "condition of while-loop of type '%s', expected type 'BOOL'.", true, to_string(type));
-	}
-	free(type);
+	check_condition(statement->if_else_condition, userdata,
+	                "condition of if-statement of type '%s', expected type 'BOOL'.");
 }
 
-static void cb_type_check_expression_stmt(struct mcc_ast_statement *statement, void *data)
+static void cb_type_check_while_stmt(struct mcc_ast_statement *statement, void *userdata)
 {
-	assert(statement->stmt_expression);
-	assert(data);
-
-	struct type_checking_userdata *userdata = data;
-	struct mcc_semantic_check *check = userdata->check;
-	struct mcc_ast_expression *expression = statement->stmt_expression;
-	// check the expression. No Error handling needed
-	struct mcc_semantic_check_data_type *type = check_and_get_type(expression, check);
+	assert(statement->while_condition);
+	assert(userdata);
 
-	if (!type) {
-		userdata->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-	}
-	free(type);
+	check_condition(statement->while_condition, userdata,
+	                "condition of while-loop of type '%s', expected type 'BOOL'.");
 }
 
-static struct mcc_ast_visitor type_checking_visitor(struct type_checking_userdata *userdata)
+static void cb_type_check_expression_stmt(struct mcc_ast_statement *statement, void *userdata)
 {
-	return (struct mcc_ast_visitor){
-	    .order = MCC_AST_VISIT_PRE_ORDER,
-
-	    .userdata = userdata,
+	assert(statement->stmt_expression);
+	assert(userdata);
 
-	    .statement_assignment = cb_type_conversion_assignment,
-	    .statement_if_stmt = cb_type_check_if_stmt,
-	    .statement_if_else_stmt = cb_type_check_if_else_stmt,
-	    .statement_while = cb_type_check_while_stmt,
-	    .statement_expression_stmt = cb_type_check_expression_stmt,
-	    .function_definition = cb_type_check_return_value,
-	};
+	struct checks_userdata *data = userdata;
+	// check the expression. No Error handling needed
+	check_and_get_type(statement->stmt_expression, &data->statement_check, &data->error);
+	check_calls(statement->stmt_expression, data);
 }
 
 enum mcc_semantic_check_error_code mcc_semantic_check_run_type_check(struct mcc_ast_program *ast,
                                                                      struct mcc_symbol_table *symbol_table,
                                                                      struct mcc_semantic_check *check)
 {
-	UNUSED(symbol_table);
-
-	struct type_checking_userdata *userdata = malloc(sizeof(*userdata));
-	if (!userdata) {
-		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-	}
-	userdata->check = check;
-	userdata->error = MCC_SEMANTIC_CHECK_ERROR_OK;
-	enum mcc_semantic_check_error_code error;
-
-	struct mcc_ast_visitor visitor = type_checking_visitor(userdata);
-	mcc_ast_visit(ast, &visitor);
-	error = userdata->error;
-	userdata->check = NULL;
-	free(userdata);
-	return error;
+	return run_single_check(CHECK_TYPE, ast, symbol_table, check);
 }
 
 // ------------------------------------------------------------- check execution paths of non-void functions
 
-static bool recursively_check_nonvoid_property(struct mcc_ast_compound_statement *compound_statement);
+static bool check_nonvoid_property_compound(struct mcc_ast_compound_statement *compound_statement);
 static bool check_nonvoid_property(struct mcc_ast_statement *statement);
 
 static bool check_nonvoid_property(struct mcc_ast_statement *statement)
@@ -940,141 +869,140 @@ static bool check_nonvoid_property(struct mcc_ast_statement *statement)
 	case MCC_AST_STATEMENT_TYPE_RETURN:
 		return true;
 	case MCC_AST_STATEMENT_TYPE_COMPOUND_STMT:
-		return recursively_check_nonvoid_property(statement->compound_statement);
+		return check_nonvoid_property_compound(statement->compound_statement);
 	default:
 		return false;
 	}
 }
 
-static bool recursively_check_nonvoid_property(struct mcc_ast_compound_statement *compound_statement)
+static bool check_nonvoid_property_compound(struct mcc_ast_compound_statement *compound_statement)
 {
-	if (!compound_statement)
-		return false;
-
-	return (check_nonvoid_property(compound_statement->statement) ||
-	        recursively_check_nonvoid_property(compound_statement->next_compound_statement));
+	while (compound_statement) {
+		if (check_nonvoid_property(compound_statement->statement))
+			return true;
+		compound_statement = compound_statement->next_compound_statement;
+	}
+	return false;
 }
 
-static enum mcc_semantic_check_error_code run_nonvoid_check(struct mcc_ast_function_definition *function,
-                                                            struct mcc_semantic_check *check)
+// Starts checking a function body, the type errors of the previous function are complete
+static void cb_function_definition(struct mcc_ast_function_definition *function, void *userdata)
 {
 	assert(function);
-	assert(check);
+	assert(userdata);
 
-	if (function->type == VOID)
-		return MCC_SEMANTIC_CHECK_ERROR_OK;
+	struct checks_userdata *data = userdata;
+	end_function(data);
+	data->function = function;
 
-	if (recursively_check_nonvoid_property(function->compound_stmt) == false) {
-		return mcc_semantic_check_raise_error(1, check, function->node,
-		                                      "control reaches end of non-void function '%s'.", false,
-		                                      function->identifier->identifier_name);
+	if (function->type != VOID && !check_nonvoid_property_compound(function->compound_stmt)) {
+		data->error = mcc_semantic_check_raise_error(
+		    data->error, 1, &data->checks[CHECK_NONVOID], function->node,
+		    "control reaches end of non-void function '%s'.", false, function->identifier->identifier_name);
 	}
-	return MCC_SEMANTIC_CHECK_ERROR_OK;
 }
 
 enum mcc_semantic_check_error_code mcc_semantic_check_run_nonvoid_check(struct mcc_ast_program *ast,
                                                                         struct mcc_symbol_table *symbol_table,
                                                                         struct mcc_semantic_check *check)
 {
-	UNUSED(symbol_table);
-	assert(ast);
-	assert(check);
-	assert(!check->error_buffer);
-	assert(check->status == MCC_SEMANTIC_CHECK_OK);
-
-	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
-
-	do {
-		error = run_nonvoid_check(ast->function, check);
-		if (error != MCC_SEMANTIC_CHECK_ERROR_OK)
-			break;
-		ast = ast->next_function;
-	} while (ast);
-
-	return error;
+	return run_single_check(CHECK_NONVOID, ast, symbol_table, check);
 }
 
 // ------------------------------------------------------------- checking for correct main function
 
-enum mcc_semantic_check_error_code mcc_semantic_check_run_main_function(struct mcc_ast_program *ast,
-                                                                        struct mcc_symbol_table *symbol_table,
-                                                                        struct mcc_semantic_check *check)
+// Errors refer to the first function of the program, which gives the filename
+static void check_main_function(struct mcc_ast_program *program,
+                                struct mcc_ast_program *first_function,
+                                int *number_of_mains,
+                                struct checks_userdata *data)
 {
-	UNUSED(symbol_table);
-	assert(ast);
-	assert(symbol_table);
-	assert(check);
-	assert(check->status == MCC_SEMANTIC_CHECK_OK);
-	assert(!check->error_buffer);
-
-	// Memorize AST entry point to get the correct filename later
-	struct mcc_ast_program *original_ast = ast;
-	int number_of_mains = 0;
-
-	do {
-		if (strcmp(ast->function->identifier->identifier_name, "main") == 0) {
-			number_of_mains += 1;
-			if (number_of_mains > 1) {
-				return mcc_semantic_check_raise_error(0, check, original_ast->node,
-				                                      "Too many main functions defined.", false);
-			}
-			if (!(ast->function->parameters->is_empty)) {
-				return mcc_semantic_check_raise_error(0, check, original_ast->node,
-				                                      "Main has wrong signature. "
-				                                      "Must be `int main()`.",
-				                                      false);
-			}
+	struct mcc_semantic_check *check = &data->checks[CHECK_MAIN_FUNCTION];
+
+	if (strcmp(program->function->identifier->identifier_name, "main") == 0) {
+		*number_of_mains += 1;
+		if (*number_of_mains > 1) {
+			data->error = mcc_semantic_check_raise_error(data->error, 0, check, first_function->node,
+			                                             "Too many main functions defined.", false);
+		} else if (!(program->function->parameters->is_empty)) {
+			data->error = mcc_semantic_check_raise_error(data->error, 0, check, first_function->node,
+			                                             "Main has wrong signature. "
+			                                             "Must be `int main()`.",
+			                                             false);
 		}
-		ast = ast->next_function;
-	} while (ast);
-
-	if (number_of_mains == 0) {
-		return mcc_semantic_check_raise_error(0, check, original_ast->node, "No main function defined.", false);
 	}
+}
 
-	return MCC_SEMANTIC_CHECK_ERROR_OK;
+enum mcc_semantic_check_error_code mcc_semantic_check_run_main_function(struct mcc_ast_program *ast,
+                                                                        struct mcc_symbol_table *symbol_table,
+                                                                        struct mcc_semantic_check *check)
+{
+	return run_single_check(CHECK_MAIN_FUNCTION, ast, symbol_table, check);
 }
 
 // ------------------------------------------------------------- check for multiple function definitions
 
-enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_function_definitions(
-    struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *check)
+// Checks on the list of functions, which also registers the functions for checking calls
+static void check_function_definitions(struct mcc_ast_program *ast, struct checks_userdata *data)
 {
-	UNUSED(symbol_table);
-	assert(check);
-	assert(!check->error_buffer);
 	assert(ast);
+	assert(data);
 
-	struct mcc_ast_program *program_to_check = ast;
+	// Map every function name to its first definition and mark first definitions that are redefined later
+	struct mcc_hash_map *first_definitions = mcc_hash_map_new(MCC_HASH_MAP_KEY_POINTER);
+	struct mcc_hash_map *redefined = mcc_hash_map_new(MCC_HASH_MAP_KEY_POINTER);
+	if (!first_definitions || !redefined) {
+		mcc_hash_map_delete(first_definitions);
+		mcc_hash_map_delete(redefined);
+		data->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+		return;
+	}
 
-	// Program has only one function
-	if (!program_to_check->next_function) {
-		return MCC_SEMANTIC_CHECK_ERROR_OK;
+	int insert_failed = 0;
+	int number_of_mains = 0;
+	// An empty program has no function
+	for (struct mcc_ast_program *program = ast; program && program->function;
+	     program = program->next_function) {
+		char *name = program->function->identifier->identifier_name;
+		struct mcc_ast_program *first = mcc_hash_map_lookup(first_definitions, name);
+		if (first) {
+			insert_failed += mcc_hash_map_insert(redefined, first, first);
+		} else {
+			insert_failed += mcc_hash_map_insert(first_definitions, name, program);
+		}
+		insert_failed += mcc_hash_map_insert(data->functions, name, program->function);
+		check_main_function(program, ast, &number_of_mains, data);
 	}
 
-	while (program_to_check->next_function) {
-		struct mcc_ast_program *program_to_compare = program_to_check->next_function;
-		char *name_of_check = program_to_check->function->identifier->identifier_name;
-		char *name_of_compare = program_to_compare->function->identifier->identifier_name;
+	if (number_of_mains == 0) {
+		data->error = mcc_semantic_check_raise_error(data->error, 0, &data->checks[CHECK_MAIN_FUNCTION],
+		                                             ast->node, "No main function defined.", false);
+	}
 
-		if (strcmp(name_of_check, name_of_compare) == 0) {
-			return mcc_semantic_check_raise_error(1, check, program_to_check->node, "redefinition of '%s'.",
-			                                      false, name_of_compare);
-		}
-		// compare all next_functions
-		while (program_to_compare->next_function) {
-			program_to_compare = program_to_compare->next_function;
-			char *name_of_compare = program_to_compare->function->identifier->identifier_name;
-			if (strcmp(name_of_check, name_of_compare) == 0) {
-				return mcc_semantic_check_raise_error(1, check, program_to_check->node,
-				                                      "redefinition of '%s'.", false, name_of_compare);
+	// Report the first function that is redefined, builtins count as defined after all user functions
+	if (insert_failed) {
+		data->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+	} else {
+		for (struct mcc_ast_program *program = ast; program && program->function;
+		     program = program->next_function) {
+			if (mcc_hash_map_contains(redefined, program) ||
+			    mcc_symbol_table_get_builtin(program->function->identifier->identifier_name)) {
+				data->error = mcc_semantic_check_raise_error(
+				    data->error, 1, &data->checks[CHECK_MULTIPLE_FUNCTION_DEFINITIONS], program->node,
+				    "redefinition of '%s'.", false, program->function->identifier->identifier_name);
+				break;
 			}
 		}
-
-		program_to_check = program_to_check->next_function;
 	}
 
-	return MCC_SEMANTIC_CHECK_ERROR_OK;
+	mcc_hash_map_delete(first_definitions);
+	mcc_hash_map_delete(redefined);
+}
+
+enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_function_definitions(
+    struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *check)
+{
+	return run_single_check(CHECK_MULTIPLE_FUNCTION_DEFINITIONS, ast, symbol_table, check);
 }
 
 // ------------------------------------------------------------- check for multiple variable declarations
@@ -1105,26 +1033,19 @@ check_scope_for_multiple_variable_declaration(struct mcc_symbol_table_scope *sco
 		}
 	}
 
-	struct mcc_symbol_table_row *row_to_compare = NULL;
+	// A row is redeclared if a later row links to it as its previous declaration. Report the earliest such row at its
+	// next declaration.
+	struct mcc_symbol_table_row *redeclaration = NULL;
 	while (row_to_check->next_row) {
-
-		row_to_compare = row_to_check->next_row;
-
-		if (strcmp(row_to_check->name, row_to_compare->name) == 0) {
-			return mcc_semantic_check_raise_error(1, check, *(row_to_compare->node),
-			                                      "redefinition of '%s'.", false, row_to_check->name);
-		}
-
-		while (row_to_compare->next_row) {
-			row_to_compare = row_to_compare->next_row;
-			if (strcmp(row_to_check->name, row_to_compare->name) == 0) {
-				return mcc_semantic_check_raise_error(1, check, *(row_to_compare->node),
-				                                      "redefinition of '%s'.", false,
-				                                      row_to_check->name);
-			}
-		}
-
 		row_to_check = row_to_check->next_row;
+		struct mcc_symbol_table_row *declaration = row_to_check->prev_declaration;
+		if (declaration && (!redeclaration || declaration->position < redeclaration->prev_declaration->position)) {
+			redeclaration = row_to_check;
+		}
+	}
+	if (redeclaration) {
+		return mcc_semantic_check_raise_error(1, check, *(redeclaration->node), "redefinition of '%s'.", false,
+		                                      redeclaration->name);
 	}
 
 	if (row_to_check->child_scope) {
@@ -1133,40 +1054,30 @@ check_scope_for_multiple_variable_declaration(struct mcc_symbol_table_scope *sco
 	return error;
 }
 
-enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_variable_declarations(
-    struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *check)
+// Works on the scopes of the symbol table instead of the AST
+static void check_multiple_variable_declarations(struct mcc_symbol_table *symbol_table, struct checks_userdata *data)
 {
-	UNUSED(ast);
-	assert(ast);
-	assert(check);
-	assert(!check->error_buffer);
-	assert(check->status == MCC_SEMANTIC_CHECK_OK);
-
-	struct mcc_symbol_table_scope *scope = symbol_table->head;
-	struct mcc_symbol_table_row *function_row = scope->head;
-	enum mcc_semantic_check_error_code error = MCC_SEMANTIC_CHECK_ERROR_OK;
+	assert(symbol_table);
+	assert(data);
 
-	do {
+	struct mcc_semantic_check *check = &data->checks[CHECK_MULTIPLE_VARIABLE_DECLARATIONS];
+	struct mcc_symbol_table_row *function_row = symbol_table->head->head;
+	while (function_row && check->status == MCC_SEMANTIC_CHECK_OK && data->error == MCC_SEMANTIC_CHECK_ERROR_OK) {
 		if (function_row->child_scope) {
-			error = check_scope_for_multiple_variable_declaration(function_row->child_scope, check);
-		}
-		if (check->status != MCC_SEMANTIC_CHECK_OK || error != MCC_SEMANTIC_CHECK_ERROR_OK) {
-			return error;
+			data->error = check_scope_for_multiple_variable_declaration(function_row->child_scope, check);
 		}
 		function_row = function_row->next_row;
-	} while (function_row);
+	}
+}
 
-	return error;
+enum mcc_semantic_check_error_code mcc_semantic_check_run_multiple_variable_declarations(
+    struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *check)
+{
+	return run_single_check(CHECK_MULTIPLE_VARIABLE_DECLARATIONS, ast, symbol_table, check);
 }
 
 // ------------------------------------------------------------- No invalid function calls
 
-struct function_arguments_userdata {
-	struct mcc_semantic_check *check;
-	struct mcc_ast_program *program;
-	enum mcc_semantic_check_error_code error;
-};
-
 static int get_number_of_params(struct mcc_ast_parameters *parameters)
 {
 	assert(parameters);
@@ -1197,119 +1108,219 @@ static int get_number_of_args(struct mcc_ast_arguments *arguments)
 	return num;
 }
 
-static struct mcc_ast_parameters *get_params_from_ast(struct mcc_ast_program *ast, const char *name)
-{
-	assert(ast);
-	assert(name);
-	struct mcc_ast_parameters *params = NULL;
-	do {
-		if (strcmp(ast->function->identifier->identifier_name, name) == 0) {
-			params = ast->function->parameters;
-		}
-		ast = ast->next_function;
-	} while (ast);
-
-	return params;
-}
-
-static void cb_function_arguments_expression_function_call(struct mcc_ast_expression *expression, void *userdata)
+static void check_function_call(struct mcc_ast_expression *expression, struct checks_userdata *data)
 {
 	assert(expression);
-	assert(userdata);
+	assert(data);
 
-	struct function_arguments_userdata *data = userdata;
-	struct mcc_ast_program *ast = data->program;
-	struct mcc_semantic_check *check = data->check;
+	struct mcc_semantic_check *check = &data->checks[CHECK_FUNCTION_ARGUMENTS];
+	char *name = expression->function_identifier->identifier_name;
 
 	// Get the used arguments from the AST:
 	struct mcc_ast_arguments *args = expression->arguments;
-	// Get the required parameters from the function declaration
-	struct mcc_ast_parameters *params = get_params_from_ast(ast, expression->function_identifier->identifier_name);
+	// Get the required parameters from the builtin registry or the function declaration
+	const struct mcc_symbol_table_builtin *builtin = mcc_symbol_table_get_builtin(name);
+	struct mcc_ast_function_definition *function = builtin ? NULL : mcc_hash_map_lookup(data->functions, name);
 	// No parameters found -> unkown function
-	if (!params) {
-		data->error = mcc_semantic_check_raise_error(1, check, expression->node, "Undefined reference to '%s'",
-		                                             false, expression->function_identifier->identifier_name);
+	if (!builtin && !function) {
+		data->error = mcc_semantic_check_raise_error(data->error, 1, check, expression->node,
+		                                             "Undefined reference to '%s'", false, name);
 		return;
 	}
+	struct mcc_ast_parameters *params = builtin ? NULL : function->parameters;
 
-	int num_params = get_number_of_params(params);
+	int num_params = builtin ? (builtin->parameter_name ? 1 : 0) : get_number_of_params(params);
 	int num_args = get_number_of_args(args);
 	if (num_params == 0 && num_args == 0) {
 		return;
 	} else if (num_args - num_params > 0) {
-		data->error =
-		    mcc_semantic_check_raise_error(1, check, expression->node, "Too many arguments to function '%s'",
-		                                   false, expression->function_identifier->identifier_name);
+		data->error = mcc_semantic_check_raise_error(data->error, 1, check, expression->node,
+		                                             "Too many arguments to function '%s'", false, name);
 		return;
 	} else if (num_args - num_params < 0) {
-		data->error =
-		    mcc_semantic_check_raise_error(1, check, expression->node, "Too few arguments to function '%s'",
-		                                   false, expression->function_identifier->identifier_name);
+		data->error = mcc_semantic_check_raise_error(data->error, 1, check, expression->node,
+		                                             "Too few arguments to function '%s'", false, name);
 		return;
 	}
 
-	struct mcc_semantic_check_data_type *type_expr = NULL, *type_decl = NULL;
+	struct mcc_semantic_check_data_type type_expr, type_decl;
 	do {
 		// Check for type error
-		type_expr = check_and_get_type(args->expression, check);
-		type_decl = check_and_get_type(params->declaration, check);
-		if (!type_expr || !type_decl) {
-			data->error = MCC_SEMANTIC_CHECK_ERROR_UNKNOWN;
-			free(type_decl);
-			free(type_expr);
-			return;
+		type_expr = check_and_get_type(args->expression, check, &data->error);
+		if (builtin) {
+			type_decl = new_data_type(row_to_semantic_check_type(builtin->parameter_type));
+		} else {
+			type_decl = check_and_get_type(params->declaration, check, &data->error);
 		}
-		if (!types_equal(type_expr, type_decl)) {
-			data->error = mcc_semantic_check_raise_error(2, check, expression->node,
+		if (!types_equal(&type_expr, &type_decl)) {
+			data->error = mcc_semantic_check_raise_error(data->error, 2, check, expression->node,
 			                                             "Expected '%s' but argument is of type '%s'", true,
-			                                             to_string(type_decl), to_string(type_expr));
-			free(type_expr);
-			free(type_decl);
+			                                             to_string(&type_decl), to_string(&type_expr));
 			return;
 		}
-		free(type_expr);
-		free(type_decl);
 
+		if (builtin)
+			return;
 		params = params->next_parameters;
 		args = args->next_arguments;
 	} while (params && args);
-	return;
 }
 
-// Setup an AST Visitor for checking if function calls are correct
-static struct mcc_ast_visitor function_arguments_visitor(struct function_arguments_userdata *data)
+// Check the function calls of an expression, calls in the arguments before the call itself
+static void check_calls(struct mcc_ast_expression *expression, struct checks_userdata *data)
+{
+	assert(expression);
+	assert(data);
+
+	switch (expression->type) {
+	case MCC_AST_EXPRESSION_TYPE_BINARY_OP:
+		check_calls(expression->lhs, data);
+		check_calls(expression->rhs, data);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_PARENTH:
+		check_calls(expression->expression, data);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_UNARY_OP:
+		check_calls(expression->child, data);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_ARRAY_ELEMENT:
+		check_calls(expression->index, data);
+		break;
+	case MCC_AST_EXPRESSION_TYPE_FUNCTION_CALL:
+		if (!expression->arguments->is_empty) {
+			struct mcc_ast_arguments *args = expression->arguments;
+			while (args) {
+				check_calls(args->expression, data);
+				args = args->next_arguments;
+			}
+		}
+		check_function_call(expression, data);
+		break;
+	default:
+		break;
+	}
+}
+
+enum mcc_semantic_check_error_code mcc_semantic_check_run_function_arguments(struct mcc_ast_program *ast,
+                                                                             struct mcc_symbol_table *symbol_table,
+                                                                             struct mcc_semantic_check *check)
+{
+	return run_single_check(CHECK_FUNCTION_ARGUMENTS, ast, symbol_table, check);
+}
+
+// ------------------------------------------------------------- Single pass over the AST
+
+// The statements that contain expressions, and the functions
+static struct mcc_ast_visitor checks_visitor(struct checks_userdata *data)
 {
 	return (struct mcc_ast_visitor){
-	    .order = MCC_AST_VISIT_POST_ORDER,
+	    .order = MCC_AST_VISIT_PRE_ORDER,
 
 	    .userdata = data,
 
-	    .expression_function_call = cb_function_arguments_expression_function_call,
+	    .statement_assignment = cb_type_conversion_assignment,
+	    .statement_if_stmt = cb_type_check_if_stmt,
+	    .statement_if_else_stmt = cb_type_check_if_else_stmt,
+	    .statement_while = cb_type_check_while_stmt,
+	    .statement_expression_stmt = cb_type_check_expression_stmt,
+	    .statement_return = cb_type_check_return_value,
+	    .function_definition = cb_function_definition,
 	};
 }
 
-enum mcc_semantic_check_error_code mcc_semantic_check_run_function_arguments(struct mcc_ast_program *ast,
-                                                                             struct mcc_symbol_table *symbol_table,
-                                                                             struct mcc_semantic_check *check)
+// The checks of a single function only read the AST outside of it, so functions are checked concurrently. Each
+// function has its own errors, which are merged in source order.
+struct function_checks {
+	struct mcc_ast_function_definition *function;
+	struct mcc_semantic_check checks[CHECK_COUNT];
+	struct checks_userdata data;
+};
+
+static void check_function(int index, void *userdata)
+{
+	struct function_checks *functions = userdata;
+	struct checks_userdata *data = &functions[index].data;
+
+	struct mcc_ast_visitor visitor = checks_visitor(data);
+	mcc_ast_visit(functions[index].function, &visitor);
+	if (visitor.has_failed)
+		data->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+	end_function(data);
+}
+
+static void check_functions(struct mcc_ast_program *ast, struct checks_userdata *data)
+{
+	int num_functions = 0;
+	for (struct mcc_ast_program *program = ast; program && program->function; program = program->next_function) {
+		num_functions++;
+	}
+	if (num_functions == 0)
+		return;
+
+	struct function_checks *functions = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*functions) * num_functions);
+	if (!functions) {
+		data->error = MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
+		return;
+	}
+	int i = 0;
+	for (struct mcc_ast_program *program = ast; program && program->function; program = program->next_function) {
+		struct function_checks *function = &functions[i++];
+		function->function = program->function;
+		for (int j = 0; j < CHECK_COUNT; j++) {
+			function->checks[j] = (struct mcc_semantic_check){MCC_SEMANTIC_CHECK_OK, NULL};
+		}
+		function->data = *data;
+		function->data.checks = function->checks;
+	}
+	mcc_thread_pool_for(num_functions, check_function, functions);
+
+	// The first error of each check is the one of the first function that has one
+	for (i = 0; i < num_functions; i++) {
+		if (data->error == MCC_SEMANTIC_CHECK_ERROR_OK)
+			data->error = functions[i].data.error;
+		for (int j = 0; j < CHECK_COUNT; j++) {
+			take_error(&data->checks[j], &functions[i].checks[j]);
+		}
+	}
+	mcc_free(MCC_ALLOC_OTHER, functions);
+}
+
+// Run all checks, checks has room for the result of each of them
+static enum mcc_semantic_check_error_code
+run_checks(struct mcc_ast_program *ast, struct mcc_symbol_table *symbol_table, struct mcc_semantic_check *checks)
 {
-	UNUSED(symbol_table);
 	assert(ast);
-	assert(check);
-	assert(!check->error_buffer);
-	assert(check->status == MCC_SEMANTIC_CHECK_OK);
+	assert(symbol_table);
+	assert(checks);
 
-	struct function_arguments_userdata *userdata = malloc(sizeof(*userdata));
-	if (!userdata)
+	for (int i = 0; i < CHECK_COUNT; i++) {
+		checks[i].status = MCC_SEMANTIC_CHECK_OK;
+		checks[i].error_buffer = NULL;
+	}
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_SEMANTIC_CHECKS);
+	struct checks_userdata data = {
+	    .checks = checks,
+	    .error = MCC_SEMANTIC_CHECK_ERROR_OK,
+	    .function = NULL,
+	    .return_check = {MCC_SEMANTIC_CHECK_OK, NULL},
+	    .statement_check = {MCC_SEMANTIC_CHECK_OK, NULL},
+	    .functions = mcc_hash_map_new(MCC_HASH_MAP_KEY_POINTER),
+	};
+	if (!data.functions) {
+		mcc_alloc_set_phase(phase);
 		return MCC_SEMANTIC_CHECK_ERROR_MALLOC_FAILED;
-	userdata->check = check;
-	userdata->program = ast;
-	userdata->error = MCC_SEMANTIC_CHECK_ERROR_OK;
-
-	struct mcc_ast_visitor visitor = function_arguments_visitor(userdata);
-	mcc_ast_visit(ast, &visitor);
-	enum mcc_semantic_check_error_code error = userdata->error;
-	free(userdata);
-	return error;
+	}
+
+	// Function calls may refer to functions defined later, so the function list is checked first
+	check_function_definitions(ast, &data);
+	if (data.error == MCC_SEMANTIC_CHECK_ERROR_OK)
+		check_functions(ast, &data);
+	if (data.error == MCC_SEMANTIC_CHECK_ERROR_OK)
+		check_multiple_variable_declarations(symbol_table, &data);
+
+	mcc_hash_map_delete(data.functions);
+	mcc_alloc_set_phase(phase);
+	return data.error;
 }
 
 // ------------------------------------------------------------- Functions: Cleanup
@@ -1318,7 +1329,6 @@ void mcc_semantic_check_delete_single_check(struct mcc_semantic_check *check)
 {
 	if (check == NULL)
 		return;
-	free(check->error_buffer);
-	free(check);
+	mcc_free(MCC_ALLOC_STRING, check->error_buffer);
+	mcc_free(MCC_ALLOC_OTHER, check);
 }
-
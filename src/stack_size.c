@@ -2,9 +2,13 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
+
+
 struct mcc_annotated_ir *mcc_get_function_label(struct mcc_annotated_ir *an_ir)
 {
 	assert(an_ir);
@@ -17,84 +21,126 @@ struct mcc_annotated_ir *mcc_get_function_label(struct mcc_annotated_ir *an_ir)
 struct mcc_annotated_ir *mcc_new_annotated_ir(struct mcc_ir_row *row, int stack_size)
 {
 	assert(row);
-	struct mcc_annotated_ir *ir = malloc(sizeof(*ir));
+	struct mcc_annotated_ir *ir = mcc_malloc(MCC_ALLOC_ANNOTATED_IR, sizeof(*ir));
 	if (!ir)
 		return NULL;
 	ir->stack_size = stack_size;
 	ir->stack_position = 0;
+	ir->layout = NULL;
 	ir->row = row;
 	ir->next = NULL;
 	ir->prev = NULL;
 	return ir;
 }
 
-void mcc_delete_annotated_ir(struct mcc_annotated_ir *head)
+static void delete_frame_layout(struct mcc_frame_layout *layout)
 {
-	if (!head)
+	if (!layout)
 		return;
+	mcc_free(MCC_ALLOC_ANNOTATED_IR, layout->variables);
+	mcc_free(MCC_ALLOC_ANNOTATED_IR, layout->arrays);
+	mcc_free(MCC_ALLOC_ANNOTATED_IR, layout);
+}
 
-	mcc_delete_annotated_ir(head->next);
-	free(head);
+void mcc_delete_annotated_ir(struct mcc_annotated_ir *head)
+{
+	while (head) {
+		struct mcc_annotated_ir *next = head->next;
+		delete_frame_layout(head->layout);
+		mcc_free(MCC_ALLOC_ANNOTATED_IR, head);
+		head = next;
+	}
 }
 
 // --------------------------------------------------------------------------------------- Forward declarations
 
-static struct mcc_ir_row *first_line_of_function(struct mcc_ir_row *ir);
 static int get_row_size(struct mcc_ir_row *ir);
 
-// --------------------------------------------------------------------------------------- Calc stack size and position
+// --------------------------------------------------------------------------------------- Frame layout
 
-static bool assignment_is_first_occurence(struct mcc_ir_row *first, struct mcc_ir_row *ir)
+static struct mcc_frame_layout *new_frame_layout(struct mcc_ir_row *func_label)
 {
-	assert(first);
-	assert(ir);
-	assert(ir->instr == MCC_IR_INSTR_ASSIGN);
+	assert(func_label->instr == MCC_IR_INSTR_FUNC_LABEL);
+
+	struct mcc_frame_layout *layout = mcc_malloc(MCC_ALLOC_ANNOTATED_IR, sizeof(*layout));
+	if (!layout)
+		return NULL;
+	// Allocate at least one entry, calloc may return NULL for zero
+	size_t size = func_label->arg1->num_symbols ? func_label->arg1->num_symbols : 1;
+	layout->num_symbols = func_label->arg1->num_symbols;
+	layout->variables = mcc_calloc(MCC_ALLOC_ANNOTATED_IR, size, sizeof(*layout->variables));
+	layout->arrays = mcc_calloc(MCC_ALLOC_ANNOTATED_IR, size, sizeof(*layout->arrays));
+	if (!layout->variables || !layout->arrays) {
+		delete_frame_layout(layout);
+		return NULL;
+	}
+	return layout;
+}
+
+// Register the slot owner of the given line in the layout of its function
+static void add_to_frame_layout(struct mcc_frame_layout *layout, struct mcc_annotated_ir *an_ir)
+{
+	assert(layout);
+	assert(an_ir);
 
+	struct mcc_ir_row *row = an_ir->row;
+	if (row->instr == MCC_IR_INSTR_ARRAY) {
+		assert(row->arg1->symbol < layout->num_symbols);
+		layout->arrays[row->arg1->symbol] = an_ir;
+		return;
+	}
 	// Arrays are allocated when they're declared
-	if (ir->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
-		return false;
+	if (row->instr != MCC_IR_INSTR_ASSIGN || row->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
+		return;
 	}
+	assert(row->arg1->symbol < layout->num_symbols);
+	if (!layout->variables[row->arg1->symbol])
+		layout->variables[row->arg1->symbol] = an_ir;
+}
 
-	char *id_name = ir->arg1->ident;
-	struct mcc_ir_row *head = first;
-	while (head != ir) {
-		if (head->instr != MCC_IR_INSTR_ASSIGN) {
-			head = head->next_row;
-			continue;
-		}
-		if (strcmp(head->arg1->ident, id_name) == 0) {
-			return false;
-		}
-		head = head->next_row;
+static bool assignment_is_first_occurence(struct mcc_frame_layout *layout, struct mcc_annotated_ir *an_ir)
+{
+	assert(layout);
+	assert(an_ir);
+	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
+
+	if (an_ir->row->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
+		return false;
 	}
-	return true;
+	return layout->variables[an_ir->row->arg1->symbol] == an_ir;
 }
 
-static int get_var_size(struct mcc_ir_row *ir)
+struct mcc_annotated_ir *mcc_get_variable_declaration(struct mcc_annotated_ir *an_ir, unsigned symbol)
 {
-	assert(ir);
-	assert(ir->instr == MCC_IR_INSTR_ASSIGN);
+	assert(an_ir);
 
-	struct mcc_ir_row *first = first_line_of_function(ir);
+	an_ir = mcc_get_function_label(an_ir);
+	if (!an_ir || !an_ir->layout || symbol >= an_ir->layout->num_symbols)
+		return NULL;
+	return an_ir->layout->variables[symbol];
+}
 
-	if (!assignment_is_first_occurence(first, ir)) {
-		return 0;
-	}
-	if (ir->type->type != MCC_IR_ROW_TYPELESS)
-		return DWORD_SIZE;
-	return 0;
+struct mcc_annotated_ir *mcc_get_array_declaration(struct mcc_annotated_ir *an_ir, unsigned symbol)
+{
+	assert(an_ir);
+
+	an_ir = mcc_get_function_label(an_ir);
+	if (!an_ir || !an_ir->layout || symbol >= an_ir->layout->num_symbols)
+		return NULL;
+	return an_ir->layout->arrays[symbol];
 }
 
-static struct mcc_ir_row *first_line_of_function(struct mcc_ir_row *ir)
+// --------------------------------------------------------------------------------------- Calc stack size and position
+
+static int get_var_size(struct mcc_frame_layout *layout, struct mcc_annotated_ir *an_ir)
 {
-	assert(ir);
-	do {
-		if (ir->instr == MCC_IR_INSTR_FUNC_LABEL)
-			return ir;
-		ir = ir->prev_row;
+	assert(an_ir);
+	assert(an_ir->row->instr == MCC_IR_INSTR_ASSIGN);
 
-	} while (ir);
-	return NULL;
+	if (!assignment_is_first_occurence(layout, an_ir)) {
+		return 0;
+	}
+	return get_row_size(an_ir->row);
 }
 
 static int get_row_size(struct mcc_ir_row *ir)
@@ -106,14 +152,15 @@ static int get_row_size(struct mcc_ir_row *ir)
 	return 0;
 }
 
-static int get_stack_frame_size(struct mcc_ir_row *ir)
+static int get_stack_frame_size(struct mcc_frame_layout *layout, struct mcc_annotated_ir *an_ir)
 {
-	assert(ir);
+	assert(an_ir);
 
+	struct mcc_ir_row *ir = an_ir->row;
 	switch (ir->instr) {
 	// Assignment of variables to immediate value or temporary:
 	case MCC_IR_INSTR_ASSIGN:
-		return get_var_size(ir);
+		return get_var_size(layout, an_ir);
 
 	// Assignment of temporary: Int or Float
 	case MCC_IR_INSTR_PLUS:
@@ -157,64 +204,68 @@ static int get_stack_frame_size(struct mcc_ir_row *ir)
 	}
 }
 
+// Wrap all IR lines, build the frame layout of each function and compute stack sizes in a single pass
 static struct mcc_annotated_ir *add_stack_sizes(struct mcc_ir_row *ir)
 {
 	assert(ir);
 	assert(ir->instr == MCC_IR_INSTR_FUNC_LABEL);
 
-	struct mcc_annotated_ir *head = mcc_new_annotated_ir(ir, 0);
-	struct mcc_annotated_ir *first = head;
+	struct mcc_annotated_ir *first = NULL;
+	struct mcc_annotated_ir *head = NULL;
+	struct mcc_annotated_ir *func = NULL;
 	struct mcc_annotated_ir *new;
-	ir = ir->next_row;
 
 	while (ir) {
-		int size = get_stack_frame_size(ir);
-		new = mcc_new_annotated_ir(ir, size);
+		new = mcc_new_annotated_ir(ir, 0);
 		if (!new) {
 			mcc_delete_annotated_ir(first);
 			return NULL;
 		}
-		// If size == 0, we basically copy the previous line's stack_position to correctly reference later
-		// variables
-		new->prev = head;
-		head->next = new;
+		if (!first) {
+			first = new;
+		} else {
+			new->prev = head;
+			head->next = new;
+		}
 		head = new;
 
+		if (ir->instr == MCC_IR_INSTR_FUNC_LABEL) {
+			func = new;
+			func->layout = new_frame_layout(ir);
+			if (!func->layout) {
+				mcc_delete_annotated_ir(first);
+				return NULL;
+			}
+		} else {
+			add_to_frame_layout(func->layout, new);
+			// If size == 0, we basically copy the previous line's stack_position to correctly reference
+			// later variables
+			new->stack_size = get_stack_frame_size(func->layout, new);
+			func->stack_size += new->stack_size;
+		}
+
 		ir = ir->next_row;
 	}
 	return first;
 }
 
-static int get_frame_size_of_function(struct mcc_annotated_ir *head)
-{
-	assert(head);
-	assert(head->row->instr == MCC_IR_INSTR_FUNC_LABEL);
-
-	int frame_size = 0;
-	head = head->next;
-	while (head && head->row->instr != MCC_IR_INSTR_FUNC_LABEL) {
-		frame_size = frame_size + head->stack_size;
-		head = head->next;
-	}
-	return frame_size;
-}
-
 int mcc_get_array_base_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_base)
 {
 	assert(array_base);
 	assert(an_ir);
 	assert(an_ir->row->arg1 == array_base || an_ir->row->arg2 == array_base);
 
-	an_ir = mcc_get_function_label(an_ir);
-	while (an_ir) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, array_base->arr_ident) == 0) {
-				return an_ir->stack_position;
-			}
-		}
-		an_ir = an_ir->next;
-	}
-	return 0;
+	struct mcc_annotated_ir *decl = mcc_get_array_declaration(an_ir, array_base->symbol);
+	if (!decl)
+		return 0;
+	return decl->stack_position;
+}
+
+static int get_array_element_position(struct mcc_annotated_ir *decl, struct mcc_ir_arg *array_element)
+{
+	if (!decl)
+		return 0;
+	return decl->stack_position + (array_element->index->lit_int) * get_row_size(decl->row);
 }
 
 int mcc_get_array_element_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_ir_arg *array_element)
@@ -228,41 +279,7 @@ int mcc_get_array_element_stack_loc(struct mcc_annotated_ir *an_ir, struct mcc_i
 		return 0;
 	}
 
-	an_ir = mcc_get_function_label(an_ir);
-	while (an_ir) {
-		if (an_ir->row->instr == MCC_IR_INSTR_ARRAY) {
-			if (strcmp(an_ir->row->arg1->ident, array_element->arr_ident) == 0) {
-				int array_pos = an_ir->stack_position;
-				int element_pos =
-				    array_pos + (array_element->index->lit_int) * get_row_size(an_ir->row);
-				return element_pos;
-			}
-		}
-		an_ir = an_ir->next;
-	}
-	return 0;
-}
-
-int lookup_var_loc(struct mcc_annotated_ir *an_ir, struct mcc_annotated_ir *var)
-{
-	assert(an_ir);
-	assert(var);
-	assert(var->row->instr == MCC_IR_INSTR_ASSIGN);
-
-	an_ir = mcc_get_function_label(an_ir);
-	an_ir = an_ir->next;
-
-	while (an_ir && (an_ir->row->instr != MCC_IR_INSTR_FUNC_LABEL)) {
-		if (an_ir->row->instr != MCC_IR_INSTR_ASSIGN) {
-			an_ir = an_ir->next;
-			continue;
-		}
-		if (strcmp(an_ir->row->arg1->ident, var->row->arg1->ident) == 0) {
-			return an_ir->stack_position;
-		}
-		an_ir = an_ir->next;
-	}
-	return 0;
+	return get_array_element_position(mcc_get_array_declaration(an_ir, array_element->symbol), array_element);
 }
 
 static void add_stack_positions(struct mcc_annotated_ir *head)
@@ -270,8 +287,7 @@ static void add_stack_positions(struct mcc_annotated_ir *head)
 	assert(head);
 	assert(head->row->instr == MCC_IR_INSTR_FUNC_LABEL);
 
-	struct mcc_annotated_ir *func = head;
-	head->stack_size = get_frame_size_of_function(head);
+	struct mcc_frame_layout *layout = head->layout;
 	head = head->next;
 	int current_position = 0;
 	int pop_counter = DWORD_SIZE;
@@ -279,20 +295,25 @@ static void add_stack_positions(struct mcc_annotated_ir *head)
 	while (head) {
 		// Function label
 		if (head->row->instr == MCC_IR_INSTR_FUNC_LABEL) {
-			head->stack_size = get_frame_size_of_function(head);
 			current_position = 0;
 			pop_counter = DWORD_SIZE;
-			func = head;
+			layout = head->layout;
 			head = head->next;
 			continue;
 		}
 
 		// Variables
 		if (head->row->instr == MCC_IR_INSTR_ASSIGN) {
-			if (head->row->arg1->type == MCC_IR_TYPE_ARR_ELEM) {
-				head->stack_position = mcc_get_array_element_stack_loc(head, head->row->arg1);
-			} else if (!assignment_is_first_occurence(func->row, head->row)) {
-				head->stack_position = lookup_var_loc(func, head);
+			struct mcc_ir_arg *arg = head->row->arg1;
+			if (arg->type == MCC_IR_TYPE_ARR_ELEM) {
+				if (arg->index->type == MCC_IR_TYPE_LIT_INT) {
+					head->stack_position = get_array_element_position(layout->arrays[arg->symbol], arg);
+				} else {
+					head->stack_position = 0;
+				}
+			} else if (!assignment_is_first_occurence(layout, head)) {
+				struct mcc_annotated_ir *decl = layout->variables[arg->symbol];
+				head->stack_position = decl->stack_position;
 			} else {
 				current_position = current_position - head->stack_size;
 				head->stack_position = current_position;
@@ -328,10 +349,10 @@ struct mcc_annotated_ir *mcc_annotate_ir(struct mcc_ir_row *ir)
 	assert(ir);
 	assert(ir->instr == MCC_IR_INSTR_FUNC_LABEL);
 
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_STACK_LAYOUT);
 	struct mcc_annotated_ir *an_head = add_stack_sizes(ir);
-	if (!an_head)
-		return NULL;
-	add_stack_positions(an_head);
+	if (an_head)
+		add_stack_positions(an_head);
+	mcc_alloc_set_phase(phase);
 	return an_head;
 }
-
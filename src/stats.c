@@ -0,0 +1,321 @@
+#include "mcc/stats.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mcc/alloc.h"
+#include "mcc/ast_visit.h"
+#include "mcc/cfg.h"
+#include "mcc/ir_packed.h"
+#include "mcc/stack_size.h"
+
+static const char *const instruction_names[MCC_STATS_NUM_INSTRUCTIONS] = {
+    [MCC_IR_INSTR_ASSIGN] = "assign",
+    [MCC_IR_INSTR_LABEL] = "label",
+    [MCC_IR_INSTR_FUNC_LABEL] = "func_label",
+    [MCC_IR_INSTR_JUMP] = "jump",
+    [MCC_IR_INSTR_CALL] = "call",
+    [MCC_IR_INSTR_JUMPFALSE] = "jumpfalse",
+    [MCC_IR_INSTR_PUSH] = "push",
+    [MCC_IR_INSTR_POP] = "pop",
+    [MCC_IR_INSTR_PLUS] = "plus",
+    [MCC_IR_INSTR_MINUS] = "minus",
+    [MCC_IR_INSTR_MULTIPLY] = "multiply",
+    [MCC_IR_INSTR_DIVIDE] = "divide",
+    [MCC_IR_INSTR_EQUALS] = "equals",
+    [MCC_IR_INSTR_NOTEQUALS] = "notequals",
+    [MCC_IR_INSTR_SMALLER] = "smaller",
+    [MCC_IR_INSTR_GREATER] = "greater",
+    [MCC_IR_INSTR_SMALLEREQ] = "smallereq",
+    [MCC_IR_INSTR_GREATEREQ] = "greatereq",
+    [MCC_IR_INSTR_AND] = "and",
+    [MCC_IR_INSTR_OR] = "or",
+    [MCC_IR_INSTR_RETURN] = "return",
+    [MCC_IR_INSTR_ARRAY] = "array",
+    [MCC_IR_INSTR_NEGATIV] = "negative",
+    [MCC_IR_INSTR_NOT] = "not",
+    [MCC_IR_INSTR_UNKNOWN] = "unknown",
+};
+
+static const char *const opcode_names[MCC_STATS_NUM_OPCODES] = {
+    [MCC_ASM_MOVL] = "movl",
+    [MCC_ASM_MOVZBL] = "movzbl",
+    [MCC_ASM_CMPL] = "cmpl",
+    [MCC_ASM_PUSHL] = "pushl",
+    [MCC_ASM_POPL] = "popl",
+    [MCC_ASM_LEAVE] = "leave",
+    [MCC_ASM_ADDL] = "addl",
+    [MCC_ASM_SUBL] = "subl",
+    [MCC_ASM_IMULL] = "imull",
+    [MCC_ASM_IDIVL] = "idivl",
+    [MCC_ASM_SETE] = "sete",
+    [MCC_ASM_SETNE] = "setne",
+    [MCC_ASM_SETL] = "setl",
+    [MCC_ASM_SETG] = "setg",
+    [MCC_ASM_SETLE] = "setle",
+    [MCC_ASM_SETGE] = "setge",
+    [MCC_ASM_SETA] = "seta",
+    [MCC_ASM_SETAE] = "setae",
+    [MCC_ASM_SETB] = "setb",
+    [MCC_ASM_SETBE] = "setbe",
+    [MCC_ASM_AND] = "and",
+    [MCC_ASM_OR] = "or",
+    [MCC_ASM_RETURN] = "ret",
+    [MCC_ASM_CALLL] = "calll",
+    [MCC_ASM_XORL] = "xorl",
+    [MCC_ASM_NEGL] = "negl",
+    [MCC_ASM_JE] = "je",
+    [MCC_ASM_JNE] = "jne",
+    [MCC_ASM_LABEL] = "label",
+    [MCC_ASM_LEAL] = "leal",
+    [MCC_ASM_FLDS] = "flds",
+    [MCC_ASM_FSTPS] = "fstps",
+    [MCC_ASM_FADDP] = "faddp",
+    [MCC_ASM_FSUBP] = "fsubp",
+    [MCC_ASM_FCOMIP] = "fcomip",
+    [MCC_ASM_FINIT] = "finit",
+    [MCC_ASM_FSTP] = "fstp",
+    [MCC_ASM_FMULP] = "fmulp",
+    [MCC_ASM_FDIVP] = "fdivp",
+    [MCC_ASM_FCHS] = "fchs",
+};
+
+const char *mcc_stats_instruction_name(enum mcc_ir_instruction instr)
+{
+	assert(instr < MCC_STATS_NUM_INSTRUCTIONS);
+	return instruction_names[instr];
+}
+
+const char *mcc_stats_opcode_name(enum mcc_asm_opcode opcode)
+{
+	assert(opcode < MCC_STATS_NUM_OPCODES);
+	return opcode_names[opcode];
+}
+
+//---------------------------------------------------------------------------------------- AST and IR
+
+// Every kind of node is counted by a callback of its own type
+#define COUNT_NODE(name, type) \
+	static void count_##name(type *node, void *userdata) \
+	{ \
+		(void)node; \
+		(*(unsigned *)userdata)++; \
+	}
+
+COUNT_NODE(expression, struct mcc_ast_expression)
+COUNT_NODE(literal, struct mcc_ast_literal)
+COUNT_NODE(statement, struct mcc_ast_statement)
+COUNT_NODE(compound_statement, struct mcc_ast_compound_statement)
+COUNT_NODE(function_definition, struct mcc_ast_function_definition)
+COUNT_NODE(parameters, struct mcc_ast_parameters)
+COUNT_NODE(arguments, struct mcc_ast_arguments)
+COUNT_NODE(assignment, struct mcc_ast_assignment)
+COUNT_NODE(declaration, struct mcc_ast_declaration)
+COUNT_NODE(type, struct mcc_ast_type)
+COUNT_NODE(identifier, struct mcc_ast_identifier)
+
+static unsigned count_ast_nodes(struct mcc_ast_function_definition *function, bool *has_failed)
+{
+	unsigned count = 0;
+	// Assignments and declarations only have callbacks for pre-order per variant
+	struct mcc_ast_visitor visitor = {
+	    .order = MCC_AST_VISIT_PRE_ORDER,
+	    .userdata = &count,
+	    .expression = count_expression,
+	    .literal = count_literal,
+	    .statement = count_statement,
+	    .compound_statement = count_compound_statement,
+	    .function_definition = count_function_definition,
+	    .parameters = count_parameters,
+	    .arguments = count_arguments,
+	    .variable_assignment = count_assignment,
+	    .array_assignment = count_assignment,
+	    .variable_declaration = count_declaration,
+	    .array_declaration = count_declaration,
+	    .type = count_type,
+	    .identifier = count_identifier,
+	};
+	mcc_ast_visit_function_definition(function, &visitor);
+	*has_failed |= visitor.has_failed;
+	return count;
+}
+
+// Functions are in the same order in the AST, the IR, the CFG, the annotated IR and the assembly
+static bool add_functions(struct mcc_stats *stats, struct mcc_ast_program *program, struct mcc_ir_packed *packed)
+{
+	stats->num_functions = packed->num_functions;
+	stats->functions = mcc_calloc(MCC_ALLOC_OTHER, stats->num_functions ? stats->num_functions : 1,
+	                              sizeof(*stats->functions));
+	if (!stats->functions)
+		return false;
+
+	bool has_failed = false;
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		struct mcc_ir_packed_function *packed_function = &packed->functions[i];
+		struct mcc_stats_function *function = &stats->functions[i];
+		// The IR of a program starts with a function label
+		assert(packed_function->name);
+		function->name = mcc_strdup(MCC_ALLOC_STRING, packed_function->name);
+		has_failed |= !function->name;
+		function->ast_nodes = count_ast_nodes(program->function, &has_failed);
+		program = program->next_function;
+
+		function->ir_rows = packed_function->num_rows;
+		for (uint32_t j = 0; j < packed_function->num_rows; j++) {
+			function->ir_rows_by_instruction[packed_function->rows[j].instr]++;
+		}
+	}
+	return !has_failed;
+}
+
+//---------------------------------------------------------------------------------------- Later stages
+
+static void add_basic_blocks(struct mcc_stats *stats, struct mcc_basic_block *cfg)
+{
+	struct mcc_stats_function *function = NULL;
+	for (struct mcc_basic_block *block = cfg; block; block = block->next) {
+		if (block->leader->instr == MCC_IR_INSTR_FUNC_LABEL)
+			function = function ? function + 1 : stats->functions;
+		assert(function);
+		function->basic_blocks++;
+	}
+}
+
+static void add_frame_sizes(struct mcc_stats *stats, struct mcc_annotated_ir *an_ir)
+{
+	struct mcc_stats_function *function = stats->functions;
+	for (struct mcc_annotated_ir *line = an_ir; line; line = line->next) {
+		if (line->row->instr == MCC_IR_INSTR_FUNC_LABEL)
+			(function++)->frame_size = line->stack_size;
+	}
+}
+
+static void add_assembly(struct mcc_stats *stats, struct mcc_asm *assembly)
+{
+	struct mcc_stats_function *function = stats->functions;
+	for (struct mcc_asm_function *asm_function = assembly->text_section->function; asm_function;
+	     asm_function = asm_function->next) {
+		for (struct mcc_asm_line *line = asm_function->head; line; line = line->next) {
+			function->asm_lines++;
+			function->asm_lines_by_opcode[line->opcode]++;
+		}
+		function++;
+	}
+	for (struct mcc_asm_declaration *decl = assembly->data_section->head; decl; decl = decl->next) {
+		if (decl->type == MCC_ASM_DECLARATION_TYPE_STRING) {
+			stats->data_strings++;
+		} else {
+			stats->data_floats++;
+		}
+	}
+}
+
+// Stages the app did not run are run here on compatibility views of the packed IR. The CFG takes over the rows it is
+// built from, so it gets a view of its own.
+static bool add_later_stages(struct mcc_stats *stats,
+                             struct mcc_ir_packed *ir,
+                             struct mcc_basic_block *cfg,
+                             struct mcc_annotated_ir *an_ir,
+                             struct mcc_asm *assembly)
+{
+	if (cfg) {
+		add_basic_blocks(stats, cfg);
+	} else {
+		struct mcc_ir_row *rows = mcc_ir_packed_to_rows(ir);
+		struct mcc_basic_block *generated = rows ? mcc_cfg_generate(rows) : NULL;
+		if (!generated) {
+			mcc_ir_delete_ir(rows);
+			return false;
+		}
+		add_basic_blocks(stats, generated);
+		mcc_delete_cfg_and_ir(generated);
+	}
+
+	struct mcc_ir_row *rows = NULL;
+	struct mcc_annotated_ir *generated_an_ir = NULL;
+	struct mcc_asm *generated_assembly = NULL;
+	if (!an_ir) {
+		rows = mcc_ir_packed_to_rows(ir);
+		an_ir = generated_an_ir = rows ? mcc_annotate_ir(rows) : NULL;
+	}
+	if (an_ir && !assembly)
+		assembly = generated_assembly = mcc_asm_generate_annotated(an_ir);
+
+	bool has_failed = !an_ir || !assembly;
+	if (!has_failed) {
+		add_frame_sizes(stats, an_ir);
+		add_assembly(stats, assembly);
+	}
+	mcc_asm_delete_asm(generated_assembly);
+	mcc_delete_annotated_ir(generated_an_ir);
+	mcc_ir_delete_ir(rows);
+	return !has_failed;
+}
+
+struct mcc_stats *mcc_stats_collect(struct mcc_ast_program *program,
+                                    struct mcc_ir_packed *ir,
+                                    struct mcc_basic_block *cfg,
+                                    struct mcc_annotated_ir *an_ir,
+                                    struct mcc_asm *assembly)
+{
+	assert(program);
+	assert(ir);
+
+	struct mcc_stats *stats = mcc_calloc(MCC_ALLOC_OTHER, 1, sizeof(*stats));
+	if (!stats || !add_functions(stats, program, ir) || !add_later_stages(stats, ir, cfg, an_ir, assembly)) {
+		mcc_stats_delete(stats);
+		return NULL;
+	}
+	return stats;
+}
+
+//---------------------------------------------------------------------------------------- Output
+
+static void print_counts(FILE *out, const unsigned *counts, const char *const *names, int num_counts)
+{
+	fprintf(out, "{");
+	for (int i = 0; i < num_counts; i++) {
+		fprintf(out, "%s\"%s\": %u", i ? ", " : "", names[i], counts[i]);
+	}
+	fprintf(out, "}");
+}
+
+void mcc_stats_print_json(FILE *out, struct mcc_stats *stats)
+{
+	assert(out);
+	assert(stats);
+
+	// Function names are identifiers and need no escaping
+	fprintf(out, "{\"version\": %d,\n \"functions\": [", MCC_STATS_VERSION);
+	for (unsigned i = 0; i < stats->num_functions; i++) {
+		struct mcc_stats_function *function = &stats->functions[i];
+		fprintf(out, "%s\n  {\"name\": \"%s\", \"ast_nodes\": %u,\n", i ? "," : "", function->name,
+		        function->ast_nodes);
+		fprintf(out, "   \"ir_rows\": {\"total\": %u, \"by_instruction\": ", function->ir_rows);
+		print_counts(out, function->ir_rows_by_instruction, instruction_names, MCC_STATS_NUM_INSTRUCTIONS);
+		fprintf(out, "},\n   \"basic_blocks\": %u, \"frame_size\": %d,\n", function->basic_blocks,
+		        function->frame_size);
+		fprintf(out, "   \"asm_lines\": {\"total\": %u, \"by_opcode\": ", function->asm_lines);
+		print_counts(out, function->asm_lines_by_opcode, opcode_names, MCC_STATS_NUM_OPCODES);
+		fprintf(out, "}}");
+	}
+	fprintf(out, "],\n \"data_section\": {\"entries\": %u, \"strings\": %u, \"floats\": %u}}\n",
+	        stats->data_strings + stats->data_floats, stats->data_strings, stats->data_floats);
+}
+
+//---------------------------------------------------------------------------------------- Cleanup
+
+void mcc_stats_delete(struct mcc_stats *stats)
+{
+	if (!stats)
+		return;
+	if (stats->functions) {
+		for (unsigned i = 0; i < stats->num_functions; i++) {
+			mcc_free(MCC_ALLOC_STRING, stats->functions[i].name);
+		}
+	}
+	mcc_free(MCC_ALLOC_OTHER, stats->functions);
+	mcc_free(MCC_ALLOC_OTHER, stats);
+}
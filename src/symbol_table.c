@@ -4,12 +4,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
+#include "mcc/arena.h"
 #include "mcc/ast_visit.h"
+#include "mcc/intern.h"
+#include "utils/hash_map.h"
 
 // ------------------------------------------------------- Forward declaration
 
 static int create_rows_statement(struct mcc_ast_statement *statement, struct mcc_symbol_table_scope *scope);
 static int link_pointer_expression(struct mcc_ast_expression *expression, struct mcc_symbol_table_scope *scope);
+static struct mcc_symbol_table_row *find_last_declaration(struct mcc_symbol_table_scope *scope, const char *name);
 
 // ------------------------------------------------------- converting enum types
 
@@ -36,17 +41,18 @@ static enum mcc_symbol_table_row_type convert_enum(enum mcc_ast_types type)
 struct mcc_symbol_table_row *
 mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_arena_malloc(MCC_ALLOC_SYMBOL_TABLE, sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
+	row->arena = mcc_arena_get_current();
 
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_VARIABLE;
 	row->array_size = -1;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_arena_free(row->arena, MCC_ALLOC_SYMBOL_TABLE, row);
 		return NULL;
 	}
 	row->node = node;
@@ -54,6 +60,9 @@ mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type typ
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->last_child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
@@ -61,17 +70,18 @@ mcc_symbol_table_new_row_variable(char *name, enum mcc_symbol_table_row_type typ
 struct mcc_symbol_table_row *
 mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type type, struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_arena_malloc(MCC_ALLOC_SYMBOL_TABLE, sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
+	row->arena = mcc_arena_get_current();
 
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION;
 	row->array_size = -1;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_arena_free(row->arena, MCC_ALLOC_SYMBOL_TABLE, row);
 		return NULL;
 	}
 	row->node = node;
@@ -79,6 +89,9 @@ mcc_symbol_table_new_row_function(char *name, enum mcc_symbol_table_row_type typ
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->last_child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
@@ -88,17 +101,18 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
                                                             enum mcc_symbol_table_row_type type,
                                                             struct mcc_ast_node *node)
 {
-	struct mcc_symbol_table_row *row = malloc(sizeof(*row));
+	struct mcc_symbol_table_row *row = mcc_arena_malloc(MCC_ALLOC_SYMBOL_TABLE, sizeof(*row));
 	if (!row) {
 		return NULL;
 	}
+	row->arena = mcc_arena_get_current();
 
 	row->row_structure = MCC_SYMBOL_TABLE_ROW_STRUCTURE_ARRAY;
 	row->array_size = array_size;
 	row->row_type = type;
-	row->name = strdup(name);
+	row->name = mcc_intern(name);
 	if (!row->name) {
-		free(row);
+		mcc_arena_free(row->arena, MCC_ALLOC_SYMBOL_TABLE, row);
 		return NULL;
 	}
 	row->node = node;
@@ -106,48 +120,115 @@ struct mcc_symbol_table_row *mcc_symbol_table_new_row_array(char *name,
 	row->next_row = NULL;
 	row->scope = NULL;
 	row->child_scope = NULL;
+	row->last_child_scope = NULL;
+	row->position = 0;
+	row->prev_declaration = NULL;
 
 	return row;
 }
 
-void mcc_symbol_table_delete_row(struct mcc_symbol_table_row *row)
+// Remove row from the declarations of its name in scope, by pointing the index or the next declaration past it
+static void unlink_declaration(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
 {
-	assert(row);
+	struct mcc_symbol_table_row *last = find_last_declaration(scope, row->name);
+	if (last == row) {
+		if (scope->index) {
+			if (row->prev_declaration) {
+				// replacing an existing key cannot fail
+				mcc_hash_map_insert(scope->index, row->name, row->prev_declaration);
+			} else {
+				mcc_hash_map_remove(scope->index, row->name);
+			}
+		}
+		return;
+	}
+	while (last && last->prev_declaration != row) {
+		last = last->prev_declaration;
+	}
+	if (last) {
+		last->prev_declaration = row->prev_declaration;
+	}
+}
 
-	// if row has a child scope delete that scope
+// Free row and its child scopes without unlinking it, its name is owned by the interner
+static void free_row(struct mcc_symbol_table_row *row)
+{
 	if (row->child_scope) {
 		mcc_symbol_table_delete_all_scopes(row->child_scope);
 	}
+	mcc_arena_free(row->arena, MCC_ALLOC_SYMBOL_TABLE, row);
+}
 
-	// rearrange pointer structure
-	if (!row->prev_row && row->next_row) {
-		row->next_row->prev_row = NULL;
+void mcc_symbol_table_delete_row(struct mcc_symbol_table_row *row)
+{
+	assert(row);
+
+	struct mcc_symbol_table_scope *scope = row->scope;
+	if (scope) {
+		// later rows of the same name must not refer to it
+		unlink_declaration(scope, row);
+
+		if (scope->head == row) {
+			scope->head = row->next_row;
+		}
+		if (scope->tail == row) {
+			scope->tail = row->prev_row;
+		}
 	}
-	if (row->prev_row && !row->next_row) {
-		row->prev_row->next_row = NULL;
+
+	// rearrange pointer structure
+	if (row->prev_row) {
+		row->prev_row->next_row = row->next_row;
 	}
-	if (row->prev_row && row->next_row) {
+	if (row->next_row) {
 		row->next_row->prev_row = row->prev_row;
-		row->prev_row->next_row = row->next_row;
 	}
 
-	// free row
-	free(row->name);
-	free(row);
+	free_row(row);
 }
 
 void mcc_symbol_table_delete_all_rows(struct mcc_symbol_table_row *head)
 {
 	assert(head);
 
-	if (head) {
-		while (head->next_row) {
-			mcc_symbol_table_delete_row(head->next_row);
-		}
-		mcc_symbol_table_delete_row(head);
+	// the rows go away together, so none of them has to be unlinked
+	while (head) {
+		struct mcc_symbol_table_row *next = head->next_row;
+		free_row(head);
+		head = next;
 	}
+}
 
-	return;
+void mcc_symbol_table_rename_row(struct mcc_symbol_table_row *row, char *name)
+{
+	assert(row);
+	assert(name);
+
+	struct mcc_symbol_table_scope *scope = row->scope;
+	if (!scope) {
+		row->name = name;
+		return;
+	}
+
+	// unlink row from the declarations of its old name
+	unlink_declaration(scope, row);
+
+	// link row with the declarations of its new name
+	struct mcc_symbol_table_row *later = find_last_declaration(scope, name);
+	row->name = name;
+	if (!later || later->position < row->position) {
+		row->prev_declaration = later;
+		if (scope->index && mcc_hash_map_insert(scope->index, name, row) != 0) {
+			mcc_hash_map_delete(scope->index);
+			scope->index = NULL;
+		}
+		return;
+	}
+	while (later->prev_declaration && later->prev_declaration->position > row->position) {
+		later = later->prev_declaration;
+	}
+	row->prev_declaration = later->prev_declaration;
+	later->prev_declaration = row;
 }
 
 void mcc_symbol_table_row_append_child_scope(struct mcc_symbol_table_row *row, struct mcc_symbol_table_scope *child)
@@ -157,35 +238,30 @@ void mcc_symbol_table_row_append_child_scope(struct mcc_symbol_table_row *row, s
 
 	if (!row->child_scope) {
 		row->child_scope = child;
-		child->parent_row = row;
-
-		return;
 	} else {
-		struct mcc_symbol_table_scope *last_child = row->child_scope;
-
-		while (last_child->next_scope) {
-			last_child = last_child->next_scope;
-		}
-		last_child->next_scope = child;
-		child->parent_row = row;
+		row->last_child_scope->next_scope = child;
+		child->prev_scope = row->last_child_scope;
 	}
-
-	return;
+	row->last_child_scope = child;
+	child->parent_row = row;
 }
 
 // --------------------------------------------------------- Symbol Table scope
 
 struct mcc_symbol_table_scope *mcc_symbol_table_new_scope()
 {
-	struct mcc_symbol_table_scope *scope = malloc(sizeof(*scope));
+	struct mcc_symbol_table_scope *scope = mcc_arena_malloc(MCC_ALLOC_SYMBOL_TABLE, sizeof(*scope));
 	if (!scope) {
 		return NULL;
 	}
 
 	scope->head = NULL;
+	scope->tail = NULL;
+	scope->index = NULL;
 	scope->parent_row = NULL;
 	scope->next_scope = NULL;
 	scope->prev_scope = NULL;
+	scope->arena = mcc_arena_get_current();
 
 	return scope;
 }
@@ -194,35 +270,54 @@ struct mcc_symbol_table_row *mcc_symbol_table_scope_get_last_row(struct mcc_symb
 {
 	assert(scope);
 
-	if (!scope->head) {
-		return NULL;
-	}
+	return scope->tail;
+}
 
-	struct mcc_symbol_table_row *row = scope->head;
-	while (row->next_row) {
-		row = row->next_row;
+// Returns the last row of the scope with the given interned name, NULL if there is none
+static struct mcc_symbol_table_row *find_last_declaration(struct mcc_symbol_table_scope *scope, const char *name)
+{
+	if (scope->index) {
+		return mcc_hash_map_lookup(scope->index, name);
+	}
+	struct mcc_symbol_table_row *row = scope->tail;
+	while (row && row->name != name) {
+		row = row->prev_row;
 	}
 	return row;
 }
 
+// Add row to the index of the scope. The index is created along with the first row, if that fails or an insertion
+// fails the scope is searched linearly from then on.
+static void index_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
+{
+	if (!scope->head) {
+		scope->index = mcc_hash_map_new_in_arena(mcc_arena_get_current(), MCC_HASH_MAP_KEY_POINTER);
+	}
+	if (scope->index && mcc_hash_map_insert(scope->index, row->name, row) != 0) {
+		mcc_hash_map_delete(scope->index);
+		scope->index = NULL;
+	}
+}
+
 void mcc_symbol_table_scope_append_row(struct mcc_symbol_table_scope *scope, struct mcc_symbol_table_row *row)
 {
 	assert(scope);
 	assert(row);
 
-	struct mcc_symbol_table_row **head_ref = &scope->head;
-	struct mcc_symbol_table_row *last_row = *head_ref;
+	struct mcc_symbol_table_row *last_row = scope->tail;
 	row->scope = scope;
+	row->prev_declaration = find_last_declaration(scope, row->name);
+	index_row(scope, row);
+	scope->tail = row;
 
-	if (!*head_ref) {
-		*head_ref = row;
+	if (!scope->head) {
+		scope->head = row;
+		row->position = 0;
 		return;
 	}
-	while (last_row->next_row) {
-		last_row = last_row->next_row;
-	}
 	last_row->next_row = row;
 	row->prev_row = last_row;
+	row->position = last_row->position + 1;
 	return;
 }
 
@@ -234,8 +329,9 @@ void mcc_symbol_table_delete_scope(struct mcc_symbol_table_scope *scope)
 	if (scope->head) {
 		mcc_symbol_table_delete_all_rows(scope->head);
 	}
+	mcc_hash_map_delete(scope->index);
 
-	free(scope);
+	mcc_arena_free(scope->arena, MCC_ALLOC_SYMBOL_TABLE, scope);
 }
 
 void mcc_symbol_table_delete_all_scopes(struct mcc_symbol_table_scope *head)
@@ -259,12 +355,13 @@ void mcc_symbol_table_delete_all_scopes(struct mcc_symbol_table_scope *head)
 
 struct mcc_symbol_table *mcc_symbol_table_new_table()
 {
-	struct mcc_symbol_table *table = malloc(sizeof(*table));
+	struct mcc_symbol_table *table = mcc_arena_malloc(MCC_ALLOC_SYMBOL_TABLE, sizeof(*table));
 	if (!table) {
 		return NULL;
 	}
 
 	table->head = NULL;
+	table->arena = mcc_arena_get_current();
 
 	return table;
 }
@@ -306,11 +403,16 @@ void mcc_symbol_table_delete_table(struct mcc_symbol_table *table)
 {
 	assert(table);
 
+	// Rows and scopes are released together with the arena
+	if (table->arena) {
+		return;
+	}
+
 	if (table->head) {
 		mcc_symbol_table_delete_all_scopes(table->head);
 	}
 
-	free(table);
+	mcc_arena_free(table->arena, MCC_ALLOC_SYMBOL_TABLE, table);
 }
 
 // --------------------------------------------------------------- traversing AST and create symbol table
@@ -660,6 +762,16 @@ static int create_row_function_definition(struct mcc_ast_function_definition *fu
 	return 0;
 }
 
+// Returns the last row with the given interned name at or before the given row within its scope, NULL if there is none
+static struct mcc_symbol_table_row *find_declaration_up_to(struct mcc_symbol_table_row *row, const char *name)
+{
+	struct mcc_symbol_table_row *declaration = find_last_declaration(row->scope, name);
+	while (declaration && declaration->position > row->position) {
+		declaration = declaration->prev_declaration;
+	}
+	return declaration;
+}
+
 // Check if there is a declaration of the given name in the symbol table above (including) the given row and returns
 // the row, otherwise NULL. However, checks on function level are not done.
 struct mcc_symbol_table_row *mcc_symbol_table_check_upwards_for_declaration(const char *wanted_name,
@@ -668,24 +780,24 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_upwards_for_declaration(cons
 	assert(wanted_name);
 	assert(start_row);
 
+	// Row names are interned, a name that was never interned cannot be declared
+	const char *name = mcc_intern_find(wanted_name);
+	if (!name) {
+		return NULL;
+	}
+
 	struct mcc_symbol_table_row *row = start_row;
 	struct mcc_symbol_table_scope *scope = row->scope;
 
-	if (strcmp(wanted_name, row->name) == 0) {
+	if (name == row->name) {
 		return row;
 	}
 
+	// one lookup per enclosing scope
 	while (scope->parent_row) {
-		if (strcmp(wanted_name, row->name) == 0) {
-			return row;
-		}
-
-		while (row->prev_row) {
-			row = row->prev_row;
-
-			if (strcmp(wanted_name, row->name) == 0) {
-				return row;
-			}
+		struct mcc_symbol_table_row *declaration = find_declaration_up_to(row, name);
+		if (declaration) {
+			return declaration;
 		}
 		row = scope->parent_row;
 		scope = row->scope;
@@ -700,6 +812,11 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_for_function_declaration(con
 	assert(wanted_name);
 	assert(start_row);
 
+	const char *name = mcc_intern_find(wanted_name);
+	if (!name) {
+		return NULL;
+	}
+
 	struct mcc_symbol_table_row *row = start_row;
 	struct mcc_symbol_table_scope *scope = row->scope;
 
@@ -709,21 +826,82 @@ struct mcc_symbol_table_row *mcc_symbol_table_check_for_function_declaration(con
 		scope = row->scope;
 	}
 
-	// iterate through top level
-	row = scope->head;
-	if (!row) {
-		return NULL;
+	// first definition in case of redefinitions
+	row = find_last_declaration(scope, name);
+	while (row && row->prev_declaration) {
+		row = row->prev_declaration;
 	}
-	do {
-		if (strcmp(wanted_name, row->name) == 0) {
-			return row;
-		}
-		row = row->next_row;
-	} while (row);
+	return row;
+}
+
+// ------------------------------------------------------- Built-in functions
+
+static const struct mcc_symbol_table_builtin builtins[] = {
+    {"print", MCC_SYMBOL_TABLE_ROW_TYPE_VOID, "str", MCC_SYMBOL_TABLE_ROW_TYPE_STRING},
+    {"print_nl", MCC_SYMBOL_TABLE_ROW_TYPE_VOID, NULL, MCC_SYMBOL_TABLE_ROW_TYPE_VOID},
+    {"print_int", MCC_SYMBOL_TABLE_ROW_TYPE_VOID, "a", MCC_SYMBOL_TABLE_ROW_TYPE_INT},
+    {"print_float", MCC_SYMBOL_TABLE_ROW_TYPE_VOID, "b", MCC_SYMBOL_TABLE_ROW_TYPE_FLOAT},
+    {"read_int", MCC_SYMBOL_TABLE_ROW_TYPE_INT, NULL, MCC_SYMBOL_TABLE_ROW_TYPE_VOID},
+    {"read_float", MCC_SYMBOL_TABLE_ROW_TYPE_FLOAT, NULL, MCC_SYMBOL_TABLE_ROW_TYPE_VOID},
+};
 
+#define NUM_BUILTINS (sizeof(builtins) / sizeof(builtins[0]))
+
+const struct mcc_symbol_table_builtin *mcc_symbol_table_get_builtin(const char *name)
+{
+	assert(name);
+
+	for (size_t i = 0; i < NUM_BUILTINS; i++) {
+		if (strcmp(builtins[i].name, name) == 0) {
+			return &builtins[i];
+		}
+	}
 	return NULL;
 }
 
+bool mcc_symbol_table_row_is_builtin(const struct mcc_symbol_table_row *row)
+{
+	assert(row);
+
+	return row->row_structure == MCC_SYMBOL_TABLE_ROW_STRUCTURE_FUNCTION && !row->node;
+}
+
+// Creates the row of a builtin and its parameter scope, returns 0 on success.
+static int create_row_builtin(const struct mcc_symbol_table_builtin *builtin, struct mcc_symbol_table *table)
+{
+	assert(builtin);
+	assert(table);
+
+	if (!table->head) {
+		if (insert_new_scope(table)) {
+			return 1;
+		}
+	}
+
+	struct mcc_symbol_table_row *row =
+	    mcc_symbol_table_new_row_function((char *)builtin->name, builtin->return_type, NULL);
+	if (!row) {
+		return 1;
+	}
+	mcc_symbol_table_scope_append_row(table->head, row);
+
+	struct mcc_symbol_table_scope *child_scope = mcc_symbol_table_new_scope();
+	if (!child_scope) {
+		return 1;
+	}
+	mcc_symbol_table_row_append_child_scope(row, child_scope);
+
+	if (builtin->parameter_name) {
+		struct mcc_symbol_table_row *parameter =
+		    mcc_symbol_table_new_row_variable((char *)builtin->parameter_name, builtin->parameter_type, NULL);
+		if (!parameter) {
+			return 1;
+		}
+		mcc_symbol_table_scope_append_row(child_scope, parameter);
+	}
+	return 0;
+}
+
 // inserts the corresponding rows of a ast program into a given table
 static struct mcc_symbol_table *create_program(struct mcc_ast_program *program, struct mcc_symbol_table *table)
 {
@@ -748,6 +926,14 @@ static struct mcc_symbol_table *create_program(struct mcc_ast_program *program,
 		}
 	}
 
+	// builtins follow the user defined functions
+	for (size_t i = 0; i < NUM_BUILTINS; i++) {
+		if (create_row_builtin(&builtins[i], table)) {
+			mcc_symbol_table_delete_table(table);
+			return NULL;
+		}
+	}
+
 	return table;
 }
 
@@ -756,16 +942,11 @@ struct mcc_symbol_table *mcc_symbol_table_create(struct mcc_ast_program *program
 {
 	assert(program);
 
-	// Add builtin functions before creating symbol table
-	if (!mcc_ast_add_built_ins(program)) {
-		return NULL;
-	}
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_SYMBOL_TABLE);
 	struct mcc_symbol_table *table = mcc_symbol_table_new_table();
-	if (!table) {
-		return NULL;
-	}
-
-	table = create_program(program, table);
+	if (table)
+		table = create_program(program, table);
+	mcc_alloc_set_phase(phase);
 
 	return table;
 }
@@ -5,6 +5,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/alloc.h"
+
 // ------------------------------------------------------------- Forward declaration
 
 void mcc_symbol_table_print_symbol_table_scope(struct mcc_symbol_table_scope *scope,
@@ -88,14 +90,13 @@ void mcc_symbol_table_print_row(struct mcc_symbol_table_row *row, const char *le
 	print_row(row, leading_spaces, out);
 
 	// don't print scopes of built-ins
-	if ((strcmp(row->name, "print") == 0) || (strcmp(row->name, "print_int") == 0) ||
-	    (strcmp(row->name, "print_float") == 0)) {
+	if (mcc_symbol_table_row_is_builtin(row)) {
 		return;
 	}
 	struct mcc_symbol_table_scope *child_scope = row->child_scope;
 
 	int size = strlen(leading_spaces) + 8;
-	char *new_leading_spaces = (char *)malloc(sizeof(char) * size);
+	char *new_leading_spaces = (char *)mcc_malloc(MCC_ALLOC_STRING, sizeof(char) * size);
 	if (!new_leading_spaces)
 		return;
 	snprintf(new_leading_spaces, size, "    %s", leading_spaces);
@@ -105,7 +106,7 @@ void mcc_symbol_table_print_row(struct mcc_symbol_table_row *row, const char *le
 		child_scope = child_scope->next_scope;
 	}
 
-	free(new_leading_spaces);
+	mcc_free(MCC_ALLOC_STRING, new_leading_spaces);
 }
 
 void mcc_symbol_table_print_scope(struct mcc_symbol_table_scope *scope, const char *leading_spaces, FILE *out)
@@ -0,0 +1,388 @@
+#include "mcc/thread_pool.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "mcc/alloc.h"
+
+//---------------------------------------------------------------------------------------- Data structures
+
+struct task {
+	// Either function or body is set, body is called with index
+	mcc_thread_pool_task function;
+	void (*body)(int index, void *userdata);
+	int index;
+	void *userdata;
+	struct mcc_task_group *group;
+	// Allocations of the task are counted for the phase of the thread that submitted it
+	enum mcc_alloc_phase phase;
+	// Tasks of mcc_thread_pool_for share one allocation, which is released by the caller
+	bool is_from_heap;
+	struct task *older;
+	struct task *newer;
+};
+
+// Double ended queue, its owner takes the newest task and other threads the oldest one
+struct task_queue {
+	pthread_mutex_t lock;
+	struct task *oldest;
+	struct task *newest;
+};
+
+struct mcc_task_group {
+	pthread_mutex_t lock;
+	pthread_cond_t done;
+	// Submitted tasks that did not finish yet, only decremented while holding lock
+	atomic_int remaining;
+	// Tasks are run when they are submitted
+	bool run_inline;
+};
+
+// Queue 0 belongs to all threads outside of the pool, thread i of the pool owns queue i
+static struct {
+	// Number of threads set by mcc_thread_pool_set_threads, 0 for the default
+	int configured_threads;
+	bool is_running;
+	int num_threads;
+	struct task_queue *queues;
+	pthread_t *threads;
+	int num_started;
+	// Number of tasks in all queues. Threads without tasks sleep until it is positive.
+	atomic_int queued;
+	bool stop;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+// Serializes starting, stopping and configuring the pool
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Thread_local int thread_index = 0;
+
+//---------------------------------------------------------------------------------------- Queues
+
+static void push_task(struct task_queue *queue, struct task *task)
+{
+	pthread_mutex_lock(&queue->lock);
+	task->newer = NULL;
+	task->older = queue->newest;
+	if (queue->newest) {
+		queue->newest->newer = task;
+	} else {
+		queue->oldest = task;
+	}
+	queue->newest = task;
+	pthread_mutex_unlock(&queue->lock);
+}
+
+static struct task *pop_task(struct task_queue *queue, bool newest)
+{
+	pthread_mutex_lock(&queue->lock);
+	struct task *task = newest ? queue->newest : queue->oldest;
+	if (task) {
+		if (task->older) {
+			task->older->newer = task->newer;
+		} else {
+			queue->oldest = task->newer;
+		}
+		if (task->newer) {
+			task->newer->older = task->older;
+		} else {
+			queue->newest = task->older;
+		}
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return task;
+}
+
+// Take the newest task of the own queue, or else steal the oldest task of another one
+static struct task *take_task(void)
+{
+	int own = thread_index;
+	struct task *task = pop_task(&pool.queues[own], true);
+	for (int i = 1; !task && i < pool.num_threads; i++) {
+		task = pop_task(&pool.queues[(own + i) % pool.num_threads], false);
+	}
+	if (task)
+		atomic_fetch_sub(&pool.queued, 1);
+	return task;
+}
+
+static void queue_task(struct task *task)
+{
+	task->phase = mcc_alloc_get_phase();
+	atomic_fetch_add(&task->group->remaining, 1);
+	atomic_fetch_add(&pool.queued, 1);
+	push_task(&pool.queues[thread_index], task);
+
+	pthread_mutex_lock(&pool.lock);
+	pthread_cond_signal(&pool.wake);
+	pthread_mutex_unlock(&pool.lock);
+}
+
+static void finish_task(struct mcc_task_group *group)
+{
+	pthread_mutex_lock(&group->lock);
+	if (atomic_fetch_sub(&group->remaining, 1) == 1)
+		pthread_cond_broadcast(&group->done);
+	pthread_mutex_unlock(&group->lock);
+}
+
+static void run_task(struct task *task)
+{
+	struct mcc_task_group *group = task->group;
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(task->phase);
+	if (task->body) {
+		task->body(task->index, task->userdata);
+	} else {
+		task->function(task->userdata);
+	}
+	mcc_alloc_set_phase(phase);
+	if (task->is_from_heap)
+		mcc_free(MCC_ALLOC_OTHER, task);
+	finish_task(group);
+}
+
+//---------------------------------------------------------------------------------------- Threads
+
+static void *run_thread(void *arg)
+{
+	thread_index = (int)(intptr_t)arg;
+	while (true) {
+		struct task *task = take_task();
+		if (task) {
+			run_task(task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pool.lock);
+		while (atomic_load(&pool.queued) == 0 && !pool.stop) {
+			pthread_cond_wait(&pool.wake, &pool.lock);
+		}
+		bool stop = pool.stop;
+		pthread_mutex_unlock(&pool.lock);
+		if (stop)
+			return NULL;
+	}
+}
+
+static int cap_threads(long num_threads)
+{
+	if (num_threads < 1)
+		return 1;
+	return num_threads > MCC_THREAD_POOL_MAX_THREADS ? MCC_THREAD_POOL_MAX_THREADS : (int)num_threads;
+}
+
+static int resolve_threads(void)
+{
+	if (pool.configured_threads > 0)
+		return pool.configured_threads;
+
+	char *env = getenv(MCC_THREAD_POOL_ENV);
+	if (env) {
+		char *end;
+		long num_threads = strtol(env, &end, 10);
+		if (end != env && *end == '\0' && num_threads > 0)
+			return cap_threads(num_threads);
+	}
+	return cap_threads(sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+static bool start_threads(void)
+{
+	pool.queues = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*pool.queues) * pool.num_threads);
+	pool.threads = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*pool.threads) * (pool.num_threads - 1));
+	if (!pool.queues || !pool.threads) {
+		mcc_free(MCC_ALLOC_OTHER, pool.queues);
+		mcc_free(MCC_ALLOC_OTHER, pool.threads);
+		pool.queues = NULL;
+		pool.threads = NULL;
+		return false;
+	}
+	for (int i = 0; i < pool.num_threads; i++) {
+		pthread_mutex_init(&pool.queues[i].lock, NULL);
+		pool.queues[i].oldest = NULL;
+		pool.queues[i].newest = NULL;
+	}
+
+	// Threads that cannot be started leave their queue empty, the others take over their share
+	pool.stop = false;
+	pool.num_started = 0;
+	for (int i = 1; i < pool.num_threads; i++) {
+		if (pthread_create(&pool.threads[pool.num_started], NULL, run_thread, (void *)(intptr_t)i) == 0)
+			pool.num_started++;
+	}
+	return true;
+}
+
+static void stop_threads(void)
+{
+	if (!pool.queues)
+		return;
+	assert(atomic_load(&pool.queued) == 0);
+
+	pthread_mutex_lock(&pool.lock);
+	pool.stop = true;
+	pthread_cond_broadcast(&pool.wake);
+	pthread_mutex_unlock(&pool.lock);
+	for (int i = 0; i < pool.num_started; i++) {
+		pthread_join(pool.threads[i], NULL);
+	}
+
+	for (int i = 0; i < pool.num_threads; i++) {
+		pthread_mutex_destroy(&pool.queues[i].lock);
+	}
+	mcc_free(MCC_ALLOC_OTHER, pool.queues);
+	mcc_free(MCC_ALLOC_OTHER, pool.threads);
+	pool.queues = NULL;
+	pool.threads = NULL;
+	pool.num_started = 0;
+}
+
+// Start the pool if it is not running yet. Returns false if tasks have to run on the submitting thread.
+static bool start_pool(void)
+{
+	pthread_mutex_lock(&pool_lock);
+	if (!pool.is_running) {
+		pool.num_threads = resolve_threads();
+		if (pool.num_threads > 1 && !start_threads()) {
+			pthread_mutex_unlock(&pool_lock);
+			return false;
+		}
+		pool.is_running = true;
+	}
+	bool is_parallel = pool.num_threads > 1;
+	pthread_mutex_unlock(&pool_lock);
+	return is_parallel;
+}
+
+void mcc_thread_pool_set_threads(int num_threads)
+{
+	assert(num_threads >= 0);
+
+	pthread_mutex_lock(&pool_lock);
+	stop_threads();
+	pool.is_running = false;
+	pool.configured_threads = num_threads > 0 ? cap_threads(num_threads) : 0;
+	pthread_mutex_unlock(&pool_lock);
+}
+
+int mcc_thread_pool_threads(void)
+{
+	pthread_mutex_lock(&pool_lock);
+	int num_threads = pool.is_running ? pool.num_threads : resolve_threads();
+	pthread_mutex_unlock(&pool_lock);
+	return num_threads;
+}
+
+void mcc_thread_pool_shutdown(void)
+{
+	pthread_mutex_lock(&pool_lock);
+	stop_threads();
+	pool.is_running = false;
+	pthread_mutex_unlock(&pool_lock);
+}
+
+//---------------------------------------------------------------------------------------- Task groups
+
+static void init_group(struct mcc_task_group *group, bool run_inline)
+{
+	pthread_mutex_init(&group->lock, NULL);
+	pthread_cond_init(&group->done, NULL);
+	atomic_init(&group->remaining, 0);
+	group->run_inline = run_inline;
+}
+
+// Help with queued tasks, then sleep until the tasks of the group that other threads run are done
+static void wait_group(struct mcc_task_group *group)
+{
+	while (!group->run_inline && atomic_load(&group->remaining) > 0) {
+		struct task *task = take_task();
+		if (!task)
+			break;
+		run_task(task);
+	}
+
+	pthread_mutex_lock(&group->lock);
+	while (atomic_load(&group->remaining) > 0) {
+		pthread_cond_wait(&group->done, &group->lock);
+	}
+	pthread_mutex_unlock(&group->lock);
+
+	pthread_mutex_destroy(&group->lock);
+	pthread_cond_destroy(&group->done);
+}
+
+struct mcc_task_group *mcc_task_group_new(void)
+{
+	struct mcc_task_group *group = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*group));
+	if (!group)
+		return NULL;
+	init_group(group, !start_pool());
+	return group;
+}
+
+void mcc_task_group_submit(struct mcc_task_group *group, mcc_thread_pool_task task, void *userdata)
+{
+	assert(group);
+	assert(task);
+
+	struct task *queued = group->run_inline ? NULL : mcc_malloc(MCC_ALLOC_OTHER, sizeof(*queued));
+	if (!queued) {
+		task(userdata);
+		return;
+	}
+	*queued = (struct task){
+	    .function = task,
+	    .userdata = userdata,
+	    .group = group,
+	    .is_from_heap = true,
+	};
+	queue_task(queued);
+}
+
+void mcc_task_group_wait(struct mcc_task_group *group)
+{
+	assert(group);
+	wait_group(group);
+	mcc_free(MCC_ALLOC_OTHER, group);
+}
+
+void mcc_thread_pool_for(int count, void (*body)(int index, void *userdata), void *userdata)
+{
+	assert(body);
+
+	struct task *tasks = NULL;
+	if (count > 1 && start_pool())
+		tasks = mcc_malloc(MCC_ALLOC_OTHER, sizeof(*tasks) * count);
+	if (!tasks) {
+		for (int i = 0; i < count; i++) {
+			body(i, userdata);
+		}
+		return;
+	}
+
+	struct mcc_task_group group;
+	init_group(&group, false);
+
+	// Queued in reverse, so that the calling thread starts with the first index and others steal from the end
+	for (int i = count - 1; i >= 0; i--) {
+		tasks[i] = (struct task){
+		    .body = body,
+		    .index = i,
+		    .userdata = userdata,
+		    .group = &group,
+		};
+		queue_task(&tasks[i]);
+	}
+	wait_group(&group);
+	mcc_free(MCC_ALLOC_OTHER, tasks);
+}
@@ -0,0 +1,209 @@
+#include "utils/hash_map.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/alloc.h"
+#include "mcc/arena.h"
+
+#define INITIAL_CAPACITY 16
+
+// --------------------------------------------------------------------------------------- Hashing
+
+// FNV-1a
+size_t mcc_hash_string(const char *string)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	while (*string) {
+		hash ^= (unsigned char)*string;
+		hash *= 1099511628211ULL;
+		string++;
+	}
+	return (size_t)hash;
+}
+
+// Pointers are aligned, so the low bits carry no information. Mix them into the upper bits.
+static size_t hash_pointer(const void *pointer)
+{
+	uint64_t hash = (uint64_t)(uintptr_t)pointer;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return (size_t)hash;
+}
+
+static size_t hash_key(const struct mcc_hash_map *map, const void *key)
+{
+	if (map->key_type == MCC_HASH_MAP_KEY_STRING)
+		return mcc_hash_string(key);
+	return hash_pointer(key);
+}
+
+static bool keys_equal(const struct mcc_hash_map *map, const void *a, const void *b)
+{
+	if (map->key_type == MCC_HASH_MAP_KEY_STRING)
+		return strcmp(a, b) == 0;
+	return a == b;
+}
+
+// Returns the slot holding key, or the empty slot where it would be inserted
+static struct mcc_hash_map_entry *find_slot(const struct mcc_hash_map *map, const void *key)
+{
+	size_t mask = map->capacity - 1;
+	size_t index = hash_key(map, key) & mask;
+	while (map->entries[index].key && !keys_equal(map, map->entries[index].key, key)) {
+		index = (index + 1) & mask;
+	}
+	return &map->entries[index];
+}
+
+// --------------------------------------------------------------------------------------- Map
+
+// Allocate zeroed memory from the arena of the map or the heap
+static void *allocate_entries(struct mcc_arena *arena, size_t capacity)
+{
+	if (!arena)
+		return mcc_calloc(MCC_ALLOC_HASH_MAP, capacity, sizeof(struct mcc_hash_map_entry));
+	void *entries = mcc_arena_alloc(arena, capacity * sizeof(struct mcc_hash_map_entry));
+	if (entries)
+		memset(entries, 0, capacity * sizeof(struct mcc_hash_map_entry));
+	return entries;
+}
+
+struct mcc_hash_map *mcc_hash_map_new_in_arena(struct mcc_arena *arena, enum mcc_hash_map_key_type key_type)
+{
+	struct mcc_hash_map *map =
+	    arena ? mcc_arena_alloc(arena, sizeof(*map)) : mcc_malloc(MCC_ALLOC_HASH_MAP, sizeof(*map));
+	if (!map)
+		return NULL;
+	map->entries = allocate_entries(arena, INITIAL_CAPACITY);
+	if (!map->entries) {
+		if (!arena)
+			mcc_free(MCC_ALLOC_HASH_MAP, map);
+		return NULL;
+	}
+	map->key_type = key_type;
+	map->size = 0;
+	map->capacity = INITIAL_CAPACITY;
+	map->arena = arena;
+	return map;
+}
+
+struct mcc_hash_map *mcc_hash_map_new(enum mcc_hash_map_key_type key_type)
+{
+	return mcc_hash_map_new_in_arena(NULL, key_type);
+}
+
+void mcc_hash_map_delete(struct mcc_hash_map *map)
+{
+	if (!map || map->arena)
+		return;
+	if (map->key_type == MCC_HASH_MAP_KEY_STRING) {
+		for (size_t i = 0; i < map->capacity; i++) {
+			mcc_free(MCC_ALLOC_HASH_MAP, map->entries[i].key);
+		}
+	}
+	mcc_free(MCC_ALLOC_HASH_MAP, map->entries);
+	mcc_free(MCC_ALLOC_HASH_MAP, map);
+}
+
+static int grow(struct mcc_hash_map *map)
+{
+	struct mcc_hash_map_entry *old_entries = map->entries;
+	size_t old_capacity = map->capacity;
+
+	map->entries = allocate_entries(map->arena, old_capacity * 2);
+	if (!map->entries) {
+		map->entries = old_entries;
+		return 1;
+	}
+	map->capacity = old_capacity * 2;
+
+	for (size_t i = 0; i < old_capacity; i++) {
+		if (old_entries[i].key) {
+			*find_slot(map, old_entries[i].key) = old_entries[i];
+		}
+	}
+	if (!map->arena)
+		mcc_free(MCC_ALLOC_HASH_MAP, old_entries);
+	return 0;
+}
+
+int mcc_hash_map_insert(struct mcc_hash_map *map, const void *key, void *value)
+{
+	assert(map);
+	assert(key);
+	assert(value);
+
+	// Keep load factor below 3/4
+	if (4 * (map->size + 1) > 3 * map->capacity) {
+		if (grow(map) != 0)
+			return 1;
+	}
+
+	struct mcc_hash_map_entry *slot = find_slot(map, key);
+	if (slot->key) {
+		slot->value = value;
+		return 0;
+	}
+
+	if (map->key_type == MCC_HASH_MAP_KEY_STRING) {
+		slot->key = map->arena ? mcc_arena_alloc_string(map->arena, key) : mcc_strdup(MCC_ALLOC_HASH_MAP, key);
+		if (!slot->key)
+			return 1;
+	} else {
+		slot->key = (void *)key;
+	}
+	slot->value = value;
+	map->size++;
+	return 0;
+}
+
+void mcc_hash_map_remove(struct mcc_hash_map *map, const void *key)
+{
+	assert(map);
+	assert(key);
+
+	struct mcc_hash_map_entry *slot = find_slot(map, key);
+	if (!slot->key)
+		return;
+	if (map->key_type == MCC_HASH_MAP_KEY_STRING && !map->arena)
+		mcc_free(MCC_ALLOC_HASH_MAP, slot->key);
+	slot->key = NULL;
+	slot->value = NULL;
+	map->size--;
+
+	// Shift following entries of the probe sequence back into the gap
+	size_t mask = map->capacity - 1;
+	size_t gap = (size_t)(slot - map->entries);
+	size_t index = gap;
+	for (;;) {
+		index = (index + 1) & mask;
+		if (!map->entries[index].key)
+			return;
+		size_t home = hash_key(map, map->entries[index].key) & mask;
+		// Entry has to stay if its home lies cyclically within (gap, index]
+		bool stays = gap <= index ? (gap < home && home <= index) : (gap < home || home <= index);
+		if (!stays) {
+			map->entries[gap] = map->entries[index];
+			map->entries[index].key = NULL;
+			map->entries[index].value = NULL;
+			gap = index;
+		}
+	}
+}
+
+void *mcc_hash_map_lookup(const struct mcc_hash_map *map, const void *key)
+{
+	assert(map);
+	assert(key);
+
+	return find_slot(map, key)->value;
+}
+
+bool mcc_hash_map_contains(const struct mcc_hash_map *map, const void *key)
+{
+	return mcc_hash_map_lookup(map, key) != NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef MCC_UTILS_HASH_MAP_H
+#define MCC_UTILS_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Open addressing hash map with linear probing.
+// String keys are copied into the map and compared by content, pointer keys are compared by address.
+// NULL is not a valid value, since lookups return NULL for missing keys.
+// Maps created in an arena take all their memory from it, deleting them is a no-op.
+
+struct mcc_arena;
+
+enum mcc_hash_map_key_type {
+	MCC_HASH_MAP_KEY_STRING,
+	MCC_HASH_MAP_KEY_POINTER,
+};
+
+struct mcc_hash_map_entry {
+	void *key;
+	void *value;
+};
+
+struct mcc_hash_map {
+	enum mcc_hash_map_key_type key_type;
+	size_t size;
+	size_t capacity;
+	struct mcc_hash_map_entry *entries;
+	struct mcc_arena *arena;
+};
+
+struct mcc_hash_map *mcc_hash_map_new(enum mcc_hash_map_key_type key_type);
+
+struct mcc_hash_map *mcc_hash_map_new_in_arena(struct mcc_arena *arena, enum mcc_hash_map_key_type key_type);
+
+void mcc_hash_map_delete(struct mcc_hash_map *map);
+
+// Insert value under key, replacing an existing value. Returns 0 on success, 1 if an allocation failed
+int mcc_hash_map_insert(struct mcc_hash_map *map, const void *key, void *value);
+
+void mcc_hash_map_remove(struct mcc_hash_map *map, const void *key);
+
+// Returns value stored under key or NULL
+void *mcc_hash_map_lookup(const struct mcc_hash_map *map, const void *key);
+
+bool mcc_hash_map_contains(const struct mcc_hash_map *map, const void *key);
+
+// Hash function used for string keys
+size_t mcc_hash_string(const char *string);
+
+#endif // MCC_UTILS_HASH_MAP_H
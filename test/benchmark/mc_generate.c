@@ -0,0 +1,114 @@
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "generate.inc"
+
+static void print_usage(const char *prg)
+{
+	const struct mc_generate_options *defaults = &mc_generate_default_options;
+	printf("usage: %s [OPTIONS]\n\n", prg);
+	printf("Generate a synthetic mC program of the given size, e.g. for benchmarking the compiler.\n\n");
+	printf("OPTIONS:\n");
+	printf("  -h, --help                  display this help message\n");
+	printf("  -o, --output <file>         write the program to <file> instead of stdout\n");
+	printf("  -f, --functions <n>         number of functions besides main (default %d)\n", defaults->functions);
+	printf("  -s, --statements <n>        statements per function (default %d)\n", defaults->statements);
+	printf("  -n, --nesting-depth <n>     maximal depth of nested if and while statements (default %d)\n",
+	       defaults->nesting_depth);
+	printf("  -v, --variables <n>         variables declared in each scope (default %d)\n", defaults->variables);
+	printf("  -e, --expression-depth <n>  depth of each expression (default %d)\n", defaults->expression_depth);
+	printf("  -l, --literals <n>          distinct string and float literals per function (default %d)\n",
+	       defaults->literals);
+	printf("  -a, --arrays <n>            arrays per function (default %d)\n", defaults->arrays);
+}
+
+// Returns false if value is not a non-negative number
+static bool parse_count(const char *value, int *count)
+{
+	char *end;
+	long parsed = strtol(value, &end, 10);
+	if (end == value || *end != '\0' || parsed < 0 || parsed > 1000000)
+		return false;
+	*count = (int)parsed;
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	struct mc_generate_options options = mc_generate_default_options;
+	char *output_file = NULL;
+
+	static struct option long_options[] = {
+	    {"help", no_argument, NULL, 'h'},
+	    {"output", required_argument, NULL, 'o'},
+	    {"functions", required_argument, NULL, 'f'},
+	    {"statements", required_argument, NULL, 's'},
+	    {"nesting-depth", required_argument, NULL, 'n'},
+	    {"variables", required_argument, NULL, 'v'},
+	    {"expression-depth", required_argument, NULL, 'e'},
+	    {"literals", required_argument, NULL, 'l'},
+	    {"arrays", required_argument, NULL, 'a'},
+	    {NULL, 0, NULL, 0}};
+
+	int c;
+	bool is_valid = true;
+	bool print_help = false;
+	while (is_valid && (c = getopt_long(argc, argv, "ho:f:s:n:v:e:l:a:", long_options, NULL)) != -1) {
+		switch (c) {
+		case 'h':
+			print_help = true;
+			break;
+		case 'o':
+			output_file = optarg;
+			break;
+		case 'f':
+			is_valid = parse_count(optarg, &options.functions);
+			break;
+		case 's':
+			is_valid = parse_count(optarg, &options.statements);
+			break;
+		case 'n':
+			is_valid = parse_count(optarg, &options.nesting_depth);
+			break;
+		case 'v':
+			is_valid = parse_count(optarg, &options.variables) && options.variables > 0;
+			break;
+		case 'e':
+			is_valid = parse_count(optarg, &options.expression_depth);
+			break;
+		case 'l':
+			is_valid = parse_count(optarg, &options.literals);
+			break;
+		case 'a':
+			is_valid = parse_count(optarg, &options.arrays);
+			break;
+		default:
+			is_valid = false;
+			break;
+		}
+	}
+	if (print_help || !is_valid || optind != argc) {
+		print_usage(argv[0]);
+		return print_help && is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	FILE *out = stdout;
+	if (output_file) {
+		out = fopen(output_file, "w");
+		if (!out) {
+			perror("fopen");
+			return EXIT_FAILURE;
+		}
+	}
+
+	mc_generate_program(out, &options);
+
+	if (out != stdout && fclose(out) != 0) {
+		perror("fclose");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,428 @@
+#define _GNU_SOURCE
+
+#include <dirent.h>
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "mcc/arena.h"
+#include "mcc/asm.h"
+#include "mcc/asm_print.h"
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/intern.h"
+#include "mcc/input.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/parser.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/stack_size.h"
+#include "mcc/symbol_table.h"
+
+// Micro-benchmark of the stages of the compiler. Every stage is timed on its own, the stages it depends on run untimed
+// before it. After the warmup runs, each repetition compiles all inputs and sums up the time of a stage over them.
+// The minimum, median, percentiles and maximum of these sums are reported per stage.
+
+#define DEFAULT_REPETITIONS 20
+#define DEFAULT_WARMUP 3
+
+// ----------------------------------------------------------------------- Data structures
+
+// Ordered by dependency, except that the CFG takes ownership of the IR and is therefore generated last
+enum stage {
+	STAGE_PARSE,
+	STAGE_SYMBOL_TABLE,
+	STAGE_SEMANTIC_CHECKS,
+	STAGE_IR,
+	STAGE_IR_ROWS,
+	STAGE_CFG,
+	STAGE_ANNOTATE,
+	STAGE_ASM,
+	STAGE_ASM_PRINT,
+	NUM_STAGES,
+};
+
+static const char *const stage_names[NUM_STAGES] = {
+    "mcc_parse_string", "mcc_symbol_table_create", "mcc_semantic_check_run_all",
+    "mcc_ir_generate",  "mcc_ir_packed_to_rows",   "mcc_cfg_generate",
+    "mcc_annotate_ir",  "mcc_asm_generate",        "mcc_asm_print_asm",
+};
+
+static const enum stage execution_order[NUM_STAGES] = {
+    STAGE_PARSE, STAGE_SYMBOL_TABLE, STAGE_SEMANTIC_CHECKS, STAGE_IR,
+    STAGE_IR_ROWS, STAGE_ANNOTATE, STAGE_ASM, STAGE_ASM_PRINT, STAGE_CFG,
+};
+
+struct inputs {
+	int size;
+	char **names;
+	struct mcc_input **sources;
+};
+
+// Intermediate results of compiling one input
+struct compilation {
+	char *name;
+	const char *source;
+	// Printed assembly is discarded
+	FILE *sink;
+	struct mcc_arena *arena;
+	struct mcc_parser_result result;
+	struct mcc_symbol_table *table;
+	struct mcc_semantic_check *checks;
+	struct mcc_ir_packed *packed;
+	// Compatibility view of packed, which the later stages work on
+	struct mcc_ir_row *ir;
+	struct mcc_basic_block *cfg;
+	struct mcc_annotated_ir *an_ir;
+	struct mcc_asm *code;
+};
+
+// ----------------------------------------------------------------------- Inputs
+
+static bool add_input(struct inputs *inputs, const char *filename)
+{
+	struct mcc_input *source = mcc_input_from_file(filename);
+	if (!source) {
+		fprintf(stderr, "Cannot read %s\n", filename);
+		return false;
+	}
+
+	char **names = realloc(inputs->names, sizeof(*names) * (inputs->size + 1));
+	if (names)
+		inputs->names = names;
+	struct mcc_input **sources = realloc(inputs->sources, sizeof(*sources) * (inputs->size + 1));
+	if (sources)
+		inputs->sources = sources;
+	char *name = strdup(filename);
+	if (!names || !sources || !name) {
+		perror("add_input");
+		free(name);
+		mcc_input_delete(source);
+		return false;
+	}
+
+	inputs->names[inputs->size] = name;
+	inputs->sources[inputs->size] = source;
+	inputs->size++;
+	return true;
+}
+
+// Add the program of each test in directory, which is laid out like test/integration
+static bool add_corpus(struct inputs *inputs, const char *directory)
+{
+	struct dirent **entries;
+	int num_entries = scandir(directory, &entries, NULL, alphasort);
+	if (num_entries < 0) {
+		perror(directory);
+		return false;
+	}
+
+	bool has_failed = false;
+	for (int i = 0; i < num_entries; i++) {
+		char *test = entries[i]->d_name;
+		char *filename = NULL;
+		if (!has_failed && test[0] != '.' && asprintf(&filename, "%s/%s/%s.mc", directory, test, test) != -1) {
+			if (access(filename, R_OK) == 0)
+				has_failed = !add_input(inputs, filename);
+		}
+		free(filename);
+		free(entries[i]);
+	}
+	free(entries);
+	return !has_failed;
+}
+
+static void delete_inputs(struct inputs *inputs)
+{
+	for (int i = 0; i < inputs->size; i++) {
+		free(inputs->names[i]);
+		mcc_input_delete(inputs->sources[i]);
+	}
+	free(inputs->names);
+	free(inputs->sources);
+}
+
+// ----------------------------------------------------------------------- Stages
+
+static bool run_stage(enum stage stage, struct compilation *compilation)
+{
+	switch (stage) {
+	case STAGE_PARSE:
+		compilation->result =
+		    mcc_parse_string(compilation->source, MCC_PARSER_ENTRY_POINT_PROGRAM, compilation->name);
+		if (compilation->result.status != MCC_PARSER_STATUS_OK && compilation->result.error_buffer)
+			fprintf(stderr, "%s", compilation->result.error_buffer);
+		return compilation->result.status == MCC_PARSER_STATUS_OK;
+	case STAGE_SYMBOL_TABLE:
+		compilation->table = mcc_symbol_table_create(compilation->result.program);
+		return compilation->table;
+	case STAGE_SEMANTIC_CHECKS:
+		compilation->checks = mcc_semantic_check_run_all(compilation->result.program, compilation->table);
+		if (compilation->checks && compilation->checks->error_buffer)
+			fprintf(stderr, "%s\n", compilation->checks->error_buffer);
+		return compilation->checks && compilation->checks->status == MCC_SEMANTIC_CHECK_OK;
+	case STAGE_IR:
+		compilation->packed = mcc_ir_generate(compilation->result.program);
+		return compilation->packed;
+	case STAGE_IR_ROWS:
+		compilation->ir = mcc_ir_packed_to_rows(compilation->packed);
+		return compilation->ir;
+	case STAGE_CFG:
+		compilation->cfg = mcc_cfg_generate(compilation->ir);
+		if (compilation->cfg)
+			compilation->ir = NULL;
+		return compilation->cfg;
+	case STAGE_ANNOTATE:
+		compilation->an_ir = mcc_annotate_ir(compilation->ir);
+		return compilation->an_ir;
+	case STAGE_ASM:
+		compilation->code = mcc_asm_generate(compilation->ir);
+		return compilation->code;
+	case STAGE_ASM_PRINT:
+		mcc_asm_print_asm(compilation->sink, compilation->code);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void delete_compilation(struct compilation *compilation)
+{
+	mcc_asm_delete_asm(compilation->code);
+	mcc_delete_annotated_ir(compilation->an_ir);
+	if (compilation->cfg)
+		mcc_delete_cfg_and_ir(compilation->cfg);
+	mcc_ir_delete_ir(compilation->ir);
+	mcc_ir_packed_delete(compilation->packed);
+	mcc_semantic_check_delete_single_check(compilation->checks);
+	if (compilation->table)
+		mcc_symbol_table_delete_table(compilation->table);
+	mcc_ast_delete(compilation->result.program);
+	mcc_free(MCC_ALLOC_STRING, compilation->result.error_buffer);
+	mcc_arena_set_current(NULL);
+	mcc_arena_delete(compilation->arena);
+}
+
+static double now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+// Run the needed stages on source like mc_asm does, and add the time of each one to seconds. Returns false if the input
+// does not compile.
+static bool compile(char *name, const char *source, const bool needed[NUM_STAGES], FILE *sink,
+                    double seconds[NUM_STAGES])
+{
+	// The AST and the symbol table are allocated in an arena, as in the apps
+	struct compilation compilation = {.name = name, .source = source, .sink = sink};
+	compilation.arena = mcc_arena_new();
+	if (!compilation.arena)
+		return false;
+	mcc_arena_set_current(compilation.arena);
+
+	bool has_failed = false;
+	for (int i = 0; i < NUM_STAGES && !has_failed; i++) {
+		enum stage stage = execution_order[i];
+		if (!needed[stage])
+			continue;
+		double start = now();
+		has_failed = !run_stage(stage, &compilation);
+		seconds[stage] += now() - start;
+	}
+
+	delete_compilation(&compilation);
+	return !has_failed;
+}
+
+// ----------------------------------------------------------------------- Statistics
+
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+// Nearest rank of the sorted samples
+static double percentile(const double *sorted, int size, int percent)
+{
+	int rank = (percent * size + 99) / 100;
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void print_report(const struct inputs *inputs, const bool selected[NUM_STAGES], double *samples[NUM_STAGES],
+                         int repetitions)
+{
+	printf("%-28s %6s %6s %10s %10s %10s %10s %10s\n", "stage", "inputs", "runs", "min ms", "p10 ms", "median ms",
+	       "p90 ms", "max ms");
+	for (int stage = 0; stage < NUM_STAGES; stage++) {
+		if (!selected[stage])
+			continue;
+		double *sorted = samples[stage];
+		qsort(sorted, repetitions, sizeof(*sorted), compare_doubles);
+		printf("%-28s %6d %6d %10.3f %10.3f %10.3f %10.3f %10.3f\n", stage_names[stage], inputs->size,
+		       repetitions, sorted[0] * 1e3, percentile(sorted, repetitions, 10) * 1e3,
+		       percentile(sorted, repetitions, 50) * 1e3, percentile(sorted, repetitions, 90) * 1e3,
+		       sorted[repetitions - 1] * 1e3);
+	}
+}
+
+// ----------------------------------------------------------------------- Main
+
+static void print_usage(const char *prg)
+{
+	printf("usage: %s [OPTIONS] [FILE...]\n\n", prg);
+	printf("Time stages of the compiler on the given mC programs.\n\n");
+	printf("OPTIONS:\n");
+	printf("  -h, --help              display this help message\n");
+	printf("  -s, --stage <name>      only time the stage named like its library function, may be repeated\n");
+	printf("  -c, --corpus <dir>      add the program of each test in <dir>, laid out like test/integration\n");
+	printf("  -r, --repetitions <n>   timed runs (default %d)\n", DEFAULT_REPETITIONS);
+	printf("  -w, --warmup <n>        untimed runs before the timed ones (default %d)\n", DEFAULT_WARMUP);
+	printf("\nStages:\n");
+	for (int stage = 0; stage < NUM_STAGES; stage++) {
+		printf("  %s\n", stage_names[stage]);
+	}
+}
+
+// Returns false if value is not a number of at least minimum
+static bool parse_count(const char *value, int minimum, int *count)
+{
+	char *end;
+	long parsed = strtol(value, &end, 10);
+	if (end == value || *end != '\0' || parsed < minimum || parsed > 1000000)
+		return false;
+	*count = (int)parsed;
+	return true;
+}
+
+static bool select_stage(const char *name, bool selected[NUM_STAGES])
+{
+	for (int stage = 0; stage < NUM_STAGES; stage++) {
+		if (strcmp(name, stage_names[stage]) == 0) {
+			selected[stage] = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Stages that have to run for the selected ones
+static void find_needed(const bool selected[NUM_STAGES], bool needed[NUM_STAGES])
+{
+	bool is_later_selected = false;
+	for (int stage = NUM_STAGES - 1; stage >= 0; stage--) {
+		is_later_selected = is_later_selected || selected[stage];
+		needed[stage] = selected[stage] || (stage <= STAGE_IR_ROWS && is_later_selected);
+	}
+	if (selected[STAGE_ASM_PRINT])
+		needed[STAGE_ASM] = true;
+}
+
+static bool run_benchmark(const struct inputs *inputs, const bool selected[NUM_STAGES], int repetitions, int warmup)
+{
+	bool needed[NUM_STAGES];
+	find_needed(selected, needed);
+
+	FILE *sink = fopen("/dev/null", "w");
+	double *samples[NUM_STAGES] = {NULL};
+	bool has_failed = !sink;
+	for (int stage = 0; stage < NUM_STAGES && !has_failed; stage++) {
+		samples[stage] = calloc(repetitions, sizeof(*samples[stage]));
+		has_failed = !samples[stage];
+	}
+	if (has_failed)
+		perror("run_benchmark");
+
+	double seconds[NUM_STAGES];
+	for (int run = 0; run < warmup + repetitions && !has_failed; run++) {
+		memset(seconds, 0, sizeof(seconds));
+		for (int i = 0; i < inputs->size && !has_failed; i++) {
+			has_failed = !compile(inputs->names[i], inputs->sources[i]->buffer, needed, sink, seconds);
+			if (has_failed)
+				fprintf(stderr, "Compiling %s failed\n", inputs->names[i]);
+		}
+		for (int stage = 0; stage < NUM_STAGES && run >= warmup; stage++) {
+			samples[stage][run - warmup] = seconds[stage];
+		}
+	}
+
+	if (!has_failed)
+		print_report(inputs, selected, samples, repetitions);
+
+	for (int stage = 0; stage < NUM_STAGES; stage++) {
+		free(samples[stage]);
+	}
+	if (sink)
+		fclose(sink);
+	return !has_failed;
+}
+
+int main(int argc, char *argv[])
+{
+	bool selected[NUM_STAGES] = {false};
+	bool is_any_selected = false;
+	int repetitions = DEFAULT_REPETITIONS;
+	int warmup = DEFAULT_WARMUP;
+	struct inputs inputs = {0};
+
+	static struct option long_options[] = {
+	    {"help", no_argument, NULL, 'h'},
+	    {"stage", required_argument, NULL, 's'},
+	    {"corpus", required_argument, NULL, 'c'},
+	    {"repetitions", required_argument, NULL, 'r'},
+	    {"warmup", required_argument, NULL, 'w'},
+	    {NULL, 0, NULL, 0}};
+
+	int c;
+	bool is_valid = true;
+	bool print_help = false;
+	while (is_valid && (c = getopt_long(argc, argv, "hs:c:r:w:", long_options, NULL)) != -1) {
+		switch (c) {
+		case 'h':
+			print_help = true;
+			break;
+		case 's':
+			is_valid = select_stage(optarg, selected);
+			is_any_selected = true;
+			break;
+		case 'c':
+			is_valid = add_corpus(&inputs, optarg);
+			break;
+		case 'r':
+			is_valid = parse_count(optarg, 1, &repetitions);
+			break;
+		case 'w':
+			is_valid = parse_count(optarg, 0, &warmup);
+			break;
+		default:
+			is_valid = false;
+			break;
+		}
+	}
+	for (int i = optind; i < argc && is_valid; i++) {
+		is_valid = add_input(&inputs, argv[i]);
+	}
+	if (print_help || !is_valid || inputs.size == 0) {
+		print_usage(argv[0]);
+		delete_inputs(&inputs);
+		return print_help && is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (!is_any_selected) {
+		for (int stage = 0; stage < NUM_STAGES; stage++) {
+			selected[stage] = true;
+		}
+	}
+
+	bool is_successful = run_benchmark(&inputs, selected, repetitions, warmup);
+	delete_inputs(&inputs);
+	mcc_intern_release();
+	return is_successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+#include <CuTest.h>
+
+#include <stdlib.h>
+
+#include "mcc/alloc.h"
+#include "mcc/arena.h"
+#include "mcc/asm.h"
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/parser.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/symbol_table.h"
+#include "mcc/thread_pool.h"
+
+#define PROGRAM \
+	"int f(int n){int i; i = 0; while (i < n) {i = i + 1;} return i;}\n" \
+	"int g(int n){if (n < 2) return n; return g(n - 1) + g(n - 2);}\n" \
+	"int main(){return f(3) + g(4);}"
+
+// IR generation relies on the symbol table and the types that the semantic checks store in the AST
+static struct mcc_ir_packed *generate_ir(CuTest *tc, struct mcc_ast_program *program)
+{
+	struct mcc_symbol_table *table = mcc_symbol_table_create(program);
+	CuAssertPtrNotNull(tc, table);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all(program, table);
+	CuAssertPtrNotNull(tc, checks);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, checks->status);
+	struct mcc_ir_packed *ir = mcc_ir_generate(program);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_symbol_table_delete_table(table);
+	return ir;
+}
+
+void counted_per_kind(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	struct mcc_alloc_counters ast_before = mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE);
+	struct mcc_alloc_counters row_before = mcc_alloc_kind_counters(MCC_ALLOC_IR_ROW);
+	struct mcc_alloc_counters arg_before = mcc_alloc_kind_counters(MCC_ALLOC_IR_ARG);
+
+	struct mcc_parser_result parser_result = mcc_parse_string(PROGRAM, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_ir_packed *ir = generate_ir(tc, parser_result.program);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_alloc_counters ast = mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE);
+	struct mcc_alloc_counters row = mcc_alloc_kind_counters(MCC_ALLOC_IR_ROW);
+	struct mcc_alloc_counters arg = mcc_alloc_kind_counters(MCC_ALLOC_IR_ARG);
+	CuAssertTrue(tc, ast.calls > ast_before.calls);
+	CuAssertTrue(tc, ast.bytes > ast_before.bytes);
+	CuAssertTrue(tc, ast.live > ast_before.live);
+	CuAssertTrue(tc, ast.peak >= ast.live);
+	CuAssertTrue(tc, row.calls > row_before.calls);
+	CuAssertTrue(tc, arg.calls > arg_before.calls);
+
+	// Everything is freed with the kind it was allocated with
+	mcc_ir_packed_delete(ir);
+	mcc_ast_delete(parser_result.program);
+	CuAssertIntEquals(tc, ast_before.live, mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE).live);
+	CuAssertIntEquals(tc, row_before.live, mcc_alloc_kind_counters(MCC_ALLOC_IR_ROW).live);
+	CuAssertIntEquals(tc, arg_before.live, mcc_alloc_kind_counters(MCC_ALLOC_IR_ARG).live);
+}
+
+void counted_per_phase(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	mcc_thread_pool_set_threads(4);
+
+	struct mcc_parser_result parser_result = mcc_parse_string(PROGRAM, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_alloc_counters parser = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_PARSER);
+	struct mcc_alloc_counters ir_before = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_IR);
+	struct mcc_alloc_counters row_before = mcc_alloc_kind_counters(MCC_ALLOC_IR_ROW);
+	struct mcc_alloc_counters other_before = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_OTHER);
+
+	struct mcc_ir_packed *ir = generate_ir(tc, parser_result.program);
+	CuAssertPtrNotNull(tc, ir);
+	CuAssertIntEquals(tc, MCC_ALLOC_PHASE_OTHER, mcc_alloc_get_phase());
+	CuAssertIntEquals(tc, other_before.calls, mcc_alloc_phase_counters(MCC_ALLOC_PHASE_OTHER).calls);
+
+	// Rows generated by the threads of the pool count for IR generation
+	struct mcc_alloc_counters ir_phase = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_IR);
+	struct mcc_alloc_counters row = mcc_alloc_kind_counters(MCC_ALLOC_IR_ROW);
+	CuAssertTrue(tc, ir_phase.calls - ir_before.calls >= row.calls - row_before.calls);
+	CuAssertTrue(tc, ir_phase.bytes - ir_before.bytes >= row.bytes - row_before.bytes);
+	CuAssertIntEquals(tc, parser.calls, mcc_alloc_phase_counters(MCC_ALLOC_PHASE_PARSER).calls);
+
+	mcc_ir_packed_delete(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_thread_pool_set_threads(0);
+}
+
+void arena_objects(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	struct mcc_alloc_counters ast_before = mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE);
+	struct mcc_alloc_counters arena_before = mcc_alloc_kind_counters(MCC_ALLOC_ARENA);
+
+	struct mcc_arena *arena = mcc_arena_new();
+	CuAssertPtrNotNull(tc, arena);
+	mcc_arena_set_current(arena);
+	struct mcc_parser_result parser_result = mcc_parse_string(PROGRAM, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	mcc_arena_set_current(NULL);
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+
+	// Nodes are live until the arena is deleted, the arena keeps the rest of its chunks
+	struct mcc_alloc_counters ast = mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE);
+	CuAssertTrue(tc, ast.calls > ast_before.calls);
+	CuAssertTrue(tc, ast.live > ast_before.live);
+	CuAssertTrue(tc, ast.peak >= ast.live);
+	CuAssertTrue(tc, mcc_alloc_kind_counters(MCC_ALLOC_ARENA).live > arena_before.live);
+
+	mcc_arena_delete(arena);
+	CuAssertIntEquals(tc, ast_before.live, mcc_alloc_kind_counters(MCC_ALLOC_AST_NODE).live);
+	CuAssertIntEquals(tc, arena_before.live, mcc_alloc_kind_counters(MCC_ALLOC_ARENA).live);
+}
+
+void phase_peak_over_entry(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	struct mcc_alloc_counters cfg_before = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_CFG);
+
+	// Memory that is live when a phase is entered does not count towards its peak
+	size_t large = 1 << 24;
+	void *outside = mcc_malloc(MCC_ALLOC_OTHER, large);
+	CuAssertPtrNotNull(tc, outside);
+	enum mcc_alloc_phase phase = mcc_alloc_set_phase(MCC_ALLOC_PHASE_CFG);
+	void *inside = mcc_malloc(MCC_ALLOC_CFG, 1000);
+	CuAssertPtrNotNull(tc, inside);
+	mcc_alloc_set_phase(phase);
+
+	struct mcc_alloc_counters cfg = mcc_alloc_phase_counters(MCC_ALLOC_PHASE_CFG);
+	CuAssertTrue(tc, cfg.peak >= 1000);
+	CuAssertTrue(tc, cfg.peak < (long)large);
+	CuAssertTrue(tc, cfg.live - cfg_before.live >= 1000);
+	CuAssertTrue(tc, mcc_alloc_total_counters().peak >= (long)large);
+
+	mcc_free(MCC_ALLOC_CFG, inside);
+	mcc_free(MCC_ALLOC_OTHER, outside);
+	CuAssertIntEquals(tc, cfg_before.live, mcc_alloc_phase_counters(MCC_ALLOC_PHASE_CFG).live);
+}
+
+void freed_with_free(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	struct mcc_alloc_counters before = mcc_alloc_kind_counters(MCC_ALLOC_STRING);
+
+	// The error buffer of the parser is handed over and may be released with free
+	struct mcc_parser_result result = mcc_parse_string("int main(", MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertTrue(tc, MCC_PARSER_STATUS_OK != result.status);
+	CuAssertPtrNotNull(tc, result.error_buffer);
+	CuAssertTrue(tc, mcc_alloc_kind_counters(MCC_ALLOC_STRING).live > before.live);
+	free(result.error_buffer);
+}
+
+void phases_freed_in_other_phases(CuTest *tc)
+{
+	mcc_alloc_enable_stats();
+	mcc_thread_pool_set_threads(4);
+	struct mcc_alloc_counters before[MCC_ALLOC_PHASE_COUNT];
+	for (int i = 0; i < MCC_ALLOC_PHASE_COUNT; i++) {
+		before[i] = mcc_alloc_phase_counters(i);
+	}
+
+	// Data structures of a phase are freed outside of it
+	struct mcc_parser_result parser_result = mcc_parse_string(PROGRAM, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_ir_packed *packed = generate_ir(tc, parser_result.program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	CuAssertPtrNotNull(tc, ir);
+	struct mcc_asm *code = mcc_asm_generate(ir);
+	CuAssertPtrNotNull(tc, code);
+	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	CuAssertPtrNotNull(tc, cfg);
+	CuAssertTrue(tc, mcc_alloc_phase_counters(MCC_ALLOC_PHASE_ASM).live > before[MCC_ALLOC_PHASE_ASM].live);
+
+	mcc_alloc_set_phase(MCC_ALLOC_PHASE_OTHER);
+	mcc_asm_delete_asm(code);
+	mcc_delete_cfg_and_ir(cfg);
+	mcc_ir_packed_delete(packed);
+	mcc_ast_delete(parser_result.program);
+	// Also releases the threads, which were started during the semantic checks
+	mcc_thread_pool_set_threads(0);
+	for (int i = 0; i < MCC_ALLOC_PHASE_COUNT; i++) {
+		struct mcc_alloc_counters phase = mcc_alloc_phase_counters(i);
+		CuAssertTrue(tc, phase.live >= 0);
+		CuAssertIntEquals(tc, before[i].live, phase.live);
+	}
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(counted_per_kind) \
+	TEST(counted_per_phase) \
+	TEST(arena_objects) \
+	TEST(phase_peak_over_entry) \
+	TEST(phases_freed_in_other_phases) \
+	TEST(freed_with_free)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
@@ -7,6 +7,7 @@
 #include "mcc/asm.h"
 #include "mcc/ast.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "mcc/semantic_checks.h"
 #include "mcc/stack_size.h"
 #include "mcc/symbol_table.h"
@@ -21,7 +22,10 @@ void test1(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -74,7 +78,10 @@ void stack_frame_size_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -102,7 +109,10 @@ void addition_lit(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -173,7 +183,10 @@ void div_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -236,7 +249,10 @@ void strings(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -308,7 +324,10 @@ void strings2(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_asm *code = mcc_asm_generate(ir);
@@ -369,6 +388,62 @@ void strings2(CuTest *tc)
 	mcc_symbol_table_delete_table(table);
 	mcc_asm_delete_asm(code);
 }
+
+void literal_pool(CuTest *tc)
+{
+	// Define test input and create IR
+	const char input[] = "void f(){print(\"x\"); print_float(1.5);}"
+	                     "int main(){string a; a = \"x\"; float b; b = 1.5; print(\"x\"); print_float(-1.5); f();"
+	                     "return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_asm *code = mcc_asm_generate(ir);
+	CuAssertPtrNotNull(tc, code);
+
+	// Identical literals across functions share one declaration
+	int strings = 0;
+	int floats = 0;
+	for (struct mcc_asm_declaration *decl = code->data_section->head; decl; decl = decl->next) {
+		if (decl->type == MCC_ASM_DECLARATION_TYPE_STRING) {
+			CuAssertStrEquals(tc, "x", decl->string_value);
+			strings++;
+		} else {
+			floats++;
+		}
+	}
+	CuAssertIntEquals(tc, 1, strings);
+	CuAssertIntEquals(tc, 2, floats);
+
+	mcc_ir_delete_ir(ir);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_asm_delete_asm(code);
+}
+void empty_text_section(CuTest *tc)
+{
+	struct mcc_asm_data data = {.has_failed = false};
+	struct mcc_asm_text_section *text_section = mcc_asm_new_text_section(NULL, &data);
+	CuAssertPtrNotNull(tc, text_section);
+
+	// IR without functions
+	mcc_asm_generate_text_section(text_section, NULL, &data);
+	CuAssertTrue(tc, !data.has_failed);
+	CuAssertPtrEquals(tc, NULL, text_section->function);
+
+	mcc_asm_delete_text_section(text_section);
+}
+
 // clang-format off
 
 #define TESTS \
@@ -377,7 +452,9 @@ void strings2(CuTest *tc)
 	TEST(addition_lit) \
 	TEST(div_int) \
 	TEST(strings) \
-	TEST(strings2)
+	TEST(strings2) \
+	TEST(literal_pool) \
+	TEST(empty_text_section)
 
 // clang-format on
 
@@ -0,0 +1,130 @@
+#include <CuTest.h>
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/symbol_table.h"
+
+static const char loop_input[] = "int main(){int i; i = 0; while (i < 3) { if (i == 1) { i = i + 2; } else"
+                                 "{ i = i + 1; } } return i;}";
+
+static struct mcc_basic_block *get_block(struct mcc_basic_block *head, unsigned id)
+{
+	while (head && head->id != id) {
+		head = head->next;
+	}
+	return head;
+}
+
+static bool has_predecessor(struct mcc_basic_block *block, struct mcc_basic_block *predecessor)
+{
+	for (unsigned i = 0; i < block->num_predecessors; i++) {
+		if (block->predecessors[i] == predecessor)
+			return true;
+	}
+	return false;
+}
+
+void blocks_and_edges(CuTest *tc)
+{
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(loop_input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	CuAssertPtrNotNull(tc, cfg);
+
+	// IDs are dense and follow the IR
+	unsigned num_blocks = 0;
+	for (struct mcc_basic_block *block = cfg; block; block = block->next) {
+		CuAssertIntEquals(tc, num_blocks, block->id);
+		num_blocks++;
+	}
+	CuAssertIntEquals(tc, 7, num_blocks);
+
+	// Every successor edge has its predecessor edge
+	for (struct mcc_basic_block *block = cfg; block; block = block->next) {
+		for (unsigned i = 0; i < block->num_successors; i++) {
+			CuAssertTrue(tc, has_predecessor(block->successors[i], block));
+		}
+	}
+
+	// Loop header is reached from the entry and the end of the loop body
+	struct mcc_basic_block *header = get_block(cfg, 1);
+	CuAssertIntEquals(tc, MCC_IR_INSTR_LABEL, header->leader->instr);
+	CuAssertIntEquals(tc, 2, header->num_predecessors);
+	CuAssertTrue(tc, has_predecessor(header, get_block(cfg, 0)));
+	CuAssertTrue(tc, has_predecessor(header, get_block(cfg, 5)));
+
+	// Conditional jump: fall through first, then the jump target
+	CuAssertIntEquals(tc, 2, header->num_successors);
+	CuAssertPtrEquals(tc, get_block(cfg, 2), header->successors[0]);
+	CuAssertPtrEquals(tc, get_block(cfg, 6), header->successors[1]);
+
+	// Return ends the function
+	CuAssertIntEquals(tc, 0, get_block(cfg, 6)->num_successors);
+
+	// IR of the blocks is truncated before the next leader
+	CuAssertPtrEquals(tc, NULL, get_block(cfg, 5)->leader->next_row->next_row);
+
+	mcc_delete_cfg_and_ir(cfg);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+void limit_to_function(CuTest *tc)
+{
+	const char input[] = "void f(){int a; a = 1; if (a == 1) {a = 2;}} int main(){f(); return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	CuAssertPtrNotNull(tc, cfg);
+	cfg = mcc_cfg_limit_to_function("main", cfg);
+	CuAssertPtrNotNull(tc, cfg);
+
+	CuAssertStrEquals(tc, "main", cfg->leader->arg1->func_label);
+	CuAssertIntEquals(tc, 0, cfg->id);
+	CuAssertIntEquals(tc, 0, cfg->num_predecessors);
+	CuAssertPtrEquals(tc, NULL, cfg->next);
+
+	mcc_delete_cfg_and_ir(cfg);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(blocks_and_edges) \
+	TEST(limit_to_function)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
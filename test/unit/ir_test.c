@@ -1,11 +1,15 @@
 #include <CuTest.h>
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/ir_print.h"
 #include "mcc/semantic_checks.h"
 #include "mcc/symbol_table.h"
 
@@ -20,7 +24,10 @@ void test1(CuTest *tc)
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 
 	CuAssertPtrNotNull(tc, ir);
@@ -53,8 +60,13 @@ void expression(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir_head = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir = ir_head->next_row;
 
 	CuAssertPtrNotNull(tc, ir);
@@ -79,6 +91,7 @@ void expression(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void exp_plus_exp(CuTest *tc)
@@ -88,8 +101,13 @@ void exp_plus_exp(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir_head = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir = ir_head->next_row;
 
 	CuAssertPtrNotNull(tc, ir);
@@ -107,6 +125,7 @@ void exp_plus_exp(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void expression_var(CuTest *tc)
@@ -116,8 +135,13 @@ void expression_var(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir_head = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir = ir_head->next_row;
 
 	CuAssertPtrNotNull(tc, ir);
@@ -142,6 +166,7 @@ void expression_var(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void expression_arr(CuTest *tc)
@@ -151,8 +176,13 @@ void expression_arr(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir_head = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir_head = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir = ir_head->next_row;
 
 	CuAssertIntEquals(tc, ir->instr, MCC_IR_INSTR_ARRAY);
@@ -186,6 +216,7 @@ void expression_arr(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void if_stmt(CuTest *tc)
@@ -195,8 +226,13 @@ void if_stmt(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
@@ -258,6 +294,7 @@ void if_stmt(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void if_else_stmt(CuTest *tc)
@@ -267,8 +304,13 @@ void if_else_stmt(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
@@ -348,6 +390,7 @@ void if_else_stmt(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void while_stmt(CuTest *tc)
@@ -357,8 +400,13 @@ void while_stmt(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir;
 	// Skip first row
@@ -450,6 +498,7 @@ void while_stmt(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void func_def(CuTest *tc)
@@ -459,8 +508,13 @@ void func_def(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *tmp = ir;
 	struct mcc_ir_row *ir_head = ir;
 
@@ -516,6 +570,7 @@ void func_def(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void func_call(CuTest *tc)
@@ -526,8 +581,13 @@ void func_call(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *tmp = ir;
 	struct mcc_ir_row *ir_head = ir;
 
@@ -569,6 +629,7 @@ void func_call(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void variable_shadowing(CuTest *tc)
@@ -579,8 +640,13 @@ void variable_shadowing(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir->next_row;
 
@@ -628,6 +694,257 @@ void variable_shadowing(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+void array_shadowing(CuTest *tc)
+{
+	const char input[] = "int main(){int [2]a; a[0]=1; {int [3]a; a[1] = a[0];} return a[0];}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_row *tmp = ir->next_row->next_row;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1->arr_ident, "a");
+
+	tmp = tmp->next_row->next_row;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1->arr_ident, "$r0");
+	CuAssertStrEquals(tc, tmp->arg2->arr_ident, "$r0");
+
+	tmp = tmp->next_row;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_RETURN);
+	CuAssertStrEquals(tc, tmp->arg1->arr_ident, "a");
+
+	// Cleanup
+	mcc_ir_delete_ir(ir_head);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+// Labels and temporaries continue across functions although functions are generated independently
+void numbering_across_functions(CuTest *tc)
+{
+	const char input[] = "void f(){print_float(1.5); if (true) {}} int main(){print_float(2.5); if (true) {} return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	unsigned labels = 0;
+	unsigned max_label = 0;
+	bool first_tmp = false;
+	bool second_tmp = false;
+	for (struct mcc_ir_row *row = ir; row; row = row->next_row) {
+		if (row->instr == MCC_IR_INSTR_LABEL) {
+			labels++;
+			max_label = row->arg1->label > max_label ? row->arg1->label : max_label;
+		}
+		if (row->instr == MCC_IR_INSTR_ASSIGN && row->arg1->type == MCC_IR_TYPE_IDENTIFIER) {
+			CuAssertTrue(tc, row->arg1->is_tmp);
+			first_tmp |= row->arg1->tmp == 0;
+			second_tmp |= row->arg1->tmp == 1;
+		}
+	}
+	CuAssertIntEquals(tc, labels - 1, max_label);
+	CuAssertTrue(tc, first_tmp && second_tmp);
+
+	// Cleanup
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+void symbol_ids(CuTest *tc)
+{
+	const char input[] = "int main(){int a; int[2] b; a = 1; {int a; a = 2; b[a] = a;} return a;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	// Equal names share an ID, IDs are dense
+	unsigned num_symbols = ir->arg1->num_symbols;
+	CuAssertIntEquals(tc, 3, num_symbols);
+	const char *names[3] = {NULL};
+	for (struct mcc_ir_row *row = ir->next_row; row; row = row->next_row) {
+		struct mcc_ir_arg *args[] = {row->arg1, row->arg2, NULL};
+		if (row->arg1 && row->arg1->type == MCC_IR_TYPE_ARR_ELEM)
+			args[2] = row->arg1->index;
+		for (int i = 0; i < 3; i++) {
+			if (!args[i] || (args[i]->type != MCC_IR_TYPE_IDENTIFIER && args[i]->type != MCC_IR_TYPE_ARR_ELEM))
+				continue;
+			const char *name = args[i]->type == MCC_IR_TYPE_IDENTIFIER ? args[i]->ident : args[i]->arr_ident;
+			CuAssertTrue(tc, args[i]->symbol < num_symbols);
+			if (!names[args[i]->symbol])
+				names[args[i]->symbol] = name;
+			CuAssertStrEquals(tc, names[args[i]->symbol], name);
+		}
+	}
+	for (unsigned i = 0; i < num_symbols; i++) {
+		CuAssertPtrNotNull(tc, names[i]);
+	}
+
+	// Cleanup
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+// Returns everything written to out and closes it
+static char *read_back(FILE *out)
+{
+	long size = ftell(out);
+	rewind(out);
+	char *printed = calloc(size + 1, 1);
+	if (printed && fread(printed, 1, size, out) != (size_t)size) {
+		free(printed);
+		printed = NULL;
+	}
+	fclose(out);
+	return printed;
+}
+
+void packed_round_trip(CuTest *tc)
+{
+	const char input[] = "float g(float x, int[3] v){v[1] = 2; return x * 2.5;}"
+	                     "int main(){int[3] a; int i; i = 0; while (i < 3) {a[i] = i; i = i + 1;}"
+	                     "print(\"done\"); print_float(g(1.5, a)); return a[2];}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+
+	CuAssertIntEquals(tc, 2, packed->num_functions);
+	CuAssertStrEquals(tc, "g", packed->functions[0].name);
+	CuAssertStrEquals(tc, "main", packed->functions[1].name);
+
+	// Row references stay inside their function and row types are interned
+	for (uint32_t i = 0; i < packed->num_functions; i++) {
+		struct mcc_ir_packed_function *function = &packed->functions[i];
+		CuAssertTrue(tc, function->num_types < function->num_rows);
+		for (uint32_t j = 0; j < function->num_rows; j++) {
+			if (function->rows[j].arg2.type == MCC_IR_TYPE_ROW)
+				CuAssertTrue(tc, function->rows[j].arg2.ref < j);
+		}
+	}
+
+	// g has no labels, one float temporary and three numbered rows: two pops and the multiplication
+	CuAssertIntEquals(tc, 0, packed->functions[1].label_offset);
+	CuAssertIntEquals(tc, 1, packed->functions[1].tmp_offset);
+	CuAssertIntEquals(tc, 3, packed->functions[1].row_no_offset);
+
+	struct mcc_ir_row *view = mcc_ir_packed_to_rows(packed);
+	CuAssertPtrNotNull(tc, view);
+	uint32_t num_rows = 0;
+	bool shifted_tmp = false;
+	for (struct mcc_ir_row *row = view; row; row = row->next_row) {
+		num_rows++;
+		if (num_rows > packed->functions[0].num_rows && row->arg1 && row->arg1->type == MCC_IR_TYPE_IDENTIFIER &&
+		    row->arg1->is_tmp)
+			shifted_tmp |= row->arg1->tmp == 1;
+	}
+	CuAssertIntEquals(tc, packed->functions[0].num_rows + packed->functions[1].num_rows, num_rows);
+	CuAssertTrue(tc, shifted_tmp);
+
+	// The packed IR is printed like its compatibility view
+	FILE *linked_out = tmpfile();
+	FILE *packed_out = tmpfile();
+	CuAssertPtrNotNull(tc, linked_out);
+	CuAssertPtrNotNull(tc, packed_out);
+	mcc_ir_print_ir(linked_out, view, true, true);
+	mcc_ir_print_packed(packed_out, packed, true, true);
+	char *linked_printed = read_back(linked_out);
+	char *packed_printed = read_back(packed_out);
+	CuAssertPtrNotNull(tc, linked_printed);
+	CuAssertPtrNotNull(tc, packed_printed);
+	CuAssertStrEquals(tc, linked_printed, packed_printed);
+	free(linked_printed);
+	free(packed_printed);
+
+	// Cleanup
+	mcc_ir_delete_ir(view);
+	mcc_ir_packed_delete(packed);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+}
+
+void variable_shadowing_in_arena(CuTest *tc)
+{
+	const char input[] = "void f(){int a; {int a; a = 1;}} int main(){f(); return 0;}";
+	struct mcc_arena *arena = mcc_arena_new();
+	CuAssertPtrNotNull(tc, arena);
+	mcc_arena_set_current(arena);
+
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	CuAssertPtrEquals(tc, arena, parser_result.program->node.arena);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+	CuAssertPtrEquals(tc, arena, table->arena);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	struct mcc_ir_row *ir_head = ir;
+	struct mcc_ir_row *tmp = ir->next_row;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_ASSIGN);
+	CuAssertStrEquals(tc, tmp->arg1->ident, "$r0");
+
+	// Empty return appended to void function
+	tmp = tmp->next_row;
+
+	CuAssertIntEquals(tc, tmp->instr, MCC_IR_INSTR_RETURN);
+	CuAssertPtrEquals(tc, tmp->arg1, NULL);
+
+	// Cleanup, deleting AST and symbol table is a no-op, memory is released with the arena
+	mcc_ir_delete_ir(ir_head);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_arena_delete(arena);
+	CuAssertPtrEquals(tc, NULL, mcc_arena_get_current());
 }
 
 void type_test(CuTest *tc)
@@ -638,8 +955,13 @@ void type_test(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir->next_row;
 
@@ -670,6 +992,7 @@ void type_test(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 void type_array_test(CuTest *tc)
@@ -680,8 +1003,13 @@ void type_array_test(CuTest *tc)
 	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
 	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
 
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	struct mcc_ir_row *ir_head = ir;
 	struct mcc_ir_row *tmp = ir->next_row;
 
@@ -707,6 +1035,7 @@ void type_array_test(CuTest *tc)
 	mcc_ir_delete_ir(ir_head);
 	mcc_ast_delete(parser_result.program);
 	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
 }
 
 // clang-format off
@@ -723,8 +1052,13 @@ void type_array_test(CuTest *tc)
 	TEST(func_def) \
 	TEST(func_call)\
 	TEST(variable_shadowing) \
+	TEST(variable_shadowing_in_arena) \
+	TEST(array_shadowing) \
 	TEST(type_test) \
-	TEST(type_array_test)
+	TEST(type_array_test) \
+	TEST(numbering_across_functions) \
+	TEST(symbol_ids) \
+	TEST(packed_round_trip)
 
 // clang-format on
 
@@ -3,8 +3,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
+#include "mcc/ast_visit.h"
+#include "mcc/input.h"
+#include "mcc/intern.h"
 #include "mcc/parser.h"
+#include "mcc/thread_pool.h"
 
 // Threshold for floating point comparisions.
 static const double EPS = 1e-3;
@@ -990,6 +995,143 @@ void DanglingElse(CuTest *tc)
 	mcc_ast_delete(stmt);
 }
 
+void InternedIdentifiers(CuTest *tc)
+{
+	const char input[] = "{a = 1; a = 2; b = 3;}";
+	struct mcc_parser_result result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_EXPRESSION, "test");
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+
+	struct mcc_ast_compound_statement *stmt = result.compound_statement;
+	struct mcc_ast_compound_statement *last = stmt->next_compound_statement->next_compound_statement;
+	char *first = stmt->statement->assignment->variable_identifier->identifier_name;
+	char *second = stmt->next_compound_statement->statement->assignment->variable_identifier->identifier_name;
+	char *third = last->statement->assignment->variable_identifier->identifier_name;
+
+	CuAssertPtrEquals(tc, first, second);
+	CuAssertTrue(tc, first != third);
+	CuAssertPtrEquals(tc, mcc_intern("a"), first);
+	CuAssertPtrEquals(tc, mcc_intern_find("b"), third);
+
+	mcc_ast_delete(stmt);
+}
+
+#define NUM_INTERNED 4096
+
+// Every name is interned by several tasks at once
+static void intern_name(int index, void *userdata)
+{
+	char **interned = userdata;
+	char name[16];
+	snprintf(name, sizeof(name), "n%d", index % (NUM_INTERNED / 4));
+	interned[index] = mcc_intern(name);
+}
+
+void InternConcurrently(CuTest *tc)
+{
+	char *interned[NUM_INTERNED];
+	mcc_thread_pool_set_threads(4);
+	mcc_thread_pool_for(NUM_INTERNED, intern_name, interned);
+	mcc_thread_pool_set_threads(0);
+
+	for (int i = 0; i < NUM_INTERNED; i++) {
+		char name[16];
+		snprintf(name, sizeof(name), "n%d", i % (NUM_INTERNED / 4));
+		CuAssertPtrNotNull(tc, interned[i]);
+		CuAssertStrEquals(tc, name, interned[i]);
+		CuAssertPtrEquals(tc, mcc_intern_find(name), interned[i]);
+	}
+}
+
+void ParseInputFromStream(CuTest *tc)
+{
+	const char input[] = "int main(){return 0;}";
+	FILE *stream = tmpfile();
+	CuAssertPtrNotNull(tc, stream);
+	fputs(input, stream);
+	rewind(stream);
+
+	struct mcc_input *buffer = mcc_input_from_stream(stream);
+	fclose(stream);
+	CuAssertPtrNotNull(tc, buffer);
+	CuAssertIntEquals(tc, sizeof(input) - 1, buffer->size);
+	CuAssertIntEquals(tc, '\0', buffer->buffer[buffer->size]);
+	CuAssertIntEquals(tc, '\0', buffer->buffer[buffer->size + 1]);
+
+	struct mcc_parser_result result = mcc_parse_input(buffer, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	mcc_input_delete(buffer);
+
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, result.status);
+	CuAssertPtrEquals(tc, mcc_intern("main"), result.program->function->identifier->identifier_name);
+
+	mcc_ast_delete(result.program);
+}
+
+struct visit_order {
+	long count;
+	long last_literal;
+	bool in_order;
+};
+
+static void cb_count_literal(struct mcc_ast_literal *literal, void *data)
+{
+	struct visit_order *order = data;
+	if (literal->i_value != order->last_literal + 1)
+		order->in_order = false;
+	order->last_literal = literal->i_value;
+}
+
+static void cb_count_compound_statement(struct mcc_ast_compound_statement *compound_statement, void *data)
+{
+	struct visit_order *order = data;
+	order->count++;
+	// Post-order: the rest of the list is done before its head
+	if (order->count == 1 && compound_statement->has_next_statement)
+		order->in_order = false;
+}
+
+void VisitLongStatementList(CuTest *tc)
+{
+	// Longer than the native stack would allow when recursing once per statement
+	const long num_statements = 1000000;
+
+	struct mcc_arena *arena = mcc_arena_new();
+	CuAssertPtrNotNull(tc, arena);
+	mcc_arena_set_current(arena);
+	struct mcc_ast_compound_statement *list = NULL;
+	for (long i = num_statements; i > 0; i--) {
+		struct mcc_ast_statement *statement =
+		    mcc_ast_new_statement_expression(mcc_ast_new_expression_literal(mcc_ast_new_literal_int(i)));
+		list = mcc_ast_new_compound_stmt(false, statement, list);
+		CuAssertPtrNotNull(tc, list);
+	}
+	mcc_arena_set_current(NULL);
+
+	struct visit_order order = {.count = 0, .last_literal = 0, .in_order = true};
+	struct mcc_ast_visitor visitor = {
+	    .order = MCC_AST_VISIT_PRE_ORDER,
+	    .userdata = &order,
+	    .literal_int = cb_count_literal,
+	};
+	mcc_ast_visit(list, &visitor);
+	CuAssertTrue(tc, !visitor.has_failed);
+	CuAssertTrue(tc, order.in_order);
+	CuAssertIntEquals(tc, num_statements, order.last_literal);
+
+	order = (struct visit_order){.count = 0, .last_literal = 0, .in_order = true};
+	visitor = (struct mcc_ast_visitor){.order = MCC_AST_VISIT_POST_ORDER,
+	                                   .userdata = &order,
+	                                   .literal_int = cb_count_literal,
+	                                   .compound_statement = cb_count_compound_statement};
+	mcc_ast_visit(list, &visitor);
+	CuAssertTrue(tc, !visitor.has_failed);
+	CuAssertTrue(tc, order.in_order);
+	CuAssertIntEquals(tc, num_statements, order.last_literal);
+	CuAssertIntEquals(tc, num_statements, order.count);
+
+	mcc_arena_delete(arena);
+}
+
 #define TESTS \
 	TEST(ArrayAssignment) \
 	TEST(BinaryOp_1) \
@@ -1023,7 +1165,11 @@ void DanglingElse(CuTest *tc)
 	TEST(EmptyCompound) \
 	TEST(EmptyFunctionCall) \
 	TEST(EmptyParameters) \
-	TEST(DanglingElse)
+	TEST(DanglingElse) \
+	TEST(InternedIdentifiers) \
+	TEST(InternConcurrently) \
+	TEST(ParseInputFromStream) \
+	TEST(VisitLongStatementList)
 
 #include "main_stub.inc"
 #undef TESTS
@@ -812,6 +812,32 @@ void multiple_function_definitions3(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+// The first function that is defined again is reported
+void multiple_function_definitions4(CuTest *tc)
+{
+
+	// Define test input and create symbol table
+	const char input[] = "int f(){} int g(){} int g(){} int f(){}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
+	CuAssertPtrNotNull(tc, check);
+	enum mcc_semantic_check_error_code error =
+	    mcc_semantic_check_run_multiple_function_definitions((&parser_result)->program, table, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_ERROR_OK, error);
+
+	CuAssertPtrNotNull(tc, check->error_buffer);
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+	CuAssertPtrNotNull(tc, strstr(check->error_buffer, "redefinition of 'f'"));
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
 // A variable is declared more than once in the same scope
 void multiple_variable_declarations(CuTest *tc)
 {
@@ -1249,6 +1275,32 @@ void function_arguments3(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+// Calling every builtin correctly, builtins are not added to the AST
+void function_arguments_built_ins(CuTest *tc)
+{
+	// Define test input and create symbol table
+	const char input[] = "int main(){print(\"a\"); print_nl(); print_int(read_int()); print_float(read_float()); "
+	                     "return 0;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	CuAssertPtrEquals(tc, NULL, parser_result.program->next_function);
+	struct mcc_semantic_check *check = mcc_semantic_check_initialize_check();
+	CuAssertPtrNotNull(tc, check);
+	enum mcc_semantic_check_error_code error =
+	    mcc_semantic_check_run_function_arguments((&parser_result)->program, table, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_ERROR_OK, error);
+
+	CuAssertPtrEquals(tc, NULL, check->error_buffer);
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_OK);
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
 // invalid array operation, assignment of whole array
 void invalid_array_operation(CuTest *tc)
 {
@@ -1398,6 +1450,117 @@ void empty(CuTest *tc)
 	mcc_semantic_check_delete_single_check(check);
 }
 
+// Running all checks on an empty program reports the missing main function
+void empty_run_all(CuTest *tc)
+{
+	const char input[] = "";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertPtrNotNull(tc, check);
+
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+	CuAssertPtrNotNull(tc, strstr(check->error_buffer, "No main function defined."));
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
+// The checks keep the type of each expression in the AST
+void expression_types(CuTest *tc)
+{
+	const char input[] = "int f(int[3] x){return x[0];} int main(){int[3] a; a[0] = 2; return f(a) + (a[1] * 3);}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertPtrNotNull(tc, check);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, check->status);
+
+	struct mcc_ast_compound_statement *body = parser_result.program->next_function->function->compound_stmt;
+	struct mcc_ast_statement *return_stmt = body->next_compound_statement->next_compound_statement->statement;
+	struct mcc_ast_expression *sum = return_stmt->return_value;
+	CuAssertTrue(tc, sum->data_type.is_known);
+	CuAssertIntEquals(tc, INT, sum->data_type.type);
+	CuAssertIntEquals(tc, -1, sum->data_type.array_size);
+
+	// Arguments of function calls, array elements and parenthesized expressions
+	struct mcc_ast_expression *array = sum->lhs->arguments->expression;
+	CuAssertTrue(tc, array->data_type.is_known);
+	CuAssertIntEquals(tc, INT, array->data_type.type);
+	CuAssertIntEquals(tc, 3, array->data_type.array_size);
+	struct mcc_ast_expression *element = sum->rhs->expression->lhs;
+	CuAssertTrue(tc, element->data_type.is_known);
+	CuAssertIntEquals(tc, -1, element->data_type.array_size);
+	CuAssertTrue(tc, sum->rhs->data_type.is_known);
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
+// Return without value from a non-void function
+void empty_return(CuTest *tc)
+{
+	const char input[] = "int main(){return;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertPtrNotNull(tc, check);
+
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+	CuAssertPtrNotNull(tc, strstr(check->error_buffer, "return value of type 'VOID', expected 'INT'."));
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+}
+
+// Functions are checked concurrently, the reported error is still the first one in the source
+void errors_in_source_order(CuTest *tc)
+{
+	enum { NUM_FUNCTIONS = 200, FUNCTION_SIZE = 64 };
+	char *input = malloc(NUM_FUNCTIONS * FUNCTION_SIZE);
+	CuAssertPtrNotNull(tc, input);
+	char *end = input;
+	for (int i = 0; i < NUM_FUNCTIONS; i++) {
+		// Type errors in f50 and f150, a missing return value in f100
+		const char *body = "int a; a = 1; return a;";
+		if (i == 50 || i == 150) {
+			body = "int a; a = true; return a;";
+		} else if (i == 100) {
+			body = "int a; a = 1;";
+		}
+		end += sprintf(end, "int f%d(){%s}\n", i, body);
+	}
+	sprintf(end, "int main(){return 0;}");
+
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *check = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertPtrNotNull(tc, check);
+
+	CuAssertIntEquals(tc, check->status, MCC_SEMANTIC_CHECK_FAIL);
+	CuAssertStrEquals(tc, "test:51:18: implicit type conversion. Expected 'INT' but was 'BOOL'", check->error_buffer);
+
+	// Cleanup
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(check);
+	free(input);
+}
+
 #define TESTS \
 	TEST(positive) \
 	TEST(ensure_variable_shadowing) \
@@ -1430,6 +1593,7 @@ void empty(CuTest *tc)
 	TEST(multiple_function_definitions) \
 	TEST(multiple_function_definitions2) \
 	TEST(multiple_function_definitions3) \
+	TEST(multiple_function_definitions4) \
 	TEST(multiple_variable_declarations) \
 	TEST(multiple_variable_declarations2) \
 	TEST(use_undeclared_variable) \
@@ -1447,12 +1611,17 @@ void empty(CuTest *tc)
 	TEST(function_arguments1) \
 	TEST(function_arguments2) \
 	TEST(function_arguments3) \
+	TEST(function_arguments_built_ins) \
 	TEST(invalid_array_operation) \
 	TEST(invalid_array_operation2) \
 	TEST(invalid_array_operation3) \
 	TEST(invalid_array_operation4) \
 	TEST(invalid_array_operation5) \
-	TEST(empty)
+	TEST(empty) \
+	TEST(empty_run_all) \
+	TEST(expression_types) \
+	TEST(empty_return) \
+	TEST(errors_in_source_order)
 #include "main_stub.inc"
 #undef TESTS
 
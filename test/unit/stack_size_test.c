@@ -7,6 +7,7 @@
 #include "mcc/asm.h"
 #include "mcc/ast.h"
 #include "mcc/ir.h"
+#include "mcc/ir_packed.h"
 #include "mcc/semantic_checks.h"
 #include "mcc/stack_size.h"
 #include "mcc/symbol_table.h"
@@ -21,7 +22,10 @@ void test_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -49,7 +53,10 @@ void test_ints(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -83,7 +90,10 @@ void test_int_temporaries(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -114,7 +124,10 @@ void test_int_array(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -151,7 +164,10 @@ void test_int_multiple_references(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -198,7 +214,10 @@ void test_bool_int(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -228,7 +247,10 @@ void test_strings(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -263,7 +285,10 @@ void test_string_array(CuTest *tc)
 	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
 	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
 	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
-	struct mcc_ir_row *ir = mcc_ir_generate((&parser_result)->program);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
 	CuAssertPtrNotNull(tc, ir);
 
 	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
@@ -297,6 +322,53 @@ void test_string_array(CuTest *tc)
 	mcc_delete_annotated_ir(first);
 }
 
+void test_frame_layout(CuTest *tc)
+{
+	// Define test input and create IR
+	const char input[] = "int main(){int a; int [4]b; a = 1; b[1] = a; a = 2; return a;}";
+	struct mcc_parser_result parser_result;
+	parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create((&parser_result)->program);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all((&parser_result)->program, table);
+	CuAssertIntEquals(tc, checks->status, MCC_SEMANTIC_CHECK_OK);
+	struct mcc_ir_packed *packed = mcc_ir_generate((&parser_result)->program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
+	struct mcc_annotated_ir *first = an_ir;
+	CuAssertPtrNotNull(tc, an_ir);
+	CuAssertPtrNotNull(tc, an_ir->layout);
+
+	// b = array
+	struct mcc_annotated_ir *array = an_ir->next;
+	struct mcc_annotated_ir *assign = array->next;
+	unsigned a = assign->row->arg1->symbol;
+	unsigned b = array->row->arg1->symbol;
+	CuAssertStrEquals(tc, "a", assign->row->arg1->ident);
+	CuAssertStrEquals(tc, "b", array->row->arg1->ident);
+	CuAssertTrue(tc, a != b);
+	CuAssertIntEquals(tc, 2, an_ir->row->arg1->num_symbols);
+	CuAssertPtrEquals(tc, array, mcc_get_array_declaration(an_ir, b));
+	CuAssertPtrEquals(tc, NULL, mcc_get_array_declaration(an_ir, a));
+
+	// a = 1 owns the slot of a, a = 2 reuses it
+	CuAssertPtrEquals(tc, assign, mcc_get_variable_declaration(an_ir, a));
+	CuAssertIntEquals(tc, a, assign->next->next->row->arg1->symbol);
+	CuAssertIntEquals(tc, assign->stack_position, assign->next->next->stack_position);
+	CuAssertPtrEquals(tc, NULL, mcc_get_variable_declaration(an_ir, an_ir->row->arg1->num_symbols));
+
+	// Cleanup
+	mcc_ir_delete_ir(ir);
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_delete_annotated_ir(first);
+}
+
 // clang-format off
 
 #define TESTS \
@@ -307,7 +379,8 @@ void test_string_array(CuTest *tc)
 	TEST(test_int_array) \
 	TEST(test_int_multiple_references) \
 	TEST(test_strings) \
-	TEST(test_string_array)
+	TEST(test_string_array) \
+	TEST(test_frame_layout)
 
 // clang-format on
 
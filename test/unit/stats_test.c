@@ -0,0 +1,147 @@
+#include <CuTest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/asm.h"
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/parser.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/stack_size.h"
+#include "mcc/stats.h"
+#include "mcc/symbol_table.h"
+
+#define PROGRAM \
+	"int f(int n){if (n < 2) {return n;} return n * 2;}\n" \
+	"void main(){float x; x = 1.5; print(\"a\"); print(\"b\"); print(\"a\"); print_int(f(3));}"
+
+struct compiled {
+	struct mcc_parser_result parser_result;
+	struct mcc_symbol_table *table;
+	struct mcc_semantic_check *checks;
+	struct mcc_ir_packed *ir;
+};
+
+static void compile(CuTest *tc, struct compiled *compiled)
+{
+	compiled->parser_result = mcc_parse_string(PROGRAM, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, compiled->parser_result.status);
+	compiled->table = mcc_symbol_table_create(compiled->parser_result.program);
+	CuAssertPtrNotNull(tc, compiled->table);
+	compiled->checks = mcc_semantic_check_run_all(compiled->parser_result.program, compiled->table);
+	CuAssertPtrNotNull(tc, compiled->checks);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, compiled->checks->status);
+	compiled->ir = mcc_ir_generate(compiled->parser_result.program);
+	CuAssertPtrNotNull(tc, compiled->ir);
+}
+
+static void delete_compiled(struct compiled *compiled)
+{
+	mcc_ir_packed_delete(compiled->ir);
+	mcc_semantic_check_delete_single_check(compiled->checks);
+	mcc_symbol_table_delete_table(compiled->table);
+	mcc_ast_delete(compiled->parser_result.program);
+}
+
+void stats_per_function(CuTest *tc)
+{
+	struct compiled compiled;
+	compile(tc, &compiled);
+	struct mcc_stats *stats = mcc_stats_collect(compiled.parser_result.program, compiled.ir, NULL, NULL, NULL);
+	CuAssertPtrNotNull(tc, stats);
+
+	CuAssertIntEquals(tc, 2, stats->num_functions);
+	struct mcc_stats_function *f = &stats->functions[0];
+	struct mcc_stats_function *main = &stats->functions[1];
+	CuAssertStrEquals(tc, "f", f->name);
+	CuAssertStrEquals(tc, "main", main->name);
+
+	CuAssertTrue(tc, f->ast_nodes > 0);
+	CuAssertTrue(tc, main->ast_nodes > f->ast_nodes);
+	CuAssertIntEquals(tc, 1, f->ir_rows_by_instruction[MCC_IR_INSTR_FUNC_LABEL]);
+	CuAssertIntEquals(tc, 1, f->ir_rows_by_instruction[MCC_IR_INSTR_MULTIPLY]);
+	CuAssertIntEquals(tc, 2, f->ir_rows_by_instruction[MCC_IR_INSTR_RETURN]);
+	CuAssertIntEquals(tc, 5, main->ir_rows_by_instruction[MCC_IR_INSTR_CALL]);
+	unsigned ir_rows = 0;
+	for (int i = 0; i < MCC_STATS_NUM_INSTRUCTIONS; i++) {
+		ir_rows += f->ir_rows_by_instruction[i];
+	}
+	CuAssertIntEquals(tc, f->ir_rows, ir_rows);
+
+	// The if statement splits f, main is straight-line code
+	CuAssertTrue(tc, f->basic_blocks > 1);
+	CuAssertIntEquals(tc, 1, main->basic_blocks);
+	CuAssertTrue(tc, main->frame_size >= 4);
+
+	CuAssertIntEquals(tc, 1, f->asm_lines_by_opcode[MCC_ASM_IMULL]);
+	CuAssertIntEquals(tc, 5, main->asm_lines_by_opcode[MCC_ASM_CALLL]);
+	CuAssertTrue(tc, main->asm_lines > main->asm_lines_by_opcode[MCC_ASM_CALLL]);
+
+	// Equal strings share one declaration, the float variable and the literal get one each
+	CuAssertIntEquals(tc, 2, stats->data_strings);
+	CuAssertIntEquals(tc, 2, stats->data_floats);
+
+	mcc_stats_delete(stats);
+	delete_compiled(&compiled);
+}
+
+void stats_with_given_stages(CuTest *tc)
+{
+	struct compiled compiled;
+	compile(tc, &compiled);
+	struct mcc_ir_row *cfg_rows = mcc_ir_packed_to_rows(compiled.ir);
+	CuAssertPtrNotNull(tc, cfg_rows);
+	struct mcc_basic_block *cfg = mcc_cfg_generate(cfg_rows);
+	CuAssertPtrNotNull(tc, cfg);
+	struct mcc_ir_row *rows = mcc_ir_packed_to_rows(compiled.ir);
+	CuAssertPtrNotNull(tc, rows);
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(rows);
+	CuAssertPtrNotNull(tc, an_ir);
+	struct mcc_asm *assembly = mcc_asm_generate_annotated(an_ir);
+	CuAssertPtrNotNull(tc, assembly);
+
+	struct mcc_stats *generated = mcc_stats_collect(compiled.parser_result.program, compiled.ir, NULL, NULL, NULL);
+	struct mcc_stats *given = mcc_stats_collect(compiled.parser_result.program, compiled.ir, cfg, an_ir, assembly);
+	CuAssertPtrNotNull(tc, generated);
+	CuAssertPtrNotNull(tc, given);
+
+	FILE *out = tmpfile();
+	CuAssertPtrNotNull(tc, out);
+	mcc_stats_print_json(out, generated);
+	long size = ftell(out);
+	mcc_stats_print_json(out, given);
+	CuAssertIntEquals(tc, 2 * size, ftell(out));
+	rewind(out);
+	char *json = calloc(2 * size + 1, 1);
+	CuAssertPtrNotNull(tc, json);
+	CuAssertIntEquals(tc, 2 * size, fread(json, 1, 2 * size, out));
+	fclose(out);
+
+	CuAssertTrue(tc, strncmp(json, json + size, size) == 0);
+	CuAssertTrue(tc, strstr(json, "\"name\": \"main\"") != NULL);
+	CuAssertTrue(tc, strstr(json, "\"data_section\": {\"entries\": 4, \"strings\": 2, \"floats\": 2}") != NULL);
+
+	free(json);
+	mcc_stats_delete(given);
+	mcc_stats_delete(generated);
+	mcc_asm_delete_asm(assembly);
+	mcc_delete_annotated_ir(an_ir);
+	mcc_ir_delete_ir(rows);
+	mcc_delete_cfg_and_ir(cfg);
+	delete_compiled(&compiled);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(stats_per_function) \
+	TEST(stats_with_given_stages)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
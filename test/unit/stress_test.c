@@ -0,0 +1,154 @@
+#include <CuTest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/asm.h"
+#include "mcc/ast.h"
+#include "mcc/cfg.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/stack_size.h"
+#include "mcc/symbol_table.h"
+
+// Statements of the generated function, cycled through. Each cycle generates at least ten rows of IR.
+static const char *const statements[] = {
+    "a = a + 1;",
+    "if (a < 5) { a = a + 2; } else { a = a - 1; }",
+    "b[a] = a * 2;",
+};
+
+#define NUM_ROWS 1000000
+
+// Enough functions that arrays with an entry per function overflow the default stack of 8 MiB
+#define NUM_FUNCTIONS 300000
+
+// Generate an mC program whose main function has about num_rows rows of IR
+static char *generate_long_function(long num_rows)
+{
+	size_t capacity = 64;
+	for (unsigned i = 0; i < sizeof(statements) / sizeof(*statements); i++) {
+		capacity += strlen(statements[i]) + 1;
+	}
+	long repetitions = num_rows / 10 + 1;
+	capacity *= repetitions;
+
+	char *source = malloc(capacity);
+	if (!source)
+		return NULL;
+	char *end = source;
+	end += sprintf(end, "int main(){int a; int[10] b; a = 0;");
+	for (long i = 0; i < repetitions; i++) {
+		for (unsigned j = 0; j < sizeof(statements) / sizeof(*statements); j++) {
+			end += sprintf(end, "%s\n", statements[j]);
+		}
+	}
+	sprintf(end, "return a;}");
+	return source;
+}
+
+void compile_long_function(CuTest *tc)
+{
+	char *source = generate_long_function(NUM_ROWS);
+	CuAssertPtrNotNull(tc, source);
+
+	struct mcc_parser_result parser_result = mcc_parse_string(source, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	free(source);
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(parser_result.program);
+	CuAssertPtrNotNull(tc, table);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all(parser_result.program, table);
+	CuAssertPtrNotNull(tc, checks);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, checks->status);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate(parser_result.program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+	long num_rows = 0;
+	for (struct mcc_ir_row *row = ir; row; row = row->next_row) {
+		num_rows++;
+	}
+	CuAssertTrue(tc, num_rows >= NUM_ROWS);
+
+	struct mcc_annotated_ir *an_ir = mcc_annotate_ir(ir);
+	CuAssertPtrNotNull(tc, an_ir);
+	mcc_delete_annotated_ir(an_ir);
+
+	struct mcc_asm *code = mcc_asm_generate(ir);
+	CuAssertPtrNotNull(tc, code);
+	mcc_asm_delete_asm(code);
+
+	// Takes ownership of the IR
+	struct mcc_basic_block *cfg = mcc_cfg_generate(ir);
+	CuAssertPtrNotNull(tc, cfg);
+	mcc_delete_cfg_and_ir(cfg);
+
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_symbol_table_delete_table(table);
+	mcc_ast_delete(parser_result.program);
+}
+
+// Generate an mC program with num_functions functions besides main
+static char *generate_many_functions(long num_functions)
+{
+	const char *function = "int f%ld(){return %ld;}\n";
+	char *source = malloc((strlen(function) + 2 * 10) * num_functions + 64);
+	if (!source)
+		return NULL;
+	char *end = source;
+	for (long i = 0; i < num_functions; i++) {
+		end += sprintf(end, function, i, i);
+	}
+	sprintf(end, "int main(){return f0();}");
+	return source;
+}
+
+void compile_many_functions(CuTest *tc)
+{
+	char *source = generate_many_functions(NUM_FUNCTIONS);
+	CuAssertPtrNotNull(tc, source);
+
+	struct mcc_parser_result parser_result = mcc_parse_string(source, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	free(source);
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(parser_result.program);
+	CuAssertPtrNotNull(tc, table);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all(parser_result.program, table);
+	CuAssertPtrNotNull(tc, checks);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, checks->status);
+
+	struct mcc_ir_packed *packed = mcc_ir_generate(parser_result.program);
+	CuAssertPtrNotNull(tc, packed);
+	struct mcc_ir_row *ir = mcc_ir_packed_to_rows(packed);
+	mcc_ir_packed_delete(packed);
+	CuAssertPtrNotNull(tc, ir);
+
+	struct mcc_asm *code = mcc_asm_generate(ir);
+	CuAssertPtrNotNull(tc, code);
+	long num_functions = 0;
+	for (struct mcc_asm_function *function = code->text_section->function; function; function = function->next) {
+		num_functions++;
+	}
+	CuAssertIntEquals(tc, NUM_FUNCTIONS + 1, num_functions);
+	mcc_asm_delete_asm(code);
+
+	mcc_ir_delete_ir(ir);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_symbol_table_delete_table(table);
+	mcc_ast_delete(parser_result.program);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(compile_long_function) \
+	TEST(compile_many_functions)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS
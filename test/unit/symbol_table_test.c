@@ -4,7 +4,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "mcc/arena.h"
 #include "mcc/ast.h"
+#include "mcc/intern.h"
 #include "mcc/parser.h"
 #include "mcc/symbol_table.h"
 
@@ -656,6 +658,94 @@ void check_upward_same_scope(CuTest *tc)
 	mcc_symbol_table_delete_table(table);
 }
 
+void check_upward_redeclaration(CuTest *tc)
+{
+	const char input[] = "int func(){int a; int b; int a; int c; a=a+1;}";
+	struct mcc_parser_result parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(parser_result.program);
+
+	struct mcc_symbol_table_row *row_a = table->head->head->child_scope->head;
+	struct mcc_symbol_table_row *row_b = row_a->next_row;
+	struct mcc_symbol_table_row *row_a2 = row_b->next_row;
+	struct mcc_symbol_table_row *row_c = row_a2->next_row;
+
+	CuAssertPtrEquals(tc, row_a, row_a2->prev_declaration);
+	CuAssertTrue(tc, row_a == mcc_symbol_table_check_upwards_for_declaration("a", row_b));
+	CuAssertTrue(tc, row_a2 == mcc_symbol_table_check_upwards_for_declaration("a", row_c));
+
+	// renamed row is found under its new name only
+	mcc_symbol_table_rename_row(row_a2, mcc_intern("$r0"));
+	CuAssertTrue(tc, row_a == mcc_symbol_table_check_upwards_for_declaration("a", row_c));
+	CuAssertTrue(tc, row_a2 == mcc_symbol_table_check_upwards_for_declaration("$r0", row_c));
+	CuAssertTrue(tc, NULL == mcc_symbol_table_check_upwards_for_declaration("$r0", row_b));
+
+	CuAssertTrue(tc, table->head->head == mcc_symbol_table_check_for_function_declaration("func", row_c));
+
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void delete_redeclared_rows(CuTest *tc)
+{
+	const char input[] = "int func(){int a; int b; int a; int a; int c;}";
+	struct mcc_parser_result parser_result = mcc_parse_string(input, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	CuAssertIntEquals(tc, parser_result.status, MCC_PARSER_STATUS_OK);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(parser_result.program);
+	CuAssertPtrNotNull(tc, table);
+
+	struct mcc_symbol_table_scope *scope = table->head->head->child_scope;
+	struct mcc_symbol_table_row *row_a = scope->head;
+	struct mcc_symbol_table_row *row_b = row_a->next_row;
+	struct mcc_symbol_table_row *row_a2 = row_b->next_row;
+	struct mcc_symbol_table_row *row_a3 = row_a2->next_row;
+	struct mcc_symbol_table_row *row_c = row_a3->next_row;
+	CuAssertPtrEquals(tc, row_a2, row_a3->prev_declaration);
+
+	// later declarations skip a deleted row
+	mcc_symbol_table_delete_row(row_a2);
+	CuAssertPtrEquals(tc, row_a, row_a3->prev_declaration);
+	CuAssertPtrEquals(tc, row_a3, row_b->next_row);
+
+	// the last declaration of a name is found through the earlier ones
+	mcc_symbol_table_delete_row(row_a3);
+	CuAssertPtrEquals(tc, row_a, mcc_symbol_table_check_upwards_for_declaration("a", row_c));
+
+	// the scope starts with the next row
+	mcc_symbol_table_delete_row(row_a);
+	CuAssertPtrEquals(tc, row_b, scope->head);
+	CuAssertPtrEquals(tc, NULL, row_b->prev_row);
+	CuAssertPtrEquals(tc, NULL, mcc_symbol_table_check_upwards_for_declaration("a", row_c));
+
+	mcc_ast_delete(parser_result.program);
+	mcc_symbol_table_delete_table(table);
+}
+
+void delete_rows_of_mixed_arenas(CuTest *tc)
+{
+	struct mcc_arena *arena = mcc_arena_new();
+	CuAssertPtrNotNull(tc, arena);
+
+	mcc_arena_set_current(arena);
+	struct mcc_symbol_table_row *in_arena =
+	    mcc_symbol_table_new_row_variable("a", MCC_SYMBOL_TABLE_ROW_TYPE_INT, NULL);
+	mcc_arena_set_current(NULL);
+	struct mcc_symbol_table_row *on_heap =
+	    mcc_symbol_table_new_row_variable("b", MCC_SYMBOL_TABLE_ROW_TYPE_INT, NULL);
+	CuAssertPtrNotNull(tc, in_arena);
+	CuAssertPtrNotNull(tc, on_heap);
+	CuAssertPtrEquals(tc, arena, in_arena->arena);
+	CuAssertPtrEquals(tc, NULL, on_heap->arena);
+
+	// Rows are freed by where they were allocated, not by the arena that is current when deleting them
+	mcc_symbol_table_delete_row(in_arena);
+	mcc_arena_set_current(arena);
+	mcc_symbol_table_delete_row(on_heap);
+	mcc_arena_set_current(NULL);
+
+	mcc_arena_delete(arena);
+}
+
 void variable_expression_linking(CuTest *tc)
 {
 
@@ -904,6 +994,9 @@ void built_ins(CuTest *tc)
 	TEST(assignment_linking) \
 	TEST(check_upward) \
 	TEST(check_upward_same_scope) \
+	TEST(check_upward_redeclaration) \
+	TEST(delete_rows_of_mixed_arenas) \
+	TEST(delete_redeclared_rows) \
 	TEST(variable_expression_linking) \
 	TEST(if_condition_expression) \
 	TEST(built_ins)
@@ -0,0 +1,164 @@
+#include <CuTest.h>
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mcc/ast.h"
+#include "mcc/ir.h"
+#include "mcc/ir_packed.h"
+#include "mcc/ir_print.h"
+#include "mcc/semantic_checks.h"
+#include "mcc/symbol_table.h"
+#include "mcc/thread_pool.h"
+
+#define NUM_TASKS 1000
+#define NUM_FUNCTIONS 50
+
+static void count_index(int index, void *userdata)
+{
+	atomic_int *calls = userdata;
+	atomic_fetch_add(&calls[index], 1);
+}
+
+void every_index_once(CuTest *tc)
+{
+	mcc_thread_pool_set_threads(4);
+	CuAssertIntEquals(tc, 4, mcc_thread_pool_threads());
+
+	atomic_int calls[NUM_TASKS];
+	for (int i = 0; i < NUM_TASKS; i++) {
+		atomic_init(&calls[i], 0);
+	}
+	mcc_thread_pool_for(NUM_TASKS, count_index, calls);
+	for (int i = 0; i < NUM_TASKS; i++) {
+		CuAssertIntEquals(tc, 1, atomic_load(&calls[i]));
+	}
+
+	mcc_thread_pool_set_threads(0);
+}
+
+static void add_index(int index, void *userdata)
+{
+	atomic_int *sum = userdata;
+	atomic_fetch_add(sum, index);
+}
+
+static void run_nested(void *userdata)
+{
+	mcc_thread_pool_for(NUM_TASKS, add_index, userdata);
+}
+
+void nested_tasks(CuTest *tc)
+{
+	mcc_thread_pool_set_threads(4);
+
+	atomic_int sums[8];
+	struct mcc_task_group *group = mcc_task_group_new();
+	CuAssertPtrNotNull(tc, group);
+	for (int i = 0; i < 8; i++) {
+		atomic_init(&sums[i], 0);
+		mcc_task_group_submit(group, run_nested, &sums[i]);
+	}
+	mcc_task_group_wait(group);
+
+	for (int i = 0; i < 8; i++) {
+		CuAssertIntEquals(tc, NUM_TASKS * (NUM_TASKS - 1) / 2, atomic_load(&sums[i]));
+	}
+
+	mcc_thread_pool_shutdown();
+	mcc_thread_pool_set_threads(0);
+}
+
+static void count_call(void *userdata)
+{
+	int *calls = userdata;
+	(*calls)++;
+}
+
+void single_thread_order(CuTest *tc)
+{
+	mcc_thread_pool_set_threads(1);
+	CuAssertIntEquals(tc, 1, mcc_thread_pool_threads());
+
+	// Tasks run right when they are submitted
+	int calls = 0;
+	struct mcc_task_group *group = mcc_task_group_new();
+	CuAssertPtrNotNull(tc, group);
+	for (int i = 0; i < NUM_TASKS; i++) {
+		mcc_task_group_submit(group, count_call, &calls);
+		CuAssertIntEquals(tc, i + 1, calls);
+	}
+	mcc_task_group_wait(group);
+
+	mcc_thread_pool_set_threads(0);
+}
+
+// IR of a program with many functions, printed into a string
+static char *generate_ir(CuTest *tc)
+{
+	char *source = malloc(NUM_FUNCTIONS * 200);
+	CuAssertPtrNotNull(tc, source);
+	char *end = source;
+	for (int i = 0; i < NUM_FUNCTIONS; i++) {
+		end += sprintf(end,
+		               "int f%d(int n){int i; i = 0; while (i < n) { if (i == %d) {i = i + 2;} else "
+		               "{i = i + 1;} } return i * %d;}\n",
+		               i, i, i);
+	}
+	sprintf(end, "int main(){return f0(3);}");
+
+	struct mcc_parser_result parser_result = mcc_parse_string(source, MCC_PARSER_ENTRY_POINT_PROGRAM, "test");
+	free(source);
+	CuAssertIntEquals(tc, MCC_PARSER_STATUS_OK, parser_result.status);
+	struct mcc_symbol_table *table = mcc_symbol_table_create(parser_result.program);
+	CuAssertPtrNotNull(tc, table);
+	struct mcc_semantic_check *checks = mcc_semantic_check_run_all(parser_result.program, table);
+	CuAssertPtrNotNull(tc, checks);
+	CuAssertIntEquals(tc, MCC_SEMANTIC_CHECK_OK, checks->status);
+	struct mcc_ir_packed *ir = mcc_ir_generate(parser_result.program);
+	CuAssertPtrNotNull(tc, ir);
+
+	FILE *out = tmpfile();
+	CuAssertPtrNotNull(tc, out);
+	mcc_ir_print_packed(out, ir, false, false);
+	long size = ftell(out);
+	rewind(out);
+	char *printed = calloc(size + 1, 1);
+	CuAssertPtrNotNull(tc, printed);
+	CuAssertIntEquals(tc, size, fread(printed, 1, size, out));
+	fclose(out);
+
+	mcc_ir_packed_delete(ir);
+	mcc_semantic_check_delete_single_check(checks);
+	mcc_symbol_table_delete_table(table);
+	mcc_ast_delete(parser_result.program);
+	return printed;
+}
+
+void same_ir_on_any_number_of_threads(CuTest *tc)
+{
+	mcc_thread_pool_set_threads(1);
+	char *sequential = generate_ir(tc);
+	mcc_thread_pool_set_threads(8);
+	char *parallel = generate_ir(tc);
+	mcc_thread_pool_set_threads(0);
+
+	CuAssertStrEquals(tc, sequential, parallel);
+	free(sequential);
+	free(parallel);
+}
+
+// clang-format off
+
+#define TESTS \
+	TEST(every_index_once) \
+	TEST(nested_tasks) \
+	TEST(single_thread_order) \
+	TEST(same_ir_on_any_number_of_threads)
+
+// clang-format on
+
+#include "main_stub.inc"
+#undef TESTS